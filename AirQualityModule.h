@@ -2,126 +2,115 @@
 #define AIR_QUALITY_MODULE_H
 
 #include "Module.h"
-#include <HardwareSerial.h>
+#include "HtmlTemplate.h"
+#include "PmsSensor.h"
+#include "Sparkline.h"
+#include <vector>
 
 #define PMS_RX 16
 #define PMS_TX 17
 #define PMS_SET 4
 
-#define PMS_FRAME_LEN 32
-#define PMS_BAUD 9600
-#define PMS_WARMUP_MS 30000
-#define PMS_READ_INTERVAL 2500
 #define PMS_DISPLAY_CYCLE 3000
 #define PMS_AUTO_SLEEP_MS 120000
 
+// Shows the first PMSA003 on the display; every sensor added is listed on
+// the web page and in /api/data under "sensors" by label. Showing the
+// module wakes all of them, and leaving it puts them back to sleep.
 class AirQualityModule : public Module {
 private:
-    HardwareSerial pmsSerial = HardwareSerial(2);
-    bool sensorReady = false;
-    bool warmedUp = false;
+    std::vector<PmsSensor*> sensors;
     unsigned long activatedAt = 0;
-    unsigned long lastRead = 0;
     unsigned long lastCycle = 0;
 
-    uint16_t pm1_0 = 0;
-    uint16_t pm2_5 = 0;
-    uint16_t pm10 = 0;
-
-    uint16_t last_pm1_0 = 0;
-    uint16_t last_pm2_5 = 0;
-    uint16_t last_pm10 = 0;
-    bool hasLastValues = false;
-
-    enum DisplayMode { AQI_PM25, AQI_PM10, AQI_PM1, AQI_WARMUP };
+    enum DisplayMode { AQI_PM25, AQI_PM10, AQI_PM1, AQI_GRAPH, AQI_WARMUP };
+    static const uint8_t MODE_COUNT = 5;
     DisplayMode currentMode = AQI_PM25;
-    int modeCount = 3;
+
+    bool showGraph = false;          // add the PM2.5 graph to the display cycle
+    Sparkline<SENSOR_HISTORY_SIZE> graph{1};   // 1 ug/m3 per row at the finest
 
     char displayBuffer[32];
     char warmupBuffer[16];
-    uint8_t frameBuffer[PMS_FRAME_LEN];
 
 public:
     AirQualityModule() {}
 
+    ~AirQualityModule() {
+        for (PmsSensor* sensor : sensors) {
+            delete sensor;
+        }
+    }
+
+    // Before addModule(); the caller also adds it to a SensorBus
+    void addSensor(PmsSensor* sensor) {
+        sensors.push_back(sensor);
+    }
+
     void init() override {
-        pinMode(PMS_SET, OUTPUT);
-        digitalWrite(PMS_SET, LOW);
-        pmsSerial.begin(PMS_BAUD, SERIAL_8N1, PMS_RX, PMS_TX);
-        Serial.println("PMSA003 initialized (sleeping)");
+        for (PmsSensor* sensor : sensors) {
+            sensor->begin();
+        }
     }
 
     void activate() override {
         active = true;
-        warmedUp = false;
         currentMode = AQI_PM25;
         activatedAt = millis();
-        lastRead = 0;
         lastCycle = millis();
 
-        wakeUpSensor();
         P->displayClear();
         P->displayText("AQI..", PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
         P->displayAnimate();
-        Serial.println("PMSA003 waking up, 30s warmup...");
+
+        for (PmsSensor* sensor : sensors) {
+            sensor->hold(true);
+        }
     }
 
     void deactivate() override {
         active = false;
-        warmedUp = false;
-
-        last_pm1_0 = pm1_0;
-        last_pm2_5 = pm2_5;
-        last_pm10 = pm10;
-        if (pm1_0 || pm2_5 || pm10) hasLastValues = true;
-
-        sleepSensor();
-        Serial.println("PMSA003 sleeping");
+        for (PmsSensor* sensor : sensors) {
+            sensor->hold(false);
+        }
     }
 
     void update() override {
-        if (!active) return;
-
-        if (!warmedUp) {
-            unsigned long elapsed = millis() - activatedAt;
-            if (elapsed < PMS_WARMUP_MS) {
-                if (hasLastValues) {
-                    pm1_0 = last_pm1_0;
-                    pm2_5 = last_pm2_5;
-                    pm10 = last_pm10;
-                    modeCount = 4;
-                } else {
-                    int secs = (PMS_WARMUP_MS - elapsed) / 1000;
-                    sprintf(warmupBuffer, "W %ds", secs);
-                    P->displayText(warmupBuffer, PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
-                    P->displayAnimate();
-                    drainSerial();
-                    return;
-                }
-            } else {
-                warmedUp = true;
-                modeCount = 3;
-                if (currentMode == AQI_WARMUP) currentMode = AQI_PM25;
-                drainSerial();
-                Serial.println("PMSA003 ready, showing fresh values");
+        // Frames are read by the sensor bus; publish each stored sample once
+        for (PmsSensor* sensor : sensors) {
+            if (sensor->takeSample()) {
+                publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, sensor->getLabel(),
+                        sensor->getPM1_0(), sensor->getPM2_5(), sensor->getPM10());
             }
         }
 
-        if (warmedUp && millis() - activatedAt > PMS_AUTO_SLEEP_MS) {
-            Serial.println("PMSA003 auto-sleep after 2min");
-            deactivate();
+        PmsSensor* sensor = primary();
+        // Kept current while hidden so showing it costs one draw
+        bool graphChanged = sensor && graph.update(sensor->getHistory());
+        if (!active || !sensor) return;
+
+        // Until the first reading there is only the countdown; after it,
+        // the countdown joins the cycle with the last stored values
+        if (isModeShown(AQI_WARMUP) && !sensor->hasReading()) {
+            sprintf(warmupBuffer, "W %lus", sensor->getWarmupLeft() / 1000);
+            P->displayText(warmupBuffer, PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
+            P->displayAnimate();
             return;
         }
+        if (!isModeShown(currentMode)) currentMode = AQI_PM25;
 
-        if (millis() - lastRead > PMS_READ_INTERVAL) {
-            readSensor();
-            lastRead = millis();
+        if (sensor->isWarmedUp() && millis() - activatedAt > PMS_AUTO_SLEEP_MS) {
+            Serial.println("PMSA003 auto-sleep after 2min");
+            deactivate();
+            return;
         }
 
         if (millis() - lastCycle > PMS_DISPLAY_CYCLE) {
-            currentMode = static_cast<DisplayMode>((currentMode + 1) % modeCount);
-            lastCycle = millis();
+            nextMode();
+        } else if (currentMode == AQI_GRAPH && graphChanged) {
+            graph.draw(P);
         }
+        if (currentMode == AQI_GRAPH) return;
 
         formatDisplay();
         P->displayText(displayBuffer, PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
@@ -132,31 +121,69 @@ public:
         return "AirQuality";
     }
 
-    const char* getWebControls() override {
-        static String html;
-        html = "<div style=\"border-left: 5px solid #8BC34A;\">";
-        html += "<h3>🌬️ Air Quality (PMSA003)</h3>";
-
-        if (!active) {
-            html += "<p>Sensor is sleeping to extend lifespan.</p>";
-        } else if (!warmedUp) {
-            html += "<p>Warming up... please wait 30s.</p>";
-        } else {
-            String aqiLabel = getAQILabel(pm2_5);
-            String aqiColor = getAQIColor(pm2_5);
-            html += "<p style=\"color:" + aqiColor + "; font-size:1.2em;\"><strong>" + aqiLabel + "</strong></p>";
-            html += "<p>PM1.0: <strong>" + String(pm1_0) + " µg/m³</strong></p>";
-            html += "<p>PM2.5: <strong>" + String(pm2_5) + " µg/m³</strong></p>";
-            html += "<p>PM10: <strong>" + String(pm10) + " µg/m³</strong></p>";
-        }
+    // Sampling and frame reads are budgeted by the sensor bus
+    unsigned long getIdleBudget() override {
+        PmsSensor* sensor = primary();
+        if (!active || !sensor) return MODULE_IDLE_FOREVER;
+        // Warm-up shows a seconds countdown
+        if (!sensor->isWarmedUp()) return 1000;
+        return min(dueIn(lastCycle, PMS_DISPLAY_CYCLE + 1), dueIn(activatedAt, PMS_AUTO_SLEEP_MS + 1));
+    }
+
+    void writeWebControls(Print& out) override {
+        HTML_TEMPLATE(tpl, R"rawliteral(<div style="border-left: 5px solid #8BC34A;">
+<h3>🌬️ Air Quality (PMSA003)</h3>
+{{0}}
+<label><input type="checkbox" onchange="sendRequest('/aqi/graph?on=' + (this.checked ? 1 : 0))"{{1}}> PM2.5 graph on display</label>
+<button onclick="sendRequest('/aqi/activate')">Wake &amp; Show</button>
+<button class="stop" onclick="sendRequest('/aqi/sleep')">Sleep Sensor</button>
+</div>)rawliteral");
+
+        HTML_TEMPLATE(readings, R"rawliteral(<p style="color:{{0}}; font-size:1.2em;"><strong>{{1}}</strong></p>
+<p>PM1.0: <strong>{{2}} µg/m³</strong></p>
+<p>PM2.5: <strong>{{3}} µg/m³</strong></p>
+<p>PM10: <strong>{{4}} µg/m³</strong></p>)rawliteral");
+
+        tpl.render(out, [this](Print& o, uint8_t slot) {
+            if (slot == 1) {
+                if (showGraph) o.print(" checked");
+                return;
+            }
+            if (sensors.empty()) {
+                o.print("<p>No sensor configured.</p>");
+                return;
+            }
+            for (PmsSensor* sensor : sensors) {
+                if (sensors.size() > 1) {
+                    o.print("<h4>");
+                    o.print(sensor->getLabel());
+                    o.print("</h4>");
+                }
+                if (!sensor->isOn() && !sensor->hasReading()) {
+                    o.print("<p>Sensor is sleeping to extend lifespan.</p>");
+                } else if (sensor->isOn() && !sensor->isWarmedUp() && !sensor->hasReading()) {
+                    o.print("<p>Warming up... please wait.</p>");
+                } else {
+                    readings.render(o, [sensor](Print& r, uint8_t slot) {
+                        switch (slot) {
+                            case 0: r.print(getAQIColor(sensor->getPM2_5())); break;
+                            case 1: r.print(getAQILabel(sensor->getPM2_5())); break;
+                            case 2: r.print(sensor->getPM1_0()); break;
+                            case 3: r.print(sensor->getPM2_5()); break;
+                            case 4: r.print(sensor->getPM10()); break;
+                        }
+                    });
+                }
+            }
+        });
+    }
 
-        html += "<button onclick=\"sendRequest('/aqi/activate')\">Wake &amp; Show</button>";
-        html += "<button class=\"stop\" onclick=\"sendRequest('/aqi/sleep')\">Sleep Sensor</button>";
-        html += "</div>";
-        return html.c_str();
+    bool acceptsWebRequest(StrView request) override {
+        return request.indexOf("/aqi/activate") >= 0 || request.indexOf("/aqi/sleep") >= 0 ||
+               request.indexOf("/aqi/graph") >= 0;
     }
 
-    bool handleWebRequest(String request) override {
+    bool handleWebRequest(StrView request, RequestArena&) override {
         if (request.indexOf("/aqi/activate") >= 0) {
             activate();
             return true;
@@ -167,123 +194,106 @@ public:
             return true;
         }
 
+        if (request.indexOf("/aqi/graph") >= 0) {
+            showGraph = (request.indexOf("on=1") >= 0);
+            return true;
+        }
+
         return false;
     }
     
-    String getJsonData() override {
-        int secs = 0;
-        if (active && !warmedUp) {
-            secs = (PMS_WARMUP_MS - (millis() - activatedAt)) / 1000;
-            if (secs < 0) secs = 0;
+    // Top-level fields are the primary sensor, as before; "sensors" has
+    // every instance by label
+    void writeFields(FieldWriter& out) override {
+        PmsSensor* sensor = primary();
+        if (sensor) {
+            sensor->writeReadings(out);
         }
-        String json = "{\"pm1\":" + String(pm1_0) + ",\"pm25\":" + String(pm2_5) +
-                      ",\"pm10\":" + String(pm10) + ",\"on\":" + String(active ? 1 : 0) +
-                      ",\"warm\":" + String(warmedUp ? 1 : 0) + ",\"sec\":" + String(secs) + "}";
-        return json;
-    }
+        out.writeInt("on", active ? 1 : 0);
 
-private:
-    void wakeUpSensor() {
-        digitalWrite(PMS_SET, HIGH);
-        sensorReady = true;
-        Serial.printf("[PMS] SET pin %d -> HIGH (read back: %d)\n", PMS_SET, digitalRead(PMS_SET));
+        out.beginObject("sensors");
+        for (PmsSensor* s : sensors) {
+            out.beginObject(s->getLabel());
+            s->writeFields(out);
+            out.endObject();
+        }
+        out.endObject();
     }
 
-    void sleepSensor() {
-        digitalWrite(PMS_SET, LOW);
-        sensorReady = false;
+    uint32_t getEventMask() override {
+        return EVENT_MASK(EVENT_TIMER_STARTED) | EVENT_MASK(EVENT_TIMER_EXPIRED) |
+               EVENT_MASK(EVENT_TIMER_STOPPED);
     }
 
-    void drainSerial() {
-        while (pmsSerial.available()) {
-            pmsSerial.read();
+    // Pause background sampling while a Pomodoro work session runs
+    void onEvent(const Event& event) override {
+        if (event.source != SOURCE_POMODORO) return;
+        bool work = strcmp(event.name, "work") == 0;
+        bool paused = (event.topic == EVENT_TIMER_STARTED) && work;
+        for (PmsSensor* sensor : sensors) {
+            sensor->setPaused(paused);
         }
     }
 
-    bool readSensor() {
-        int avail = pmsSerial.available();
-        if (avail == 0) {
-            Serial.println("[PMS] No serial data available");
-            return false;
-        }
-        Serial.printf("[PMS] %d bytes in buffer\n", avail);
-
-        while (pmsSerial.available() > 0) {
-            uint8_t b = pmsSerial.read();
-            if (b != 0x42) continue;
-
-            unsigned long timeout = millis() + 500;
-            while (!pmsSerial.available() && millis() < timeout) {
-                delay(1);
-            }
-            if (!pmsSerial.available()) {
-                Serial.println("[PMS] Timeout waiting for 2nd byte");
-                return false;
-            }
-
-            b = pmsSerial.peek();
-            if (b != 0x4D) continue;
-            pmsSerial.read();
-
-            frameBuffer[0] = 0x42;
-            frameBuffer[1] = 0x4D;
-
-            pmsSerial.setTimeout(1000);
-            int bytesRead = pmsSerial.readBytes(&frameBuffer[2], PMS_FRAME_LEN - 2);
-            if (bytesRead != PMS_FRAME_LEN - 2) {
-                Serial.printf("[PMS] Incomplete frame: got %d of %d bytes\n", bytesRead, PMS_FRAME_LEN - 2);
-                continue;
-            }
-
-            uint16_t frameLen = (frameBuffer[2] << 8) | frameBuffer[3];
-            Serial.printf("[PMS] Frame length field: %d\n", frameLen);
-
-            if (!validateChecksum()) {
-                Serial.println("[PMS] Checksum failed");
-                continue;
-            }
+    // Latest converged readings of the primary sensor
+    bool hasReading() const { return primary() && primary()->hasReading(); }
+    bool isSensorOn() const { return primary() && primary()->isOn(); }
+    uint16_t getPM1_0() const { return primary() ? primary()->getPM1_0() : 0; }
+    uint16_t getPM2_5() const { return primary() ? primary()->getPM2_5() : 0; }
+    uint16_t getPM10() const { return primary() ? primary()->getPM10() : 0; }
+    unsigned long getSampleAge() const { return primary() ? primary()->getSampleAge() : 0; }
+    const std::vector<PmsSensor*>& getSensors() const { return sensors; }
 
-            pm1_0 = (frameBuffer[10] << 8) | frameBuffer[11];
-            pm2_5 = (frameBuffer[12] << 8) | frameBuffer[13];
-            pm10  = (frameBuffer[14] << 8) | frameBuffer[15];
+private:
+    PmsSensor* primary() const {
+        return sensors.empty() ? nullptr : sensors[0];
+    }
 
-            Serial.printf("[PMS] OK -> PM1.0=%d PM2.5=%d PM10=%d\n", pm1_0, pm2_5, pm10);
-            return true;
+    bool isModeShown(DisplayMode mode) const {
+        switch (mode) {
+            case AQI_GRAPH:
+                return showGraph && graph.getCount() > 1;
+            case AQI_WARMUP:
+                return !primary()->isWarmedUp() && primary()->getWarmupLeft() > 0;
+            default:
+                return true;
         }
-        return false;
     }
 
-    bool validateChecksum() {
-        uint16_t sum = 0;
-        for (int i = 0; i < PMS_FRAME_LEN - 2; i++) {
-            sum += frameBuffer[i];
+    void nextMode() {
+        do {
+            currentMode = static_cast<DisplayMode>((currentMode + 1) % MODE_COUNT);
+        } while (!isModeShown(currentMode));
+        lastCycle = millis();
+
+        // The graph is drawn as raw columns, outside MD_Parola
+        if (currentMode == AQI_GRAPH) {
+            P->release();
+            graph.draw(P);
         }
-        uint16_t check = (frameBuffer[PMS_FRAME_LEN - 2] << 8) | frameBuffer[PMS_FRAME_LEN - 1];
-        Serial.printf("[PMS] Checksum calc=%d frame=%d\n", sum, check);
-        return sum == check;
     }
 
     void formatDisplay() {
+        PmsSensor* sensor = primary();
         switch (currentMode) {
             case AQI_PM25:
-                sprintf(displayBuffer, "2.5:%d", pm2_5);
+                sprintf(displayBuffer, "2.5:%d", sensor->getPM2_5());
                 break;
             case AQI_PM10:
-                sprintf(displayBuffer, "10:%d", pm10);
+                sprintf(displayBuffer, "10:%d", sensor->getPM10());
                 break;
             case AQI_PM1:
-                sprintf(displayBuffer, "1:%d", pm1_0);
+                sprintf(displayBuffer, "1:%d", sensor->getPM1_0());
                 break;
-            case AQI_WARMUP: {
-                int secs = (PMS_WARMUP_MS - (millis() - activatedAt)) / 1000;
-                if (secs < 0) secs = 0;
-                sprintf(displayBuffer, "W%ds", secs);
+            case AQI_WARMUP:
+                sprintf(displayBuffer, "W%lus", sensor->getWarmupLeft() / 1000);
                 break;
-            }
+            case AQI_GRAPH:
+                break;           // drawn from nextMode()
         }
     }
 
-    String getAQILabel(uint16_t pm25) {
+    static const char* getAQILabel(uint16_t pm25) {
         if (pm25 <= 12) return "Good";
         if (pm25 <= 35) return "Moderate";
         if (pm25 <= 55) return "Unhealthy (Sensitive)";
@@ -292,7 +302,7 @@ private:
         return "Hazardous";
     }
 
-    String getAQIColor(uint16_t pm25) {
+    static const char* getAQIColor(uint16_t pm25) {
         if (pm25 <= 12) return "#4CAF50";
         if (pm25 <= 35) return "#FFEB3B";
         if (pm25 <= 55) return "#FF9800";
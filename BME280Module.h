@@ -2,62 +2,58 @@
 #define BME280_MODULE_H
 
 #include "Module.h"
-#include <Wire.h>
-#include <Adafruit_Sensor.h>
-#include <Adafruit_BME280.h>
+#include "HtmlTemplate.h"
+#include "BME280Sensor.h"
+#include "Sparkline.h"
+#include <vector>
 
 #define BME_SDA 21
 #define BME_SCL 22
+#define BME_FORECAST_SPEED 40        // ms per column while scrolling
 
+// Shows the first BME280 on the display; every sensor added is listed on
+// the web page and in /api/data under "sensors" by label.
 class BME280Module : public Module {
 private:
-    Adafruit_BME280 bme;
-    bool sensorReady = false;
+    std::vector<BME280Sensor*> sensors;
+    bool showForecast = false;       // add the forecast to the display cycle
+    bool showGraph = false;          // add the temperature graph to the cycle
+    Sparkline<SENSOR_HISTORY_SIZE> graph{2};   // 0.2 °C per row at the finest
 
-    float temperature = 0;
-    float humidity = 0;
-    float pressure = 0;
-
-    unsigned long lastRead = 0;
     unsigned long lastCycle = 0;
-    const unsigned long READ_INTERVAL = 2000;
     const unsigned long CYCLE_INTERVAL = 4000;
 
-    enum DisplayMode { TEMP, HUMIDITY, PRESSURE };
+    enum DisplayMode { TEMP, HUMIDITY, PRESSURE, GRAPH, FORECAST };
+    static const uint8_t MODE_COUNT = 5;
     DisplayMode currentMode = TEMP;
 
     char displayBuffer[32];
+    char forecastBuffer[64];
     bool useCelsius = true;
 
 public:
     BME280Module() {}
 
-    void init() override {
-        Wire.begin(BME_SDA, BME_SCL);
-        delay(100);
+    ~BME280Module() {
+        for (BME280Sensor* sensor : sensors) {
+            delete sensor;
+        }
+    }
 
-        sensorReady = bme.begin(0x77, &Wire);
+    // Before addModule(); the caller also adds it to its I2C SensorBus
+    void addSensor(BME280Sensor* sensor) {
+        sensors.push_back(sensor);
+    }
 
-        if (sensorReady) {
-            bme.setSampling(
-                Adafruit_BME280::MODE_NORMAL,
-                Adafruit_BME280::SAMPLING_X2,
-                Adafruit_BME280::SAMPLING_X16,
-                Adafruit_BME280::SAMPLING_X1,
-                Adafruit_BME280::FILTER_X16,
-                Adafruit_BME280::STANDBY_MS_500
-            );
-            Serial.println("BME280 initialized at 0x77");
-        } else {
-            Serial.println("BME280 not found. Check wiring:");
-            Serial.println("  SDA -> GPIO 21, SCL -> GPIO 22, VCC -> 3.3V");
+    void init() override {
+        for (BME280Sensor* sensor : sensors) {
+            sensor->begin();
         }
     }
 
     void activate() override {
         active = true;
         currentMode = TEMP;
-        lastRead = 0;
         lastCycle = millis();
         P->displayClear();
     }
@@ -67,16 +63,34 @@ public:
     }
 
     void update() override {
-        if (!active || !sensorReady) return;
+        // Readings come from the sensor bus; publish each one once
+        for (BME280Sensor* sensor : sensors) {
+            if (sensor->takeSample()) {
+                publish(EVENT_SENSOR_SAMPLE, SOURCE_BME280, sensor->getLabel(),
+                        sensor->getTemperature(), sensor->getHumidity(), sensor->getPressure());
+            }
+        }
+
+        // Kept current while hidden so showing it costs one draw
+        bool graphChanged = primary() && graph.update(primary()->getHistory());
+
+        if (!active || !isSensorReady()) return;
+
+        if (currentMode == GRAPH) {
+            if (graphChanged) graph.draw(P);
+            if (millis() - lastCycle > CYCLE_INTERVAL) nextMode();
+            if (currentMode == GRAPH) return;
+        }
 
-        if (millis() - lastRead > READ_INTERVAL) {
-            readSensor();
-            lastRead = millis();
+        // The forecast scrolls through once, then the cycle moves on
+        if (currentMode == FORECAST) {
+            if (P->displayAnimate()) nextMode();
+            return;
         }
 
         if (millis() - lastCycle > CYCLE_INTERVAL) {
-            currentMode = static_cast<DisplayMode>((currentMode + 1) % 3);
-            lastCycle = millis();
+            nextMode();
+            if (currentMode == FORECAST || currentMode == GRAPH) return;
         }
 
         formatDisplay();
@@ -88,39 +102,72 @@ public:
         return "Weather";
     }
 
-    const char* getWebControls() override {
-        static String html;
-        html = "<div style=\"border-left: 5px solid #00BCD4;\">";
-        html += "<h3>🌡️ Weather Station</h3>";
+    unsigned long getIdleBudget() override {
+        // Sensor reads are budgeted by the bus
+        if (!active || !isSensorReady()) return MODULE_IDLE_FOREVER;
+        if (currentMode == FORECAST) return 0;
+        return dueIn(lastCycle, CYCLE_INTERVAL + 1);
+    }
 
-        if (!sensorReady) {
-            html += "<p style=\"color:#f44336;\">Sensor not detected. Check wiring.</p>";
-        } else {
-            html += "<p>Temp: <strong>" + String(temperature, 1);
-            html += useCelsius ? " °C" : " °F";
-            html += "</strong></p>";
-            html += "<p>Humidity: <strong>" + String(humidity, 1) + " %</strong></p>";
-            html += "<p>Pressure: <strong>" + String(pressure, 1) + " hPa</strong></p>";
-        }
+    void writeWebControls(Print& out) override {
+        HTML_TEMPLATE(tpl, R"rawliteral(<div style="border-left: 5px solid #00BCD4;">
+<h3>🌡️ Weather Station</h3>
+{{0}}
+<label><input type="radio" name="unit" value="C"{{1}}> °C</label> <label><input type="radio" name="unit" value="F"{{2}}> °F</label>
+<button class="alt" onclick="sendRequest('/weather/unit?u=' + document.querySelector('input[name=unit]:checked').value)">Set Unit</button>
+<label><input type="checkbox" onchange="sendRequest('/weather/forecast?on=' + (this.checked ? 1 : 0))"{{3}}> Forecast on display</label>
+<label><input type="checkbox" onchange="sendRequest('/weather/graph?on=' + (this.checked ? 1 : 0))"{{4}}> Temperature graph on display</label>
+<button onclick="sendRequest('/weather/activate')">Show Weather</button>
+</div>)rawliteral");
+
+        tpl.render(out, [this](Print& o, uint8_t slot) {
+            switch (slot) {
+                case 0:
+                    if (sensors.empty()) {
+                        o.print("<p style=\"color:#f44336;\">No sensor configured.</p>");
+                        break;
+                    }
+                    for (BME280Sensor* sensor : sensors) {
+                        writeSensorControls(o, sensor);
+                    }
+                    break;
+                case 1:
+                    if (useCelsius) o.print(" checked");
+                    break;
+                case 2:
+                    if (!useCelsius) o.print(" checked");
+                    break;
+                case 3:
+                    if (showForecast) o.print(" checked");
+                    break;
+                case 4:
+                    if (showGraph) o.print(" checked");
+                    break;
+            }
+        });
+    }
 
-        html += "<label><input type=\"radio\" name=\"unit\" value=\"C\"";
-        if (useCelsius) html += " checked";
-        html += "> °C</label> ";
-        html += "<label><input type=\"radio\" name=\"unit\" value=\"F\"";
-        if (!useCelsius) html += " checked";
-        html += "> °F</label>";
-        html += "<button class=\"alt\" onclick=\"sendRequest('/weather/unit?u=' + document.querySelector('input[name=\\\"unit\\\"]:checked').value)\">Set Unit</button>";
-        html += "<button onclick=\"sendRequest('/weather/activate')\">Show Weather</button>";
-        html += "</div>";
-        return html.c_str();
+    bool acceptsWebRequest(StrView request) override {
+        return request.indexOf("/weather/unit") >= 0 || request.indexOf("/weather/forecast") >= 0 ||
+               request.indexOf("/weather/graph") >= 0 || request.indexOf("/weather/activate") >= 0;
     }
 
-    bool handleWebRequest(String request) override {
+    bool handleWebRequest(StrView request, RequestArena&) override {
         if (request.indexOf("/weather/unit") >= 0) {
             useCelsius = (request.indexOf("u=C") >= 0);
             return true;
         }
 
+        if (request.indexOf("/weather/forecast") >= 0) {
+            showForecast = (request.indexOf("on=1") >= 0);
+            return true;
+        }
+
+        if (request.indexOf("/weather/graph") >= 0) {
+            showGraph = (request.indexOf("on=1") >= 0);
+            return true;
+        }
+
         if (request.indexOf("/weather/activate") >= 0) {
             activate();
             return true;
@@ -129,34 +176,134 @@ public:
         return false;
     }
     
-    String getJsonData() override {
-        float t = useCelsius ? temperature : (temperature * 9.0 / 5.0 + 32.0);
-        String json = "{\"t\":" + String(t, 1) + ",\"h\":" + String(humidity, 1) +
-                      ",\"p\":" + String(pressure, 1) + ",\"u\":\"" + String(useCelsius ? "C" : "F") +
-                      "\",\"ok\":" + String(sensorReady ? 1 : 0) + "}";
-        return json;
+    // Top-level fields are the primary sensor, as before; "sensors" has
+    // every instance by label, metric
+    void writeFields(FieldWriter& out) override {
+        BME280Sensor* sensor = primary();
+        const PressureTrend* trend = sensor ? &sensor->getTrend() : nullptr;
+        uint8_t forecast = sensor ? sensor->getForecast() : 0;
+        out.writeFloat("t", toUnit(getTemperature()), 1);
+        out.writeFloat("h", getHumidity(), 1);
+        out.writeFloat("p", getPressure(), 1);
+        out.writeString("u", useCelsius ? "C" : "F");
+        out.writeInt("ok", isSensorReady() ? 1 : 0);
+        // Trend in hPa per 3 h and Zambretti forecast; z is 0 while the
+        // window holds under PRESSURE_MIN_SAMPLES
+        out.writeFloat("dp", forecast ? trend->getTrend() : 0, 2);
+        out.writeInt("z", forecast);
+        out.writeString("fc", PressureTrend::forecastText(forecast));
+        out.writeInt("win", trend ? trend->getCount() * PRESSURE_SAMPLE_MS / 60000 : 0);
+
+        out.beginObject("sensors");
+        for (BME280Sensor* s : sensors) {
+            out.beginObject(s->getLabel());
+            s->writeFields(out);
+            out.endObject();
+        }
+        out.endObject();
     }
 
+    // Raw readings of the primary sensor, always metric
+    bool isSensorReady() const { return primary() && primary()->isReady(); }
+    float getTemperature() const { return primary() ? primary()->getTemperature() : 0; }
+    float getHumidity() const { return primary() ? primary()->getHumidity() : 0; }
+    float getPressure() const { return primary() ? primary()->getPressure() : 0; }
+    const std::vector<BME280Sensor*>& getSensors() const { return sensors; }
+
 private:
-    void readSensor() {
-        temperature = bme.readTemperature();
-        humidity = bme.readHumidity();
-        pressure = bme.readPressure() / 100.0F;
+    BME280Sensor* primary() const {
+        return sensors.empty() ? nullptr : sensors[0];
+    }
+
+    float toUnit(float celsius) const {
+        return useCelsius ? celsius : (celsius * 9.0 / 5.0 + 32.0);
+    }
+
+    void writeSensorControls(Print& o, BME280Sensor* sensor) {
+        if (sensors.size() > 1) {
+            o.print("<h4>");
+            o.print(sensor->getLabel());
+            o.print("</h4>");
+        }
+        if (!sensor->isReady()) {
+            o.print("<p style=\"color:#f44336;\">Sensor not detected. Check wiring.</p>");
+            return;
+        }
+        o.print("<p>Temp: <strong>");
+        o.print(toUnit(sensor->getTemperature()), 1);
+        o.print(useCelsius ? " °C" : " °F");
+        o.print("</strong></p><p>Humidity: <strong>");
+        o.print(sensor->getHumidity(), 1);
+        o.print(" %</strong></p><p>Pressure: <strong>");
+        o.print(sensor->getPressure(), 1);
+        o.print(" hPa</strong></p>");
+
+        const PressureTrend& trend = sensor->getTrend();
+        uint8_t forecast = sensor->getForecast();
+        if (!forecast) {
+            o.print("<p>Trend: collecting (");
+            o.print(trend.getCount() * PRESSURE_SAMPLE_MS / 60000);
+            o.print(" min)</p>");
+            return;
+        }
+        o.print("<p>Trend: <strong>");
+        o.print(trend.getTrend(), 1);
+        o.print(" hPa/3h</strong> (");
+        o.print(PressureTrend::tendencyName(trend.getTendency()));
+        o.print(")</p><p>Forecast: <strong>");
+        o.print(PressureTrend::forecastText(forecast));
+        o.print("</strong></p>");
+    }
+
+    bool isModeShown(DisplayMode mode) const {
+        switch (mode) {
+            case GRAPH:
+                return showGraph && graph.getCount() > 1;
+            case FORECAST:
+                return showForecast && primary()->getForecast();
+            default:
+                return true;
+        }
+    }
+
+    void nextMode() {
+        BME280Sensor* sensor = primary();
+        do {
+            currentMode = static_cast<DisplayMode>((currentMode + 1) % MODE_COUNT);
+        } while (!isModeShown(currentMode));
+        lastCycle = millis();
+
+        // The graph is drawn as raw columns, outside MD_Parola
+        if (currentMode == GRAPH) {
+            P->release();
+            graph.draw(P);
+            return;
+        }
+        if (currentMode != FORECAST) return;
+
+        uint8_t forecast = sensor->getForecast();
+        float dp = sensor->getTrend().getTrend();
+        snprintf(forecastBuffer, sizeof(forecastBuffer), "%s%.1fhPa %s",
+                 dp >= 0 ? "+" : "", dp, PressureTrend::forecastText(forecast));
+        P->displayClear();
+        P->displayText(forecastBuffer, PA_LEFT, BME_FORECAST_SPEED, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
     }
 
     void formatDisplay() {
+        PERF_SCOPE("bme", "format");
         switch (currentMode) {
-            case TEMP: {
-                float t = useCelsius ? temperature : (temperature * 9.0 / 5.0 + 32.0);
-                sprintf(displayBuffer, "%.0f%s", t, useCelsius ? "C" : "F");
+            case TEMP:
+                sprintf(displayBuffer, "%.0f%s", toUnit(getTemperature()), useCelsius ? "C" : "F");
                 break;
-            }
             case HUMIDITY:
-                sprintf(displayBuffer, "%.0f%%", humidity);
+                sprintf(displayBuffer, "%.0f%%", getHumidity());
                 break;
             case PRESSURE:
-                sprintf(displayBuffer, "%.0fhP", pressure);
+                sprintf(displayBuffer, "%.0fhP", getPressure());
                 break;
+            case GRAPH:
+            case FORECAST:
+                break;           // drawn from nextMode()
         }
     }
 };
@@ -0,0 +1,180 @@
+#ifndef BME280_SENSOR_H
+#define BME280_SENSOR_H
+
+#include "SensorBus.h"
+#include "SampleRing.h"
+#include "PressureTrend.h"
+#include "TraceRecorder.h"
+#include <Wire.h>
+#include <Adafruit_Sensor.h>
+#include <Adafruit_BME280.h>
+
+#define BME_READ_INTERVAL 2000
+
+// Station height in metres; the forecast works on sea-level pressure
+#ifndef BME_ALTITUDE_M
+#define BME_ALTITUDE_M 0
+#endif
+
+// Where one BME280 sits: I2C controller (0 = Wire, 1 = Wire1), its pins,
+// and the address set by SDO (0x76 to GND, 0x77 to VCC)
+struct BME280Config {
+    uint8_t bus;
+    uint8_t sda;
+    uint8_t scl;
+    uint8_t address;
+    const char* label;
+};
+
+// One BME280. The sensor runs in normal mode and measures on its own, so
+// a read is only register fetches; each transaction fetches one channel
+// (temperature, humidity, pressure) and another sensor on the bus can go
+// in between.
+class BME280Sensor : public SensorDevice {
+private:
+    BME280Config config;
+    TwoWire& wire;
+    Adafruit_BME280 bme;
+    TraceRecorder& trace = TraceRecorder::instance();
+    bool traced;                 // the trace format carries one BME stream
+    bool ready = false;
+
+    float temperature = 0;
+    float humidity = 0;
+    float pressure = 0;
+
+    enum Step : uint8_t { IDLE, HUMIDITY, PRESSURE };
+    Step step = IDLE;
+    unsigned long lastRead = 0;
+    bool sampleReady = false;
+
+    PressureTrend trend;
+    uint8_t forecast = 0;        // Zambretti number, 0 until the trend is ready
+    SampleRing<SENSOR_HISTORY_SIZE> history;   // temperature, 0.1 °C
+    unsigned long lastHistory = 0;
+
+public:
+    explicit BME280Sensor(const BME280Config& cfg)
+        : config(cfg), wire(cfg.bus ? Wire1 : Wire) {
+        static uint8_t created = 0;
+        traced = created++ == 0;
+    }
+
+    bool begin() override {
+        wire.begin(config.sda, config.scl);
+        delay(100);
+
+        ready = bme.begin(config.address, &wire);
+        if (!ready) {
+            Serial.printf("[BME] %s not found at 0x%02X. Check wiring:\n", config.label, config.address);
+            Serial.printf("  SDA -> GPIO %d, SCL -> GPIO %d, VCC -> 3.3V\n", config.sda, config.scl);
+            return false;
+        }
+
+        bme.setSampling(
+            Adafruit_BME280::MODE_NORMAL,
+            Adafruit_BME280::SAMPLING_X2,
+            Adafruit_BME280::SAMPLING_X16,
+            Adafruit_BME280::SAMPLING_X1,
+            Adafruit_BME280::FILTER_X16,
+            Adafruit_BME280::STANDBY_MS_500
+        );
+        Serial.printf("[BME] %s initialized at 0x%02X on I2C%d\n", config.label, config.address, config.bus);
+        return true;
+    }
+
+    bool transact() override {
+        if (!ready) return false;
+
+        switch (step) {
+            case IDLE:
+                if (millis() - lastRead <= BME_READ_INTERVAL) return false;
+                lastRead = millis();
+                temperature = bme.readTemperature();
+                step = HUMIDITY;
+                return true;
+            case HUMIDITY:
+                humidity = bme.readHumidity();
+                step = PRESSURE;
+                return true;
+            case PRESSURE:
+                pressure = bme.readPressure() / 100.0F;
+                step = IDLE;
+                finishSample();
+                return true;
+        }
+        return false;
+    }
+
+    unsigned long getIdleBudget() override {
+        if (!ready) return SENSOR_IDLE_FOREVER;
+        if (step != IDLE) return 0;
+        return dueIn(lastRead, BME_READ_INTERVAL + 1);
+    }
+
+    const char* getLabel() override {
+        return config.label;
+    }
+
+    // Always metric; the module applies the display unit
+    void writeFields(FieldWriter& out) override {
+        out.writeInt("ok", ready ? 1 : 0);
+        out.writeInt("addr", config.address);
+        out.writeInt("bus", config.bus);
+        out.writeFloat("t", temperature, 1);
+        out.writeFloat("h", humidity, 1);
+        out.writeFloat("p", pressure, 1);
+        out.writeFloat("dp", forecast ? trend.getTrend() : 0, 2);
+        out.writeInt("z", forecast);
+        history.writeArray(out, "hist");
+    }
+
+    // True once per completed read
+    bool takeSample() {
+        bool fresh = sampleReady;
+        sampleReady = false;
+        return fresh;
+    }
+
+    bool isReady() const { return ready; }
+    float getTemperature() const { return temperature; }
+    float getHumidity() const { return humidity; }
+    float getPressure() const { return pressure; }
+    const PressureTrend& getTrend() const { return trend; }
+    uint8_t getForecast() const { return forecast; }
+    const SampleRing<SENSOR_HISTORY_SIZE>& getHistory() const { return history; }
+
+private:
+    void finishSample() {
+        if (traced && trace.isCapturing()) {
+            float values[3] = { temperature, humidity, pressure };
+            trace.record(TRACE_BME_READ, values, sizeof(values));
+        }
+        // A failed read comes back NaN; keep it out of the trend and history
+        if (valid(pressure) && trend.isDue()) updateTrend();
+        if (valid(temperature) && (history.size() == 0 || millis() - lastHistory >= SENSOR_HISTORY_MS)) {
+            history.add(lroundf(temperature * 10));
+            lastHistory = millis();
+        }
+        sampleReady = true;
+    }
+
+    void updateTrend() {
+        PERF_SCOPE("bme", "trend");
+        trend.add(lroundf(pressure * 100));
+        forecast = trend.isReady() ? trend.getForecast(seaLevelPressure()) : 0;
+    }
+
+    static bool valid(float value) {
+        return !isnan(value) && !isinf(value);
+    }
+
+    // Barometric reduction from station height, using the current temperature
+    float seaLevelPressure() const {
+        if (BME_ALTITUDE_M == 0) return pressure;
+        float h = 0.0065f * BME_ALTITUDE_M;
+        return pressure * powf(1 - h / (temperature + h + 273.15f), -5.257f);
+    }
+};
+
+#endif // BME280_SENSOR_H
@@ -66,6 +66,13 @@ public:
         return "Clock";
     }
     
+    unsigned long getIdleBudget() override {
+        if (!active) return MODULE_IDLE_FOREVER;
+        if (showingDate) return 0;
+        unsigned long budget = dueIn(lastTimeUpdate, 1001);
+        return min(budget, dueIn(lastDateScroll, 60001));
+    }
+    
     const char* getWebControls() override {
         return R"rawliteral(
         <div style="border-left: 5px solid #2196F3;">
@@ -79,7 +86,11 @@ public:
         )rawliteral";
     }
     
-    bool handleWebRequest(String request) override {
+    bool acceptsWebRequest(StrView request) override {
+        return request.indexOf("/clock/config") >= 0 || request.indexOf("/clock/activate") >= 0;
+    }
+
+    bool handleWebRequest(StrView request, RequestArena&) override {
         if (request.indexOf("/clock/config") >= 0) {
             int tzIdx = request.indexOf("tz=");
             if (tzIdx >= 0) {
@@ -108,13 +119,9 @@ public:
         return true;
     }
     
-    String getJsonData() override {
-        String json = "{\"time\":\"";
-        json += timeBuffer;
-        json += "\",\"date\":\"";
-        json += dateBuffer;
-        json += "\"}";
-        return json;
+    void writeFields(FieldWriter& out) override {
+        out.writeString("time", timeBuffer);
+        out.writeString("date", dateBuffer);
     }
 
 private:
@@ -0,0 +1,96 @@
+#ifndef DISPLAY_ZONE_H
+#define DISPLAY_ZONE_H
+
+#include <MD_Parola.h>
+
+// A module's view of the LED chain: one MD_Parola zone covering a range of
+// chained MAX7219 devices. Exposes the same calls modules already make on
+// MD_Parola, scoped to the zone, so several modules can animate side by
+// side without touching each other's columns.
+class DisplayZone {
+private:
+    MD_Parola* parola;
+    uint8_t zone;
+    uint8_t firstDevice;
+    uint8_t lastDevice;
+
+public:
+    static const uint8_t COLUMNS_PER_DEVICE = 8;
+
+    DisplayZone(MD_Parola* p, uint8_t z, uint8_t first, uint8_t last)
+        : parola(p), zone(z), firstDevice(first), lastDevice(last) {}
+
+    void displayText(const char* text, textPosition_t align, uint16_t speed, uint16_t pause,
+                     textEffect_t effectIn, textEffect_t effectOut = PA_NO_EFFECT) {
+        parola->displayZoneText(zone, text, align, speed, pause, effectIn, effectOut);
+    }
+
+    void displayClear() {
+        parola->displayClear(zone);
+    }
+
+    // True once this zone's animation has finished. ModuleManager::update()
+    // advances all zones with one MD_Parola::displayAnimate() per pass, so
+    // modules sharing the chain don't each run a frame of every zone.
+    bool displayAnimate() {
+        return parola->getZoneStatus(zone);
+    }
+
+    // True until MD_Parola has finished this zone's current animation
+    bool isAnimating() {
+        return !parola->getZoneStatus(zone);
+    }
+
+    void setIntensity(uint8_t level) {
+        parola->setIntensity(zone, level);
+    }
+
+    // Stops MD_Parola animating this zone so a module can draw raw columns
+    void release() {
+        parola->displayZoneText(zone, "", PA_LEFT, 0, 0, PA_NO_EFFECT, PA_NO_EFFECT);
+        for (uint8_t i = 0; i < 8 && !parola->getZoneStatus(zone); i++) {
+            parola->displayAnimate();
+        }
+        parola->displayClear(zone);
+    }
+
+    // Rasterizes text with the display font into columns, left to right,
+    // one blank column between characters. Returns the columns written.
+    uint16_t renderText(const char* text, uint8_t* columns, uint16_t maxColumns) {
+        MD_MAX72XX* mx = parola->getGraphicObject();
+        uint8_t glyph[16];
+        uint16_t width = 0;
+        for (const char* c = text; *c; c++) {
+            uint8_t w = mx->getChar((uint8_t)*c, sizeof(glyph), glyph);
+            if (width + w + 1 > maxColumns) break;
+            memcpy(columns + width, glyph, w);
+            width += w;
+            columns[width++] = 0;
+        }
+        return width;
+    }
+
+    // Fills the zone from columns[start], left to right; positions outside
+    // 0..length-1 are blank, so start runs from -getColumnCount() to length
+    // to scroll a bitmap all the way through
+    void drawColumns(const uint8_t* columns, uint16_t length, int16_t start) {
+        MD_MAX72XX* mx = parola->getGraphicObject();
+        uint16_t count = getColumnCount();
+        uint16_t left = getFirstColumn() + count - 1;   // column 0 is the right edge
+        mx->control(firstDevice, lastDevice, MD_MAX72XX::UPDATE, MD_MAX72XX::OFF);
+        for (uint16_t i = 0; i < count; i++) {
+            int32_t c = (int32_t)start + i;
+            mx->setColumn(left - i, (c >= 0 && c < length) ? columns[c] : 0);
+        }
+        mx->control(firstDevice, lastDevice, MD_MAX72XX::UPDATE, MD_MAX72XX::ON);
+    }
+
+    // Raw pixel access; columns are absolute, use getFirstColumn() to offset
+    MD_MAX72XX* getGraphicObject() { return parola->getGraphicObject(); }
+
+    uint8_t getZone() const { return zone; }
+    uint16_t getFirstColumn() const { return firstDevice * COLUMNS_PER_DEVICE; }
+    uint16_t getColumnCount() const { return (lastDevice - firstDevice + 1) * COLUMNS_PER_DEVICE; }
+};
+
+#endif // DISPLAY_ZONE_H
@@ -0,0 +1,129 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <Arduino.h>
+
+// Allocation-free publish/subscribe between modules.
+//
+// publish() copies a fixed-size Event into a ring queue; dispatch(), called
+// once per loop by ModuleManager, delivers queued events to listeners whose
+// topic mask matches. Events published while dispatching are delivered on
+// the next pass. When the queue is full the oldest event is dropped, so
+// listeners always see the latest state.
+
+#define EVENT_QUEUE_SIZE 16          // power of two
+#define EVENT_MAX_LISTENERS 12
+#define EVENT_NAME_LEN 16            // with the NUL; longer names are cut
+
+enum EventTopic : uint8_t {
+    EVENT_SENSOR_SAMPLE,     // source + values[]: BME280 t/h/p, PMS pm1/pm25/pm10
+    EVENT_MODULE_ACTIVATED,  // name: module now shown in its zone
+    EVENT_MODULE_REQUEST,    // name: module asking to be shown
+    EVENT_TIMER_STARTED,     // name + values[0]: duration in ms, values[1]: TimerId
+    EVENT_TIMER_EXPIRED,     // name + values[1]: TimerId
+    EVENT_TIMER_STOPPED,     // name + values[1]: TimerId
+    EVENT_TOPIC_COUNT
+};
+
+enum EventSource : uint8_t {
+    SOURCE_NONE,
+    SOURCE_BME280,
+    SOURCE_PMS,
+    SOURCE_POMODORO,
+    SOURCE_TIMER             // user timers and reminders from /api/timers
+};
+
+#define EVENT_MASK(topic) (1UL << (topic))
+
+struct Event {
+    EventTopic topic;
+    EventSource source;
+    uint32_t timestamp;      // millis() at publish
+    char name[EVENT_NAME_LEN];   // copied at publish; empty if none
+    float values[3];
+};
+
+class EventListener {
+public:
+    virtual ~EventListener() {}
+    virtual void onEvent(const Event& event) = 0;
+};
+
+class EventBus {
+private:
+    struct Subscription {
+        uint32_t mask;
+        EventListener* listener;
+    };
+
+    Event queue[EVENT_QUEUE_SIZE];
+    uint8_t head = 0;    // next to dispatch
+    uint8_t count = 0;
+
+    Subscription subscriptions[EVENT_MAX_LISTENERS];
+    uint8_t subscriptionCount = 0;
+
+    uint32_t published = 0;
+    uint32_t delivered = 0;
+    uint32_t dropped = 0;
+
+public:
+    bool subscribe(EventListener* listener, uint32_t mask) {
+        if (!listener || !mask) return false;
+        if (subscriptionCount >= EVENT_MAX_LISTENERS) {
+            Serial.println("[EventBus] Too many listeners");
+            return false;
+        }
+        subscriptions[subscriptionCount++] = { mask, listener };
+        return true;
+    }
+
+    void publish(EventTopic topic, EventSource source, const char* name = nullptr,
+                 float v0 = 0, float v1 = 0, float v2 = 0) {
+        if (count == EVENT_QUEUE_SIZE) {
+            head = (head + 1) & (EVENT_QUEUE_SIZE - 1);
+            count--;
+            dropped++;
+        }
+
+        Event& e = queue[(head + count) & (EVENT_QUEUE_SIZE - 1)];
+        e.topic = topic;
+        e.source = source;
+        e.timestamp = millis();
+        // Copied: a timer's name lives in its pool slot, which cancel()
+        // then start() can reuse before this event is dispatched
+        strncpy(e.name, name ? name : "", EVENT_NAME_LEN - 1);
+        e.name[EVENT_NAME_LEN - 1] = '\0';
+        e.values[0] = v0;
+        e.values[1] = v1;
+        e.values[2] = v2;
+        count++;
+        published++;
+    }
+
+    // Delivers the events queued before this call; returns how many
+    uint8_t dispatch() {
+        uint8_t pending = count;
+        for (uint8_t n = 0; n < pending && count > 0; n++) {
+            Event event = queue[head];   // copy: listeners may publish
+            head = (head + 1) & (EVENT_QUEUE_SIZE - 1);
+            count--;
+
+            uint32_t bit = EVENT_MASK(event.topic);
+            for (uint8_t i = 0; i < subscriptionCount; i++) {
+                if (subscriptions[i].mask & bit) {
+                    subscriptions[i].listener->onEvent(event);
+                    delivered++;
+                }
+            }
+        }
+        return pending;
+    }
+
+    uint8_t getPending() const { return count; }
+    uint32_t getPublished() const { return published; }
+    uint32_t getDelivered() const { return delivered; }
+    uint32_t getDropped() const { return dropped; }
+};
+
+#endif // EVENT_BUS_H
@@ -0,0 +1,71 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "EventBus.h"
+#include "FieldWriter.h"
+
+#define EVENT_LOG_SIZE 32            // power of two
+
+// The event bus for web clients: keeps the last EVENT_LOG_SIZE events,
+// numbered, for /api/events?since=<seq>. A client passes the last seq it
+// saw and gets every event after it exactly once, however far apart its
+// polls are, plus a count of any that were overwritten in between.
+// Requests are answered in the pass they arrive, so this replaces a held
+// long-poll or event stream that would pin one of the few socket slots.
+class EventLog : public EventListener {
+private:
+    Event log[EVENT_LOG_SIZE];
+    uint32_t sequence = 0;           // of the newest event; 0 before any
+
+public:
+    void begin(EventBus& bus) {
+        bus.subscribe(this, (1UL << EVENT_TOPIC_COUNT) - 1);
+    }
+
+    void onEvent(const Event& event) override {
+        log[sequence & (EVENT_LOG_SIZE - 1)] = event;
+        sequence++;
+    }
+
+    uint32_t getSequence() const { return sequence; }
+
+    // "seq" is the newest event's number, to pass as since next time;
+    // "lost" counts events after since that were already overwritten
+    void writeFields(FieldWriter& out, uint32_t since) {
+        if (since > sequence) since = 0;    // the device restarted
+        uint32_t oldest = sequence > EVENT_LOG_SIZE ? sequence - EVENT_LOG_SIZE : 0;
+        uint32_t first = since > oldest ? since : oldest;
+
+        out.writeInt("seq", sequence);
+        out.writeInt("lost", first - since);
+        out.beginArray("events");
+        for (uint32_t seq = first; seq < sequence; seq++) {
+            const Event& event = log[seq & (EVENT_LOG_SIZE - 1)];
+            out.beginObject();
+            out.writeInt("seq", seq + 1);
+            out.writeInt("t", event.timestamp);
+            out.writeString("topic", topicName(event.topic));
+            out.writeInt("src", event.source);
+            if (event.name[0]) out.writeString("name", event.name);
+            out.beginArray("v");
+            for (float value : event.values) out.writeFloat(nullptr, value, 2);
+            out.endArray();
+            out.endObject();
+        }
+        out.endArray();
+    }
+
+    static const char* topicName(EventTopic topic) {
+        switch (topic) {
+            case EVENT_SENSOR_SAMPLE:    return "sample";
+            case EVENT_MODULE_ACTIVATED: return "activated";
+            case EVENT_MODULE_REQUEST:   return "request";
+            case EVENT_TIMER_STARTED:    return "timer_started";
+            case EVENT_TIMER_EXPIRED:    return "timer_expired";
+            case EVENT_TIMER_STOPPED:    return "timer_stopped";
+            default:                     return "";
+        }
+    }
+};
+
+#endif // EVENT_LOG_H
@@ -0,0 +1,227 @@
+#ifndef FIELD_WRITER_H
+#define FIELD_WRITER_H
+
+#include <Arduino.h>
+
+// Typed, streaming description of module state. Modules describe their
+// fields once in writeFields(); JsonWriter and CborWriter turn that into
+// /api/data and /api/data.cbor without building anything on the heap.
+class FieldWriter {
+public:
+    virtual ~FieldWriter() {}
+
+    // key is nullptr for the root object and for array elements
+    virtual void beginObject(const char* key = nullptr) = 0;
+    virtual void endObject() = 0;
+    virtual void beginArray(const char* key) = 0;
+    virtual void endArray() = 0;
+
+    virtual void writeInt(const char* key, long value) = 0;
+    virtual void writeFloat(const char* key, float value, uint8_t decimals) = 0;
+    virtual void writeString(const char* key, const char* value) = 0;
+};
+
+// --------------------------------------------------------------------------------
+//  JSON
+// --------------------------------------------------------------------------------
+class JsonWriter : public FieldWriter {
+private:
+    static const uint8_t MAX_DEPTH = 8;
+
+    Print& out;
+    bool first[MAX_DEPTH];
+    uint8_t depth = 0;
+
+public:
+    explicit JsonWriter(Print& target) : out(target) {}
+
+    void beginObject(const char* key = nullptr) override {
+        writeKey(key);
+        out.print('{');
+        if (depth < MAX_DEPTH) first[depth] = true;
+        depth++;
+    }
+
+    void endObject() override {
+        if (depth > 0) depth--;
+        out.print('}');
+    }
+
+    void beginArray(const char* key) override {
+        writeKey(key);
+        out.print('[');
+        if (depth < MAX_DEPTH) first[depth] = true;
+        depth++;
+    }
+
+    void endArray() override {
+        if (depth > 0) depth--;
+        out.print(']');
+    }
+
+    void writeInt(const char* key, long value) override {
+        writeKey(key);
+        out.print(value);
+    }
+
+    void writeFloat(const char* key, float value, uint8_t decimals) override {
+        writeKey(key);
+        if (isnan(value) || isinf(value)) {
+            out.print("null");
+        } else {
+            out.print(value, decimals);
+        }
+    }
+
+    void writeString(const char* key, const char* value) override {
+        writeKey(key);
+        writeQuoted(value);
+    }
+
+private:
+    void writeKey(const char* key) {
+        if (depth > 0 && depth <= MAX_DEPTH) {
+            if (!first[depth - 1]) out.print(',');
+            first[depth - 1] = false;
+        }
+        if (key) {
+            writeQuoted(key);
+            out.print(':');
+        }
+    }
+
+    void writeQuoted(const char* s) {
+        out.print('"');
+        for (; *s; s++) {
+            char c = *s;
+            if (c == '"' || c == '\\') {
+                out.print('\\');
+                out.print(c);
+            } else if ((uint8_t)c < 0x20) {
+                out.printf("\\u%04x", c);
+            } else {
+                out.print(c);
+            }
+        }
+        out.print('"');
+    }
+};
+
+// --------------------------------------------------------------------------------
+//  CBOR (RFC 8949)
+// --------------------------------------------------------------------------------
+// Objects and arrays are indefinite-length so fields can be streamed
+// without counting them first. Floats are encoded as single precision
+// after the same rounding the JSON path gets from Print, so both
+// encodings carry equal values.
+class CborWriter : public FieldWriter {
+private:
+    enum MajorType : uint8_t {
+        CBOR_UINT = 0,
+        CBOR_NEGINT = 1,
+        CBOR_TEXT = 3,
+        CBOR_ARRAY = 4,
+        CBOR_MAP = 5,
+        CBOR_SIMPLE = 7
+    };
+
+    Print& out;
+
+public:
+    explicit CborWriter(Print& target) : out(target) {}
+
+    void beginObject(const char* key = nullptr) override {
+        if (key) writeText(key);
+        out.write((uint8_t)((CBOR_MAP << 5) | 31));
+    }
+
+    void endObject() override {
+        out.write((uint8_t)0xFF);
+    }
+
+    void beginArray(const char* key) override {
+        if (key) writeText(key);
+        out.write((uint8_t)((CBOR_ARRAY << 5) | 31));
+    }
+
+    void endArray() override {
+        out.write((uint8_t)0xFF);
+    }
+
+    void writeInt(const char* key, long value) override {
+        if (key) writeText(key);
+        if (value >= 0) {
+            writeHead(CBOR_UINT, (uint32_t)value);
+        } else {
+            writeHead(CBOR_NEGINT, (uint32_t)(-1 - value));
+        }
+    }
+
+    void writeFloat(const char* key, float value, uint8_t decimals) override {
+        if (key) writeText(key);
+
+        if (!isnan(value) && !isinf(value)) value = printedValue(value, decimals);
+
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        uint8_t buf[5] = {
+            (uint8_t)((CBOR_SIMPLE << 5) | 26),
+            (uint8_t)(bits >> 24), (uint8_t)(bits >> 16), (uint8_t)(bits >> 8), (uint8_t)bits
+        };
+        out.write(buf, sizeof(buf));
+    }
+
+    void writeString(const char* key, const char* value) override {
+        if (key) writeText(key);
+        writeText(value);
+    }
+
+private:
+    // The digits Print::print(value, decimals) writes for the JSON path. It
+    // adds half a unit in double precision and truncates, so 2.125 prints as
+    // 2.12 where roundf() would give 2.13.
+    static float printedValue(float value, uint8_t decimals) {
+        double v = fabs((double)value);
+        if (v > 4294967040.0) return value;
+        double rounding = 0.5;
+        for (uint8_t i = 0; i < decimals; i++) rounding /= 10.0;
+        v += rounding;
+        uint32_t whole = (uint32_t)v;
+        double rest = v - (double)whole;
+        double result = whole;
+        double unit = 1;
+        for (uint8_t i = 0; i < decimals; i++) {
+            rest *= 10.0;
+            uint8_t digit = (uint8_t)rest;
+            rest -= digit;
+            unit /= 10.0;
+            result += digit * unit;
+        }
+        return value < 0 ? -result : result;
+    }
+
+    void writeText(const char* s) {
+        size_t len = strlen(s);
+        writeHead(CBOR_TEXT, len);
+        out.write((const uint8_t*)s, len);
+    }
+
+    void writeHead(uint8_t major, uint32_t value) {
+        uint8_t type = major << 5;
+        if (value < 24) {
+            out.write((uint8_t)(type | value));
+        } else if (value <= 0xFF) {
+            uint8_t buf[2] = { (uint8_t)(type | 24), (uint8_t)value };
+            out.write(buf, sizeof(buf));
+        } else if (value <= 0xFFFF) {
+            uint8_t buf[3] = { (uint8_t)(type | 25), (uint8_t)(value >> 8), (uint8_t)value };
+            out.write(buf, sizeof(buf));
+        } else {
+            uint8_t buf[5] = { (uint8_t)(type | 26),
+                (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value };
+            out.write(buf, sizeof(buf));
+        }
+    }
+};
+
+#endif // FIELD_WRITER_H
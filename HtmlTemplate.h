@@ -0,0 +1,113 @@
+#ifndef HTML_TEMPLATE_H
+#define HTML_TEMPLATE_H
+
+#include <Arduino.h>
+
+// Streaming HTML template.
+//
+// The source is plain text with numbered slots {{0}}..{{9}}. On first render
+// it is compiled into a list of literal chunks (offsets into the source, so
+// nothing is copied), each optionally followed by a slot. Rendering writes
+// the chunks straight to a Print (usually the WiFiClient) and calls back for
+// every slot, so no intermediate String is ever built.
+//
+//   HTML_TEMPLATE(tpl, R"(<p>Work: {{0}} min</p>)");
+//   tpl.render(out, [this](Print& o, uint8_t slot) { o.print(workMin); });
+//
+// HTML_TEMPLATE counts the parts at compile time and sizes the template to
+// fit, so no part can be dropped.
+
+// Parts compile() makes of src: one per slot, plus any trailing literal
+constexpr uint8_t htmlTemplateParts(const char* src) {
+    uint8_t parts = 0;
+    uint16_t start = 0;
+    uint16_t i = 0;
+    while (src[i]) {
+        if (src[i] == '{' && src[i + 1] == '{' &&
+            src[i + 2] >= '0' && src[i + 2] <= '9' &&
+            src[i + 3] == '}' && src[i + 4] == '}') {
+            parts++;
+            i += 5;
+            start = i;
+        } else {
+            i++;
+        }
+    }
+    return parts + (i > start ? 1 : 0);
+}
+
+// Declares a function-local static template with exactly the parts src needs
+#define HTML_TEMPLATE(name, src) \
+    static HtmlTemplate<htmlTemplateParts(src)> name(src)
+
+template <uint8_t MAX_PARTS = 16>
+class HtmlTemplate {
+private:
+    struct Part {
+        uint16_t offset;
+        uint16_t length;
+        int8_t slot;      // -1 for a trailing literal with no slot
+    };
+
+    const char* source;
+    Part parts[MAX_PARTS];
+    uint8_t partCount = 0;
+    bool compiled = false;
+    bool overflowed = false;
+
+public:
+    explicit HtmlTemplate(const char* src) : source(src) {}
+
+    template <typename SlotWriter>
+    void render(Print& out, SlotWriter writeSlot) {
+        if (!compiled) compile();
+        if (overflowed) {
+            out.print("<p>[HtmlTemplate] too many parts</p>");
+            return;
+        }
+
+        for (uint8_t i = 0; i < partCount; i++) {
+            const Part& part = parts[i];
+            if (part.length) out.write(source + part.offset, part.length);
+            if (part.slot >= 0) writeSlot(out, (uint8_t)part.slot);
+        }
+    }
+
+    void render(Print& out) {
+        render(out, [](Print&, uint8_t) {});
+    }
+
+private:
+    void compile() {
+        uint16_t start = 0;
+        uint16_t i = 0;
+
+        while (source[i]) {
+            if (source[i] == '{' && source[i + 1] == '{' &&
+                source[i + 2] >= '0' && source[i + 2] <= '9' &&
+                source[i + 3] == '}' && source[i + 4] == '}') {
+                addPart(start, i - start, source[i + 2] - '0');
+                i += 5;
+                start = i;
+            } else {
+                i++;
+            }
+        }
+
+        if (i > start) addPart(start, i - start, -1);
+        compiled = true;
+    }
+
+    void addPart(uint16_t offset, uint16_t length, int8_t slot) {
+        // Unreachable for HTML_TEMPLATE. A hand-sized template that is too
+        // small renders an error in place of the panel, not a partial one.
+        if (partCount >= MAX_PARTS) {
+            Serial.printf("[HtmlTemplate] More than %u parts, use HTML_TEMPLATE\n", MAX_PARTS);
+            overflowed = true;
+            return;
+        }
+        parts[partCount++] = { offset, length, slot };
+    }
+};
+
+#endif // HTML_TEMPLATE_H
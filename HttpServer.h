@@ -0,0 +1,373 @@
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <WiFi.h>
+#include "RequestArena.h"
+
+// Persistent-connection HTTP/1.1 server on top of WiFiServer.
+//
+// Up to HTTP_MAX_CLIENTS sockets stay open between requests. Each keeps a
+// fixed receive buffer that is parsed without blocking; several pipelined
+// requests in one buffer are answered in order. Every response is framed
+// with Content-Length or chunked encoding so the socket can be reused;
+// HTTP/1.0 has no chunked encoding, so a streamed response to a 1.0
+// client ends when the connection closes.
+// Idle sockets are closed after HTTP_IDLE_TIMEOUT_MS, and the longest-idle
+// one is evicted when a new client arrives and all slots are busy, keeping
+// us well inside lwIP's small socket pool.
+//
+// Each connection also owns a RequestArena that holds the response chunk
+// buffer and whatever the handlers decode, reset after every response.
+
+#ifndef HTTP_MAX_CLIENTS
+#define HTTP_MAX_CLIENTS 4
+#endif
+#define HTTP_BUFFER_SIZE 1024          // request line + headers + body
+#define HTTP_IDLE_TIMEOUT_MS 5000
+#define HTTP_MAX_REQUESTS_PER_POLL 4   // pipelined requests handled per client per loop
+#define HTTP_CHUNK_SIZE 256
+
+struct HttpRequest {
+    const char* line;       // "GET /path?query HTTP/1.1", NUL-terminated
+    const char* body;       // NUL-terminated, empty if none
+    size_t bodyLength;
+    bool keepAlive;
+    bool http11;            // false for HTTP/1.0
+    RequestArena& arena;    // scratch until the response is sent
+};
+
+// Response writer. Either send() a complete body with Content-Length, or
+// begin() a streamed response, print() into it and end() it. Streaming is
+// chunked for HTTP/1.1; for HTTP/1.0 the body runs until the server closes
+// the connection.
+class HttpResponse : public Print {
+private:
+    WiFiClient& client;
+    bool keepAlive;
+    bool http11;
+    bool started = false;
+    bool streaming = false;
+    uint8_t* buffer;
+    size_t used = 0;
+
+public:
+    // Takes its chunk buffer from a fresh arena, before the handler runs
+    HttpResponse(WiFiClient& c, bool persistent, bool version11, RequestArena& arena)
+        : client(c), keepAlive(persistent), http11(version11),
+          buffer((uint8_t*)arena.alloc(HTTP_CHUNK_SIZE)) {}
+
+    void send(int status, const char* type, const uint8_t* data, size_t len, const char* headers = "") {
+        writeHead(status, type, headers);
+        client.printf("Content-Length: %u\r\n\r\n", (unsigned)len);
+        if (len) client.write(data, len);
+        started = true;
+    }
+
+    void send(int status, const char* type, const char* text) {
+        send(status, type, (const uint8_t*)text, strlen(text));
+    }
+
+    void begin(int status, const char* type, const char* headers = "") {
+        if (!http11) keepAlive = false;
+        writeHead(status, type, headers);
+        client.print(http11 ? "Transfer-Encoding: chunked\r\n\r\n" : "\r\n");
+        started = true;
+        streaming = true;
+    }
+
+    void end() {
+        if (!streaming) return;
+        flushChunk();
+        if (http11) client.print("0\r\n\r\n");
+        streaming = false;
+    }
+
+    using Print::write;
+
+    size_t write(uint8_t c) override {
+        if (!streaming) return 0;
+        if (used == HTTP_CHUNK_SIZE) flushChunk();
+        buffer[used++] = c;
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t len) override {
+        if (!streaming) return 0;
+        size_t remaining = len;
+        while (remaining) {
+            if (used == HTTP_CHUNK_SIZE) flushChunk();
+            size_t n = HTTP_CHUNK_SIZE - used;
+            if (n > remaining) n = remaining;
+            memcpy(buffer + used, data, n);
+            used += n;
+            data += n;
+            remaining -= n;
+        }
+        return len;
+    }
+
+    bool isStarted() const { return started; }
+    bool isKeepAlive() const { return keepAlive; }
+
+private:
+    void writeHead(int status, const char* type, const char* headers) {
+        client.printf("HTTP/1.1 %d %s\r\nContent-Type: %s\r\nConnection: %s\r\n%s",
+                      status, statusText(status), type,
+                      keepAlive ? "keep-alive" : "close", headers);
+    }
+
+    void flushChunk() {
+        if (!used) return;
+        if (http11) client.printf("%x\r\n", (unsigned)used);
+        client.write(buffer, used);
+        if (http11) client.print("\r\n");
+        used = 0;
+    }
+
+    static const char* statusText(int status) {
+        switch (status) {
+            case 200: return "OK";
+            case 204: return "No Content";
+            case 400: return "Bad Request";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 409: return "Conflict";
+            case 413: return "Payload Too Large";
+            case 503: return "Service Unavailable";
+            default:  return "";
+        }
+    }
+};
+
+typedef void (*HttpHandler)(HttpRequest& request, HttpResponse& response);
+
+class HttpServer {
+private:
+    struct Connection {
+        WiFiClient client;
+        bool open = false;
+        unsigned long lastActivity = 0;
+        size_t used = 0;
+        char buffer[HTTP_BUFFER_SIZE + 1];
+        RequestArena arena;
+    };
+
+    WiFiServer& server;
+    HttpHandler handler = nullptr;
+    Connection connections[HTTP_MAX_CLIENTS];
+
+    unsigned long accepted = 0;
+    unsigned long served = 0;
+    unsigned long evicted = 0;
+
+public:
+    explicit HttpServer(WiFiServer& srv) : server(srv) {}
+
+    void begin(HttpHandler h) {
+        handler = h;
+        server.begin();
+        server.setNoDelay(true);
+    }
+
+    void update() {
+        acceptClients();
+
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            Connection& conn = connections[i];
+            if (!conn.open) continue;
+
+            if (!conn.client.connected() && !conn.client.available()) {
+                close(conn);
+                continue;
+            }
+
+            receive(conn);
+            for (int n = 0; n < HTTP_MAX_REQUESTS_PER_POLL && conn.open; n++) {
+                if (!handleNext(conn)) break;
+            }
+
+            if (conn.open && millis() - conn.lastActivity > HTTP_IDLE_TIMEOUT_MS) {
+                close(conn);
+            }
+        }
+    }
+
+    // True while any socket is open; useful to keep the CPU responsive
+    bool hasClients() const {
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            if (connections[i].open) return true;
+        }
+        return false;
+    }
+
+    // True when an open connection has unread bytes, e.g. the next request
+    // on a keep-alive socket
+    bool hasPendingInput() {
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            if (connections[i].open && connections[i].client.available() > 0) return true;
+        }
+        return false;
+    }
+
+    unsigned long getAccepted() const { return accepted; }
+    unsigned long getServed() const { return served; }
+    unsigned long getEvicted() const { return evicted; }
+
+    // Most arena bytes any request needed, and allocations refused
+    size_t getArenaPeak() const {
+        size_t peak = 0;
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            if (connections[i].arena.getPeak() > peak) peak = connections[i].arena.getPeak();
+        }
+        return peak;
+    }
+
+    uint32_t getArenaFailures() const {
+        uint32_t failures = 0;
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) failures += connections[i].arena.getFailures();
+        return failures;
+    }
+
+private:
+    void acceptClients() {
+        while (true) {
+            WiFiClient client = server.available();
+            if (!client) return;
+
+            Connection* slot = freeSlot();
+            if (!slot) {
+                Connection* idle = longestIdle();
+                if (idle) {
+                    close(*idle);
+                    evicted++;
+                    slot = idle;
+                }
+            }
+            if (!slot) {
+                client.print("HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\nContent-Length: 0\r\n\r\n");
+                client.stop();
+                continue;
+            }
+
+            slot->client = client;
+            slot->client.setNoDelay(true);
+            slot->open = true;
+            slot->used = 0;
+            slot->lastActivity = millis();
+            accepted++;
+        }
+    }
+
+    Connection* freeSlot() {
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            if (!connections[i].open) return &connections[i];
+        }
+        return nullptr;
+    }
+
+    // Longest-idle connection with no partial request buffered, if any
+    Connection* longestIdle() {
+        Connection* oldest = nullptr;
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            Connection& c = connections[i];
+            if (c.used > 0) continue;
+            if (!oldest || millis() - c.lastActivity > millis() - oldest->lastActivity) oldest = &c;
+        }
+        return oldest;
+    }
+
+    void receive(Connection& conn) {
+        int avail = conn.client.available();
+        if (avail <= 0) return;
+
+        size_t space = HTTP_BUFFER_SIZE - conn.used;
+        if ((size_t)avail > space) avail = space;
+        if (avail == 0) return;
+
+        int n = conn.client.read((uint8_t*)conn.buffer + conn.used, avail);
+        if (n > 0) {
+            conn.used += n;
+            conn.lastActivity = millis();
+        }
+    }
+
+    // Parses and answers one complete request from the front of the buffer.
+    // Returns false when the buffer holds no complete request.
+    bool handleNext(Connection& conn) {
+        conn.buffer[conn.used] = '\0';
+        char* headerEnd = strstr(conn.buffer, "\r\n\r\n");
+        if (!headerEnd) {
+            if (conn.used == HTTP_BUFFER_SIZE) reject(conn, 413);
+            return false;
+        }
+
+        char* lineEnd = strstr(conn.buffer, "\r\n");
+        *lineEnd = '\0';
+
+        size_t contentLength = 0;
+        bool http11 = strstr(conn.buffer, "HTTP/1.1") != nullptr;
+        bool keepAlive = http11;
+        for (char* h = lineEnd + 2; h < headerEnd; ) {
+            char* next = strstr(h, "\r\n");
+            if (strncasecmp(h, "Content-Length:", 15) == 0) {
+                contentLength = strtoul(h + 15, nullptr, 10);
+            } else if (strncasecmp(h, "Connection:", 11) == 0) {
+                const char* v = h + 11;
+                while (*v == ' ') v++;
+                if (strncasecmp(v, "close", 5) == 0) keepAlive = false;
+                else if (strncasecmp(v, "keep-alive", 10) == 0) keepAlive = true;
+            }
+            h = next + 2;
+        }
+
+        char* body = headerEnd + 4;
+        size_t headerLength = body - conn.buffer;
+        if (headerLength + contentLength > HTTP_BUFFER_SIZE) {
+            reject(conn, 413);
+            return false;
+        }
+        if (conn.used < headerLength + contentLength) {
+            *lineEnd = '\r';  // incomplete body; parse again when more arrives
+            return false;
+        }
+
+        // Terminate the body in place, remembering the byte we overwrite
+        // (it may be the start of the next pipelined request)
+        char saved = body[contentLength];
+        body[contentLength] = '\0';
+
+        conn.arena.reset();
+        HttpRequest request = { conn.buffer, body, contentLength, keepAlive, http11, conn.arena };
+        HttpResponse response(conn.client, keepAlive, http11, conn.arena);
+        if (handler) handler(request, response);
+        if (!response.isStarted()) response.send(404, "text/plain", "Not Found");
+        response.end();
+        conn.arena.reset();
+        served++;
+
+        body[contentLength] = saved;
+        size_t consumed = headerLength + contentLength;
+        memmove(conn.buffer, conn.buffer + consumed, conn.used - consumed);
+        conn.used -= consumed;
+        conn.lastActivity = millis();
+
+        // A streamed HTTP/1.0 body ends with the connection
+        if (!response.isKeepAlive()) close(conn);
+        return true;
+    }
+
+    void reject(Connection& conn, int status) {
+        conn.arena.reset();
+        HttpResponse response(conn.client, false, true, conn.arena);
+        response.send(status, "text/plain", "");
+        close(conn);
+    }
+
+    void close(Connection& conn) {
+        conn.client.stop();
+        conn.open = false;
+        conn.used = 0;
+    }
+};
+
+#endif // HTTP_SERVER_H
@@ -3,9 +3,17 @@
 
 #include <MD_Parola.h>
 #include <WiFiClient.h>
+#include "FieldWriter.h"
+#include "DisplayZone.h"
+#include "EventBus.h"
+#include "TimerWheel.h"
+#include "PerfCounters.h"
+#include "RequestArena.h"
+
+#define MODULE_IDLE_FOREVER 0xFFFFFFFFUL
 
 // Base class for all modules
-class Module {
+class Module : public EventListener {
 public:
     virtual ~Module() {}
     
@@ -17,24 +25,62 @@ public:
     
     // Module info
     virtual const char* getName() = 0;
-    virtual const char* getWebControls() = 0;
+    virtual const char* getWebControls() { return ""; }
+    
+    // Streams the control panel; modules with live values override this
+    // and render an HtmlTemplate instead of returning static HTML.
+    virtual void writeWebControls(Print& out) { out.print(getWebControls()); }
+    
+    // Web request handling. request views the request line; anything
+    // decoded or copied out of it goes in arena, which lives until the
+    // response is sent
+    virtual bool handleWebRequest(StrView request, RequestArena& arena) { return false; }
+    // True if handleWebRequest() would take request, without acting on it.
+    // /api/batch checks every command this way before running any.
+    virtual bool acceptsWebRequest(StrView request) { return false; }
     
-    // Web request handling
-    virtual bool handleWebRequest(String request) { return false; }
+    // Live state for /api/data (JSON) and /api/data.cbor, written into the
+    // module's own object. Keep keys and types stable between releases.
+    virtual void writeFields(FieldWriter& out) {}
     
-    // JSON data for live dashboard
-    virtual String getJsonData() { return ""; }
+    // Events: return an EVENT_MASK() of topics to receive in onEvent().
+    // Called only for matching events, from ModuleManager::update().
+    virtual uint32_t getEventMask() { return 0; }
+    void onEvent(const Event& event) override {}
+    void setEventBus(EventBus* eventBus) { bus = eventBus; }
+    void setTimerWheel(TimerWheel* wheel) { timers = wheel; }
     
-    // Display access
-    void setDisplay(MD_Parola* display) { P = display; }
+    // Power: milliseconds this module can go without update() before it
+    // falls behind, so PowerGovernor can idle the CPU until then. 0 means
+    // every loop pass, the default for modules that don't declare one.
+    virtual unsigned long getIdleBudget() { return 0; }
+    // True while hardware streams data in that light sleep would lose
+    virtual bool blocksLightSleep() { return false; }
+    
+    // Display access, scoped to the module's zone
+    void setDisplay(DisplayZone* display) { P = display; }
+    DisplayZone* getDisplay() { return P; }
     
     // Status
     virtual bool isActive() { return active; }
     virtual bool shouldStayActive() { return false; } // Override for persistent modules
     
 protected:
-    MD_Parola* P = nullptr;
+    DisplayZone* P = nullptr;
+    EventBus* bus = nullptr;
+    TimerWheel* timers = nullptr;
     bool active = false;
+    
+    void publish(EventTopic topic, EventSource source, const char* name = nullptr,
+                 float v0 = 0, float v1 = 0, float v2 = 0) {
+        if (bus) bus->publish(topic, source, name, v0, v1, v2);
+    }
+    
+    // Milliseconds left until interval has passed since a millis() stamp
+    static unsigned long dueIn(unsigned long since, unsigned long interval) {
+        unsigned long elapsed = millis() - since;
+        return elapsed >= interval ? 0 : interval - elapsed;
+    }
 };
 
 #endif // MODULE_H
\ No newline at end of file
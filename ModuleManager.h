@@ -2,73 +2,156 @@
 #define MODULE_MANAGER_H
 
 #include "Module.h"
+#include "DisplayZone.h"
+#include "SensorBus.h"
 #include <vector>
 
-class ModuleManager {
+#define BATCH_MAX_COMMAND 128
+
+// Each display zone shows one active module at a time and falls back to
+// its own default module; modules in different zones run side by side.
+class ModuleManager : public EventListener {
 private:
+    struct Zone {
+        DisplayZone* display;
+        Module* activeModule;
+        Module* defaultModule;
+        unsigned long lastAutoSwitch;
+    };
+    
     std::vector<Module*> modules;
-    Module* activeModule = nullptr;
-    Module* defaultModule = nullptr;
-    MD_Parola* display = nullptr;
+    std::vector<uint8_t> updateProbes;   // PerfCounters id per module
+    std::vector<Zone> zones;
+    MD_Parola* parola = nullptr;         // animated once per update()
+    std::vector<SensorBus*> sensorBuses;
+    EventBus bus;
+    TimerWheel timers;
     
-    unsigned long lastAutoSwitch = 0;
     const unsigned long AUTO_SWITCH_DELAY = 3000; // 3 seconds after module finishes
 
 public:
-    ModuleManager() {}
+    ModuleManager() : timers(bus) {
+        bus.subscribe(this, EVENT_MASK(EVENT_MODULE_REQUEST));
+    }
     
     ~ModuleManager() {
         for (Module* module : modules) {
             delete module;
         }
+        for (Zone& zone : zones) {
+            delete zone.display;
+        }
     }
     
-    void setDisplay(MD_Parola* P) {
-        display = P;
-        for (Module* module : modules) {
-            module->setDisplay(P);
-        }
+    // Registers MD_Parola zone `zones.size()` spanning the given devices.
+    // Call P->begin(zoneCount) and P->setZone() for each zone first.
+    uint8_t addZone(MD_Parola* P, uint8_t firstDevice, uint8_t lastDevice) {
+        parola = P;
+        uint8_t index = zones.size();
+        zones.push_back({ new DisplayZone(P, index, firstDevice, lastDevice), nullptr, nullptr, 0 });
+        return index;
     }
     
-    void addModule(Module* module) {
-        if (display) {
-            module->setDisplay(display);
+    void addModule(Module* module, uint8_t zoneIndex = 0) {
+        if (zoneIndex >= zones.size()) zoneIndex = 0;
+        if (!zones.empty()) {
+            module->setDisplay(zones[zoneIndex].display);
         }
+        module->setEventBus(&bus);
+        module->setTimerWheel(&timers);
+        bus.subscribe(module, module->getEventMask());
         module->init();
         modules.push_back(module);
+        updateProbes.push_back(PerfCounters::instance().probe("update", module->getName()));
         
-        // First module with shouldStayActive becomes default
-        if (defaultModule == nullptr && module->shouldStayActive()) {
-            defaultModule = module;
+        // First module with shouldStayActive becomes the zone's default
+        Zone* zone = zoneOf(module);
+        if (zone && zone->defaultModule == nullptr && module->shouldStayActive()) {
+            zone->defaultModule = module;
             activateModule(module);
         }
     }
     
+    // Polled every update() ahead of the modules that read its devices
+    void addSensorBus(SensorBus* sensorBus) {
+        sensorBuses.push_back(sensorBus);
+    }
+    
     void update() {
-        // Update active module
-        if (activeModule) {
-            activeModule->update();
+        timers.update();
+        for (SensorBus* sensorBus : sensorBuses) {
+            sensorBus->update();
+        }
+        bus.dispatch();
+        
+        for (Zone& zone : zones) {
+            Module* active = zone.activeModule;
+            if (!active) continue;
+            
+            updateModule(active);
             
             // Check if module finished and should auto-switch
-            if (!activeModule->isActive() && !activeModule->shouldStayActive()) {
-                if (millis() - lastAutoSwitch > AUTO_SWITCH_DELAY) {
-                    switchToDefault();
+            if (!active->isActive() && !active->shouldStayActive()) {
+                if (millis() - zone.lastAutoSwitch > AUTO_SWITCH_DELAY) {
+                    switchToDefault(zone);
                 }
             }
         }
         
         // Update all modules for background tasks
         for (Module* module : modules) {
-            if (module != activeModule) {
-                module->update();
+            if (!isShown(module)) {
+                updateModule(module);
             }
         }
+        
+        // One frame for every zone that is due; MD_Parola times each zone
+        // itself, and modules only read their zone's status
+        if (parola) parola->displayAnimate();
     }
     
-    bool handleWebRequest(String request) {
+    // Milliseconds until a module, timer, sensor, pending event, zone
+    // animation or auto-switch next needs update(); PowerGovernor idles
+    // that long
+    unsigned long getIdleBudget() {
+        if (bus.getPending() > 0) return 0;
+        unsigned long budget = timers.getIdleBudget();
+        for (SensorBus* sensorBus : sensorBuses) {
+            budget = min(budget, sensorBus->getIdleBudget());
+        }
+        
+        for (Zone& zone : zones) {
+            Module* active = zone.activeModule;
+            if (!active) continue;
+            if (zone.display->isAnimating()) return 0;
+            if (!active->isActive() && !active->shouldStayActive()) {
+                unsigned long elapsed = millis() - zone.lastAutoSwitch;
+                if (elapsed > AUTO_SWITCH_DELAY) return 0;
+                budget = min(budget, AUTO_SWITCH_DELAY + 1 - elapsed);
+            }
+        }
+        
+        for (Module* module : modules) {
+            budget = min(budget, module->getIdleBudget());
+            if (budget == 0) break;
+        }
+        return budget;
+    }
+    
+    bool blocksLightSleep() {
+        for (SensorBus* sensorBus : sensorBuses) {
+            if (sensorBus->blocksLightSleep()) return true;
+        }
+        for (Module* module : modules) {
+            if (module->blocksLightSleep()) return true;
+        }
+        return false;
+    }
+    
+    bool handleWebRequest(StrView request, RequestArena& arena) {
         // Try each module to handle the request
         for (Module* module : modules) {
-            if (module->handleWebRequest(request)) {
+            if (module->handleWebRequest(request, arena)) {
                 if (module->isActive()) {
                     activateModule(module);
                 }
@@ -76,91 +159,222 @@ public:
             }
         }
         
-        // Handle module switching
-        if (request.indexOf("/module/") >= 0) {
-            for (Module* module : modules) {
-                String modulePath = "/module/" + String(module->getName());
-                if (request.indexOf(modulePath) >= 0) {
-                    activateModule(module);
-                    return true;
-                }
-            }
+        // Handle module switching, matching the name in place
+        Module* module = switchTarget(request);
+        if (module) {
+            activateModule(module);
+            return true;
         }
         
         return false;
     }
     
-    String generateWebControls() {
-        String controls = "";
+    // True if handleWebRequest() would take request; changes nothing
+    bool acceptsWebRequest(StrView request) {
+        for (Module* module : modules) {
+            if (module->acceptsWebRequest(request)) return true;
+        }
+        return switchTarget(request) != nullptr;
+    }
+    
+    // Applies newline-separated command paths (e.g. "/pomo/set?w=25") in
+    // order within one loop pass, so no update() or other request runs in
+    // between. Every command is checked with acceptsWebRequest() first and
+    // none runs unless all are accepted. A command can still fail when
+    // applied (a full text queue): the batch stops there, partly applied.
+    // Either way failedIndex gets the failing command's index, and the
+    // return value is the number of commands applied.
+    // Each command's scratch is released from arena before the next.
+    int handleBatch(const char* body, RequestArena& arena, int* failedIndex = nullptr) {
+        const size_t requestSize = BATCH_MAX_COMMAND + 16;
+        char* request = (char*)arena.alloc(requestSize);
+        if (failedIndex) *failedIndex = -1;
+        if (!request) {
+            if (failedIndex) *failedIndex = 0;
+            return 0;
+        }
         
-        // Add module selector
-        controls += "<div style=\"border-left: 5px solid #4CAF50;\">";
-        controls += "<h3>📱 Modules</h3>";
+        int failed = forEachCommand(body, request, requestSize, [this](StrView command) {
+            return acceptsWebRequest(command);
+        });
+        if (failed >= 0) {
+            if (failedIndex) *failedIndex = failed;
+            return 0;
+        }
+        
+        int applied = 0;
+        failed = forEachCommand(body, request, requestSize, [this, &arena, &applied](StrView command) {
+            size_t mark = arena.mark();
+            bool handled = handleWebRequest(command, arena);
+            arena.release(mark);
+            if (handled) applied++;
+            return handled;
+        });
+        if (failedIndex) *failedIndex = failed;
+        return applied;
+    }
+    
+    // Streams the module selector and every module's control panel
+    void writeWebControls(Print& out) {
+        out.print("<div style=\"border-left: 5px solid #4CAF50;\"><h3>📱 Modules</h3>");
         
         for (Module* module : modules) {
-            String moduleName = module->getName();
-            controls += "<button onclick=\"sendRequest('/module/" + moduleName + "')\">";
-            if (module == activeModule) {
-                controls += "✓ " + moduleName;
-            } else {
-                controls += moduleName;
-            }
-            controls += "</button>";
+            out.print("<button onclick=\"sendRequest('/module/");
+            out.print(module->getName());
+            out.print("')\">");
+            if (isShown(module)) out.print("✓ ");
+            out.print(module->getName());
+            out.print("</button>");
         }
-        controls += "</div>";
+        out.print("</div>");
         
-        // Add each module's controls
         for (Module* module : modules) {
-            controls += module->getWebControls();
+            module->writeWebControls(out);
         }
-        
-        return controls;
     }
     
-    Module* getActiveModule() {
-        return activeModule;
+    // Module shown in a zone, nullptr if none
+    Module* getActiveModule(uint8_t zoneIndex) {
+        return zoneIndex < zones.size() ? zones[zoneIndex].activeModule : nullptr;
+    }
+    
+    // True if module is the one shown in its zone
+    bool isShown(Module* module) {
+        Zone* zone = zoneOf(module);
+        return zone && zone->activeModule == module;
+    }
+    
+    EventBus& getEventBus() {
+        return bus;
+    }
+    
+    TimerWheel& getTimers() {
+        return timers;
+    }
+    
+    // A module published EVENT_MODULE_REQUEST to be shown in its zone
+    void onEvent(const Event& event) override {
+        for (Module* module : modules) {
+            if (strcmp(event.name, module->getName()) == 0) {
+                activateModule(module);
+                return;
+            }
+        }
+    }
+    
+    uint8_t getZoneCount() const {
+        return zones.size();
     }
     
     const std::vector<Module*>& getModules() const {
         return modules;
     }
     
-    String generateJsonData() {
-        String json = "{\"active\":\"";
-        json += activeModule ? activeModule->getName() : "None";
-        json += "\"";
+    // Full device state, one object per module; used for JSON and CBOR
+    void writeData(FieldWriter& out) {
+        out.beginObject();
+        // "active" is the primary zone's, as before; "zones" has every zone's
+        Module* active = getActiveModule(0);
+        out.writeString("active", active ? active->getName() : "None");
+        out.beginArray("zones");
+        for (Zone& zone : zones) {
+            out.writeString(nullptr, zone.activeModule ? zone.activeModule->getName() : "None");
+        }
+        out.endArray();
         
         for (Module* module : modules) {
-            String data = module->getJsonData();
-            if (data.length() > 0) {
-                json += ",\"";
-                json += module->getName();
-                json += "\":";
-                json += data;
-            }
+            out.beginObject(module->getName());
+            module->writeFields(out);
+            out.endObject();
         }
         
-        json += "}";
-        return json;
+        out.beginObject("events");
+        out.writeInt("pub", bus.getPublished());
+        out.writeInt("del", bus.getDelivered());
+        out.writeInt("drop", bus.getDropped());
+        out.endObject();
+        
+        out.endObject();
     }
 
 private:
-    void activateModule(Module* module) {
-        if (activeModule && activeModule != module) {
-            activeModule->deactivate();
+    // Module named by a /module/<name> request, if any
+    Module* switchTarget(StrView request) {
+        int path = request.indexOf("/module/");
+        if (path < 0) return nullptr;
+        StrView name = request.substring(path + 8);
+        // The whole segment, so "/module/Clockwork" does not pick Clock
+        for (Module* module : modules) {
+            if (!name.startsWith(module->getName())) continue;
+            size_t end = strlen(module->getName());
+            if (end == name.length()) return module;
+            char next = name.data()[end];
+            if (next == ' ' || next == '?' || next == '/') return module;
+        }
+        return nullptr;
+    }
+    
+    // Calls fn with each non-empty line of a batch body, shaped like an
+    // HTTP request line as modules expect, until fn returns false. Returns
+    // the index of that command (or of one too long or not a path), or -1.
+    template <typename F>
+    int forEachCommand(const char* body, char* request, size_t requestSize, F fn) {
+        int index = 0;
+        const char* line = body;
+        while (*line) {
+            const char* end = strchr(line, '\n');
+            size_t len = end ? (size_t)(end - line) : strlen(line);
+            const char* next = end ? end + 1 : line + len;
+            
+            while (len > 0 && (line[len - 1] == '\r' || line[len - 1] == ' ')) len--;
+            if (len > 0) {
+                if (len > BATCH_MAX_COMMAND || line[0] != '/') return index;
+                snprintf(request, requestSize, "GET %.*s HTTP/1.1", (int)len, line);
+                if (!fn(StrView(request))) return index;
+                index++;
+            }
+            line = next;
         }
+        return -1;
+    }
+    
+    Zone* zoneOf(Module* module) {
+        for (Zone& zone : zones) {
+            if (zone.display == module->getDisplay()) return &zone;
+        }
+        return nullptr;
+    }
+    
+    void updateModule(Module* module) {
+#if PERF_ENABLED
+        for (size_t i = 0; i < modules.size(); i++) {
+            if (modules[i] == module) {
+                PerfScope scope(updateProbes[i]);
+                module->update();
+                return;
+            }
+        }
+#endif
+        module->update();
+    }
+    
+    void activateModule(Module* module) {
+        Zone* zone = zoneOf(module);
+        if (!zone) return;
         
-        activeModule = module;
-        if (activeModule) {
-            activeModule->activate();
+        if (zone->activeModule && zone->activeModule != module) {
+            zone->activeModule->deactivate();
         }
         
-        lastAutoSwitch = millis();
+        zone->activeModule = module;
+        module->activate();
+        zone->lastAutoSwitch = millis();
+        bus.publish(EVENT_MODULE_ACTIVATED, SOURCE_NONE, module->getName());
     }
     
-    void switchToDefault() {
-        if (defaultModule && defaultModule != activeModule) {
-            activateModule(defaultModule);
+    void switchToDefault(Zone& zone) {
+        if (zone.defaultModule && zone.defaultModule != zone.activeModule) {
+            activateModule(zone.defaultModule);
         }
     }
 };
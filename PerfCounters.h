@@ -0,0 +1,146 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <Arduino.h>
+#include "FieldWriter.h"
+
+// Always-on microbenchmark counters for the hot paths, read from
+// /api/perf and compared against stored baselines with
+// tools/perf_compare.py.
+//
+// PERF_SCOPE("group", "name") at the top of a block times it with the CPU
+// cycle counter and notes heap still taken when it exits. Allocations
+// freed inside the scope are not seen; counting those needs heap tracing.
+// Probes register on first use and cost two cycle-counter and two
+// free-heap reads per call. Probes past PERF_MAX_PROBES are not counted;
+// each is logged once and /api/perf reports how many as "dropped". Build
+// with PERF_ENABLED 0 to compile them out.
+
+#ifndef PERF_ENABLED
+#define PERF_ENABLED 1
+#endif
+#define PERF_MAX_PROBES 24
+
+class PerfCounters {
+private:
+    struct Probe {
+        const char* group;       // static strings
+        const char* name;
+        uint32_t count;
+        uint64_t totalNs;
+        uint32_t minNs;
+        uint32_t maxNs;
+        int32_t maxHeld;         // most heap still taken when the scope ended
+        uint32_t grew;           // calls that ended with less free heap
+    };
+
+    Probe probes[PERF_MAX_PROBES];
+    uint8_t probeCount = 0;
+    uint8_t dropped = 0;
+
+    PerfCounters() {}
+
+public:
+    static const uint8_t NONE = 0xFF;
+
+    static PerfCounters& instance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    uint8_t probe(const char* group, const char* name) {
+        for (uint8_t i = 0; i < probeCount; i++) {
+            if (probes[i].group == group && probes[i].name == name) return i;
+        }
+        if (probeCount == PERF_MAX_PROBES) {
+            dropped++;
+            Serial.printf("[Perf] No room for probe %s.%s, raise PERF_MAX_PROBES\n", group, name);
+            return NONE;
+        }
+        probes[probeCount].group = group;
+        probes[probeCount].name = name;
+        clear(probes[probeCount]);
+        return probeCount++;
+    }
+
+    void record(uint8_t id, uint32_t cycles, int32_t heapHeld) {
+        if (id >= probeCount) return;
+        Probe& p = probes[id];
+        uint32_t ns = (uint64_t)cycles * 1000 / ESP.getCpuFreqMHz();
+        p.count++;
+        p.totalNs += ns;
+        if (ns < p.minNs) p.minNs = ns;
+        if (ns > p.maxNs) p.maxNs = ns;
+        if (heapHeld > 0) {
+            p.grew++;
+            if (heapHeld > p.maxHeld) p.maxHeld = heapHeld;
+        }
+    }
+
+    void reset() {
+        for (uint8_t i = 0; i < probeCount; i++) clear(probes[i]);
+    }
+
+    // One object per probe, keyed "group.name"
+    void writeFields(FieldWriter& out) {
+        char key[40];
+        out.writeInt("mhz", ESP.getCpuFreqMHz());
+        out.writeInt("heap", ESP.getFreeHeap());
+        out.writeInt("block", ESP.getMaxAllocHeap());   // falls as the heap fragments
+        out.writeInt("dropped", dropped);                // probes without a slot
+        out.beginObject("probes");
+        for (uint8_t i = 0; i < probeCount; i++) {
+            Probe& p = probes[i];
+            if (p.count == 0) continue;
+            snprintf(key, sizeof(key), "%s.%s", p.group, p.name);
+            out.beginObject(key);
+            out.writeInt("n", p.count);
+            out.writeInt("ns", p.totalNs / p.count);
+            out.writeInt("min", p.minNs);
+            out.writeInt("max", p.maxNs);
+            out.writeInt("held", p.maxHeld);
+            out.writeInt("grew", p.grew);
+            out.endObject();
+        }
+        out.endObject();
+    }
+
+private:
+    static void clear(Probe& p) {
+        p.count = 0;
+        p.totalNs = 0;
+        p.minNs = UINT32_MAX;
+        p.maxNs = 0;
+        p.maxHeld = 0;
+        p.grew = 0;
+    }
+};
+
+class PerfScope {
+private:
+    uint8_t id;
+    uint32_t startCycles;
+    uint32_t startHeap;
+
+public:
+    explicit PerfScope(uint8_t probeId)
+        : id(probeId), startCycles(ESP.getCycleCount()), startHeap(ESP.getFreeHeap()) {}
+
+    ~PerfScope() {
+        uint32_t cycles = ESP.getCycleCount() - startCycles;
+        PerfCounters::instance().record(id, cycles, (int32_t)(startHeap - ESP.getFreeHeap()));
+    }
+};
+
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+
+#if PERF_ENABLED
+#define PERF_SCOPE(group, name) \
+    static const uint8_t PERF_CONCAT(perfProbe_, __LINE__) = PerfCounters::instance().probe(group, name); \
+    PerfScope PERF_CONCAT(perfScope_, __LINE__)(PERF_CONCAT(perfProbe_, __LINE__))
+#else
+#define PERF_SCOPE(group, name) do {} while (0)
+#endif
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,473 @@
+#ifndef PMS_SENSOR_H
+#define PMS_SENSOR_H
+
+#include <HardwareSerial.h>
+#include "SensorBus.h"
+#include "SampleRing.h"
+#include "TraceRecorder.h"
+
+#define PMS_FRAME_LEN 32
+#define PMS_BAUD 9600
+#define PMS_POLL_BYTES 32            // UART bytes parsed per transaction
+#define PMS_WARMUP_MS 30000          // upper bound, used if readings never converge
+#define PMS_WARMUP_MIN_MS 6000       // frames before this are always discarded
+#define PMS_CONVERGE_FRAMES 3        // consecutive PM2.5 readings that must agree
+#define PMS_CONVERGE_TOLERANCE 2     // ug/m3 spread allowed (or 10% of reading)
+#define PMS_READ_INTERVAL 2500
+
+// Background sampling: the sensor wakes on its own every sampleInterval,
+// which shrinks while PM2.5 rises or is high and stretches while stable.
+#define PMS_INTERVAL_MIN_MS 60000
+#define PMS_INTERVAL_MAX_MS 900000
+#define PMS_INTERVAL_DEFAULT_MS 300000
+#define PMS_ALERT_PM25 35            // sample fast at or above this level
+#define PMS_RISE_DELTA 5             // ug/m3 increase that counts as rising
+#define PMS_STABLE_DELTA 2           // ug/m3 change that counts as stable
+
+// Laser budget: on-time is earned at this many hours per day, spent while
+// the fan/laser runs, and capped so quiet periods can't bank a long burst.
+#define PMS_LASER_HOURS_PER_DAY 3
+#define PMS_LASER_CREDIT_CAP_MS 600000
+
+// Where one PMSA003 is wired: UART number, its RX/TX pins and the SET pin
+// that puts the fan and laser to sleep
+struct PmsConfig {
+    uint8_t uart;
+    uint8_t rx;
+    uint8_t tx;
+    uint8_t set;
+    const char* label;
+};
+
+// PMSA003 frame search, one byte at a time: 0x42 0x4D, then 30 bytes. After
+// a checksum failure the search resumes just past the failed header, so a
+// real frame starting inside the bad one is still found. tools/trace_replay
+// runs recorded UART bytes through this same code.
+class PmsFrameParser {
+private:
+    uint8_t buffer[PMS_FRAME_LEN];
+    uint8_t length = 0;
+
+public:
+    // Of the last valid frame
+    uint16_t pm1_0 = 0;
+    uint16_t pm2_5 = 0;
+    uint16_t pm10 = 0;
+
+    uint32_t frames = 0;
+    uint32_t checksumFailures = 0;
+    uint32_t skipped = 0;        // bytes discarded looking for a header
+
+    // True when b completes a valid frame
+    bool receive(uint8_t b) {
+        if (length == 0) {
+            if (b == 0x42) buffer[length++] = b;
+            else skipped++;
+            return false;
+        }
+        if (length == 1) {
+            if (b == 0x4D) {
+                buffer[length++] = b;
+            } else if (b == 0x42) {
+                skipped++;
+            } else {
+                skipped += 2;
+                length = 0;
+            }
+            return false;
+        }
+
+        buffer[length++] = b;
+        if (length < PMS_FRAME_LEN) return false;
+        length = 0;
+
+        if (validateChecksum()) {
+            pm1_0 = (buffer[10] << 8) | buffer[11];
+            pm2_5 = (buffer[12] << 8) | buffer[13];
+            pm10  = (buffer[14] << 8) | buffer[15];
+            frames++;
+            return true;
+        }
+
+        checksumFailures++;
+        // 30 bytes can't complete another frame, so this recurses once at most
+        uint8_t rest[PMS_FRAME_LEN - 2];
+        memcpy(rest, buffer + 2, sizeof(rest));
+        for (uint8_t i = 0; i < sizeof(rest); i++) {
+            receive(rest[i]);
+        }
+        return false;
+    }
+
+    // Drops a partial frame
+    void reset() { length = 0; }
+
+private:
+    bool validateChecksum() {
+        PERF_SCOPE("pms", "checksum");
+        uint16_t sum = 0;
+        for (int i = 0; i < PMS_FRAME_LEN - 2; i++) {
+            sum += buffer[i];
+        }
+        uint16_t check = (buffer[PMS_FRAME_LEN - 2] << 8) | buffer[PMS_FRAME_LEN - 1];
+        return sum == check;
+    }
+};
+
+// One PMSA003 with its own sampling schedule and laser budget. Frames are
+// parsed as bytes arrive, at most PMS_POLL_BYTES per transaction, so the
+// loop never waits on the UART; every PMS_READ_INTERVAL the newest valid
+// frame is taken for warm-up convergence or as a sample.
+class PmsSensor : public SensorDevice {
+private:
+    PmsConfig config;
+    HardwareSerial serial;
+    TraceRecorder& trace = TraceRecorder::instance();
+    bool traced;                 // the trace format carries one PMS stream
+
+    bool sensorOn = false;
+    bool warmedUp = false;
+    bool backgroundSession = false;
+    bool held = false;           // kept on while the module is shown
+    bool paused = false;         // no background fan noise during focus sessions
+    unsigned long sensorOnAt = 0;
+    unsigned long sensorOffAt = 0;
+    unsigned long lastRead = 0;
+
+    unsigned long sampleInterval = PMS_INTERVAL_DEFAULT_MS;
+    unsigned long lastSampleAt = 0;
+    unsigned long lastWarmupMs = PMS_WARMUP_MS;
+    unsigned long laserCreditMs = PMS_WARMUP_MS;
+    unsigned long lastCreditUpdate = 0;
+    unsigned long laserOnTotalMs = 0;
+
+    uint16_t convergeReadings[PMS_CONVERGE_FRAMES];
+    uint8_t convergeCount = 0;
+
+    uint16_t pm1_0 = 0;
+    uint16_t pm2_5 = 0;
+    uint16_t pm10 = 0;
+    bool hasLastValues = false;
+    bool sampleReady = false;
+    SampleRing<SENSOR_HISTORY_SIZE> history;   // PM2.5 as last measured, per minute
+    unsigned long lastHistory = 0;
+
+    // Newest valid frame, published to pm* only once warm-up has converged
+    uint16_t raw_pm1_0 = 0;
+    uint16_t raw_pm2_5 = 0;
+    uint16_t raw_pm10 = 0;
+    bool frameReady = false;
+
+    PmsFrameParser parser;
+
+public:
+    explicit PmsSensor(const PmsConfig& cfg) : config(cfg), serial(cfg.uart) {
+        static uint8_t created = 0;
+        traced = created++ == 0;
+    }
+
+    bool begin() override {
+        pinMode(config.set, OUTPUT);
+        digitalWrite(config.set, LOW);
+        serial.begin(PMS_BAUD, SERIAL_8N1, config.rx, config.tx);
+        lastCreditUpdate = millis();
+        // First background sample shortly after boot
+        sensorOffAt = millis() - sampleInterval + PMS_INTERVAL_MIN_MS;
+        Serial.printf("[PMS] %s initialized on UART%d (sleeping)\n", config.label, config.uart);
+        return true;
+    }
+
+    // Keeps the laser budget, wakes the sensor when a background sample is
+    // due and puts it back to sleep once readings have converged
+    void update() override {
+        unsigned long now = millis();
+        updateLaserCredit(now);
+        updateHistory();
+
+        if (!sensorOn) {
+            if (paused) return;
+            if (now - sensorOffAt >= sampleInterval && laserCreditMs >= lastWarmupMs) {
+                backgroundSession = true;
+                wake();
+                Serial.printf("[PMS] %s background sample (interval %lus)\n",
+                              config.label, sampleInterval / 1000);
+            }
+            return;
+        }
+
+        // Bytes that arrived while idle are parsed before the read
+        if (now - lastRead > PMS_READ_INTERVAL && serial.available() == 0) {
+            bool fresh = frameReady;
+            frameReady = false;
+            lastRead = millis();
+            if (traced) trace.flushPending();
+            if (!fresh) {
+                Serial.printf("[PMS] %s: no frame since last read\n", config.label);
+            } else if (warmedUp) {
+                storeSample();
+            } else {
+                checkConvergence();
+            }
+        }
+
+        if (!warmedUp && millis() - sensorOnAt >= PMS_WARMUP_MS) {
+            Serial.printf("[PMS] %s warmup timeout, accepting readings\n", config.label);
+            onConverged();
+        }
+
+        if (warmedUp && backgroundSession && !held) {
+            sleep();
+        }
+    }
+
+    bool transact() override {
+        if (!sensorOn) return false;
+        int avail = serial.available();
+        if (avail <= 0) return false;
+
+        PERF_SCOPE("pms", "read");
+        if (avail > PMS_POLL_BYTES) avail = PMS_POLL_BYTES;
+        while (avail-- > 0) {
+            uint8_t b = serial.read();
+            if (traced) trace.recordSerial(b);
+            receive(b);
+        }
+        return true;
+    }
+
+    unsigned long getIdleBudget() override {
+        unsigned long budget = sessionBudget();
+        if (hasLastValues) budget = min(budget, dueIn(lastHistory, SENSOR_HISTORY_MS));
+        return budget;
+    }
+
+    // Frames arrive while the fan runs; the UART stops in light sleep
+    bool blocksLightSleep() override {
+        return sensorOn;
+    }
+
+    const char* getLabel() override {
+        return config.label;
+    }
+
+    void writeFields(FieldWriter& out) override {
+        writeReadings(out);
+        history.writeArray(out, "hist");
+    }
+
+    void writeReadings(FieldWriter& out) {
+        long next = 0;
+        if (!sensorOn) {
+            unsigned long sinceOff = millis() - sensorOffAt;
+            if (sinceOff < sampleInterval) next = (sampleInterval - sinceOff) / 1000;
+        }
+        out.writeInt("pm1", pm1_0);
+        out.writeInt("pm25", pm2_5);
+        out.writeInt("pm10", pm10);
+        out.writeInt("laser", sensorOn ? 1 : 0);
+        out.writeInt("warm", warmedUp ? 1 : 0);
+        out.writeInt("sec", getWarmupLeft() / 1000);
+        out.writeInt("age", hasLastValues ? (long)(getSampleAge() / 1000) : -1);
+        out.writeInt("next", next);
+        out.writeInt("duty", laserOnTotalMs / 1000);
+    }
+
+    // Keeps the fan on while the readings are on screen; a background
+    // session already running carries on as a foreground one
+    void hold(bool on) {
+        held = on;
+        if (on) {
+            backgroundSession = false;
+            if (!sensorOn) {
+                wake();
+                Serial.printf("[PMS] %s waking up, waiting for readings to settle...\n", config.label);
+            }
+        } else if (sensorOn) {
+            sleep();
+            Serial.printf("[PMS] %s sleeping\n", config.label);
+        }
+    }
+
+    void setPaused(bool on) {
+        paused = on;
+        if (paused && sensorOn && backgroundSession) sleep();
+    }
+
+    // True once per stored sample
+    bool takeSample() {
+        bool fresh = sampleReady;
+        sampleReady = false;
+        return fresh;
+    }
+
+    // Latest converged readings
+    bool hasReading() const { return hasLastValues; }
+    bool isOn() const { return sensorOn; }
+    bool isWarmedUp() const { return warmedUp; }
+    uint16_t getPM1_0() const { return pm1_0; }
+    uint16_t getPM2_5() const { return pm2_5; }
+    uint16_t getPM10() const { return pm10; }
+    unsigned long getSampleAge() const { return millis() - lastSampleAt; }
+    const SampleRing<SENSOR_HISTORY_SIZE>& getHistory() const { return history; }
+
+    unsigned long getWarmupLeft() const {
+        if (!sensorOn || warmedUp) return 0;
+        unsigned long elapsed = millis() - sensorOnAt;
+        return elapsed < PMS_WARMUP_MS ? PMS_WARMUP_MS - elapsed : 0;
+    }
+
+private:
+    // Until the sensor next has a session step to take
+    unsigned long sessionBudget() {
+        if (!sensorOn) {
+            if (paused) return SENSOR_IDLE_FOREVER;
+            unsigned long wait = dueIn(sensorOffAt, sampleInterval);
+            // Due but short of laser credit: sleep until enough is earned
+            if (wait == 0 && laserCreditMs < lastWarmupMs) {
+                wait = (lastWarmupMs - laserCreditMs) * 24 / PMS_LASER_HOURS_PER_DAY;
+            }
+            return wait;
+        }
+        // A frame is 33 ms of bytes at 9600 baud and the UART buffer holds
+        // several, so only bytes already waiting need an immediate pass
+        if (serial.available() > 0) return 0;
+        unsigned long budget = dueIn(lastRead, PMS_READ_INTERVAL + 1);
+        if (!warmedUp) budget = min(budget, dueIn(sensorOnAt, PMS_WARMUP_MS));
+        return budget;
+    }
+
+    // One entry per SENSOR_HISTORY_MS whatever the sampling mode, holding
+    // the newest reading, so the history has the same time axis as the
+    // BME280's: held sessions read every few seconds and background ones
+    // every few minutes
+    void updateHistory() {
+        if (!hasLastValues) return;
+        for (uint16_t i = 0; i < SENSOR_HISTORY_SIZE && millis() - lastHistory >= SENSOR_HISTORY_MS; i++) {
+            lastHistory += SENSOR_HISTORY_MS;
+            addHistory();
+        }
+        // Asleep longer than the whole ring: restart the minute from now
+        if (millis() - lastHistory >= SENSOR_HISTORY_MS) lastHistory = millis();
+    }
+
+    void addHistory() {
+        history.add(pm2_5 > INT16_MAX ? INT16_MAX : pm2_5);
+    }
+
+    void wake() {
+        digitalWrite(config.set, HIGH);
+        sensorOn = true;
+        warmedUp = false;
+        convergeCount = 0;
+        sensorOnAt = millis();
+        lastRead = millis();
+        drainSerial();
+        Serial.printf("[PMS] %s SET pin %d -> HIGH (read back: %d)\n",
+                      config.label, config.set, digitalRead(config.set));
+    }
+
+    void sleep() {
+        digitalWrite(config.set, LOW);
+        sensorOn = false;
+        warmedUp = false;
+        backgroundSession = false;
+        sensorOffAt = millis();
+    }
+
+    void updateLaserCredit(unsigned long now) {
+        unsigned long elapsed = now - lastCreditUpdate;
+        lastCreditUpdate = now;
+
+        unsigned long earned = elapsed * PMS_LASER_HOURS_PER_DAY / 24;
+        laserCreditMs += earned;
+        if (sensorOn) {
+            laserOnTotalMs += elapsed;
+            laserCreditMs = laserCreditMs > elapsed ? laserCreditMs - elapsed : 0;
+        }
+        if (laserCreditMs > PMS_LASER_CREDIT_CAP_MS) laserCreditMs = PMS_LASER_CREDIT_CAP_MS;
+    }
+
+    // Warm-up ends once the last few PM2.5 readings agree, rather than after
+    // a fixed timer; frames in the first PMS_WARMUP_MIN_MS never count.
+    void checkConvergence() {
+        if (millis() - sensorOnAt < PMS_WARMUP_MIN_MS) return;
+
+        convergeReadings[convergeCount % PMS_CONVERGE_FRAMES] = raw_pm2_5;
+        convergeCount++;
+        if (convergeCount < PMS_CONVERGE_FRAMES) return;
+
+        uint16_t lo = convergeReadings[0], hi = convergeReadings[0];
+        for (int i = 1; i < PMS_CONVERGE_FRAMES; i++) {
+            if (convergeReadings[i] < lo) lo = convergeReadings[i];
+            if (convergeReadings[i] > hi) hi = convergeReadings[i];
+        }
+        uint16_t tolerance = hi / 10;
+        if (tolerance < PMS_CONVERGE_TOLERANCE) tolerance = PMS_CONVERGE_TOLERANCE;
+
+        if (hi - lo <= tolerance) {
+            Serial.printf("[PMS] %s converged after %lums\n", config.label, millis() - sensorOnAt);
+            onConverged();
+        }
+    }
+
+    void onConverged() {
+        warmedUp = true;
+        lastWarmupMs = millis() - sensorOnAt;
+        adaptInterval();
+        storeSample();
+    }
+
+    void adaptInterval() {
+        int delta = hasLastValues ? (int)raw_pm2_5 - (int)pm2_5 : 0;
+
+        if (raw_pm2_5 >= PMS_ALERT_PM25 || delta >= PMS_RISE_DELTA) {
+            sampleInterval /= 2;
+        } else if (abs(delta) <= PMS_STABLE_DELTA) {
+            sampleInterval += sampleInterval / 2;
+        }
+
+        if (sampleInterval < PMS_INTERVAL_MIN_MS) sampleInterval = PMS_INTERVAL_MIN_MS;
+        if (sampleInterval > PMS_INTERVAL_MAX_MS) sampleInterval = PMS_INTERVAL_MAX_MS;
+    }
+
+    void storeSample() {
+        pm1_0 = raw_pm1_0;
+        pm2_5 = raw_pm2_5;
+        pm10 = raw_pm10;
+        lastSampleAt = millis();
+        hasLastValues = true;
+        sampleReady = true;
+        // The first reading starts the history; later ones are picked up
+        // by updateHistory() each minute
+        if (history.size() == 0) {
+            addHistory();
+            lastHistory = millis();
+        }
+        Serial.printf("[PMS] %s PM1.0=%d PM2.5=%d PM10=%d\n", config.label, pm1_0, pm2_5, pm10);
+    }
+
+    void drainSerial() {
+        while (serial.available()) {
+            uint8_t b = serial.read();
+            if (traced) trace.recordSerial(b);
+        }
+        if (traced) trace.flushPending();
+        parser.reset();
+        frameReady = false;
+    }
+
+    void receive(uint8_t b) {
+        uint32_t failures = parser.checksumFailures;
+        if (parser.receive(b)) {
+            raw_pm1_0 = parser.pm1_0;
+            raw_pm2_5 = parser.pm2_5;
+            raw_pm10 = parser.pm10;
+            frameReady = true;
+        }
+        if (parser.checksumFailures != failures) {
+            Serial.printf("[PMS] %s checksum failed\n", config.label);
+        }
+    }
+};
+
+#endif // PMS_SENSOR_H
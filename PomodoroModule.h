@@ -2,12 +2,13 @@
 #define POMODORO_MODULE_H
 
 #include "Module.h"
+#include "HtmlTemplate.h"
 
+// Work/break countdown on a TimerWheel timer; the wheel publishes the
+// start, stop and expiry events other modules listen for.
 class PomodoroModule : public Module {
 private:
-    unsigned long endTime = 0;
-    unsigned long duration = 0;
-    bool running = false;
+    TimerId timer = TIMER_NONE;
     bool isWork = true;
     
     int workMin = 30;
@@ -38,23 +39,10 @@ public:
             // Animation done
         }
         
-        if (!running) return;
-        
-        long remaining = endTime - millis();
-        
-        if (remaining <= 0) {
-            running = false;
-            P->displayClear();
-            
-            if (isWork) {
-                P->displayText("BREAK", PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
-            } else {
-                P->displayText("WORK", PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
-            }
-            return;
-        }
+        if (!isRunning()) return;
         
         if (millis() - lastUpdate > 1000) {
+            unsigned long remaining = timers->remaining(timer);
             int mins = remaining / 60000;
             int secs = (remaining % 60000) / 1000;
             sprintf(timeDisplay, "%02d:%02d", mins, secs);
@@ -67,26 +55,35 @@ public:
         return "Pomodoro";
     }
     
-    const char* getWebControls() override {
-        static String html;
-        html = "<div style=\"border-left: 5px solid #FF9800;\">";
-        html += "<h3>🍅 Pomodoro</h3>";
-        html += "<p style=\"margin:5px 0;\"><label>Work: <span id=\"wv\">" + String(workMin) + "</span> min</label><br>";
-        html += "<input type=\"range\" id=\"ws\" min=\"5\" max=\"60\" value=\"" + String(workMin) + "\" ";
-        html += "oninput=\"document.getElementById('wv').textContent=this.value\" ";
-        html += "onchange=\"sendRequest('/pomo/set?w='+this.value)\"></p>";
-        html += "<p style=\"margin:5px 0;\"><label>Break: <span id=\"bv\">" + String(breakMin) + "</span> min</label><br>";
-        html += "<input type=\"range\" id=\"bs\" min=\"1\" max=\"30\" value=\"" + String(breakMin) + "\" ";
-        html += "oninput=\"document.getElementById('bv').textContent=this.value\" ";
-        html += "onchange=\"sendRequest('/pomo/set?b='+this.value)\"></p>";
-        html += "<button class=\"pomo\" onclick=\"sendRequest('/pomo/work')\">Start Work</button>";
-        html += "<button class=\"pomo\" style=\"background:#8BC34A;\" onclick=\"sendRequest('/pomo/break')\">Start Break</button>";
-        html += "<button class=\"stop\" onclick=\"sendRequest('/pomo/stop')\">Stop</button>";
-        html += "</div>";
-        return html.c_str();
+    // The wheel tracks expiry; only the shown countdown needs ticks
+    unsigned long getIdleBudget() override {
+        if (!active || !isRunning()) return MODULE_IDLE_FOREVER;
+        return dueIn(lastUpdate, 1001);
     }
     
-    bool handleWebRequest(String request) override {
+    void writeWebControls(Print& out) override {
+        HTML_TEMPLATE(tpl, R"rawliteral(<div style="border-left: 5px solid #FF9800;">
+<h3>🍅 Pomodoro</h3>
+<p style="margin:5px 0;"><label>Work: <span id="wv">{{0}}</span> min</label><br>
+<input type="range" id="ws" min="5" max="60" value="{{0}}" oninput="document.getElementById('wv').textContent=this.value" onchange="sendRequest('/pomo/set?w='+this.value)"></p>
+<p style="margin:5px 0;"><label>Break: <span id="bv">{{1}}</span> min</label><br>
+<input type="range" id="bs" min="1" max="30" value="{{1}}" oninput="document.getElementById('bv').textContent=this.value" onchange="sendRequest('/pomo/set?b='+this.value)"></p>
+<button class="pomo" onclick="sendRequest('/pomo/work')">Start Work</button>
+<button class="pomo" style="background:#8BC34A;" onclick="sendRequest('/pomo/break')">Start Break</button>
+<button class="stop" onclick="sendRequest('/pomo/stop')">Stop</button>
+</div>)rawliteral");
+
+        tpl.render(out, [this](Print& o, uint8_t slot) {
+            o.print(slot == 0 ? workMin : breakMin);
+        });
+    }
+    
+    bool acceptsWebRequest(StrView request) override {
+        return request.indexOf("/pomo/set") >= 0 || request.indexOf("/pomo/work") >= 0 ||
+               request.indexOf("/pomo/break") >= 0 || request.indexOf("/pomo/stop") >= 0;
+    }
+
+    bool handleWebRequest(StrView request, RequestArena&) override {
         if (request.indexOf("/pomo/set") >= 0) {
             if (request.indexOf("w=") >= 0) {
                 int idx = request.indexOf("w=") + 2;
@@ -108,25 +105,18 @@ public:
         }
         
         if (request.indexOf("/pomo/work") >= 0) {
-            isWork = true;
-            duration = workMin * 60 * 1000UL;
-            endTime = millis() + duration;
-            running = true;
-            activate();
+            startSession(true, workMin);
             return true;
         }
         
         if (request.indexOf("/pomo/break") >= 0) {
-            isWork = false;
-            duration = breakMin * 60 * 1000UL;
-            endTime = millis() + duration;
-            running = true;
-            activate();
+            startSession(false, breakMin);
             return true;
         }
         
         if (request.indexOf("/pomo/stop") >= 0) {
-            running = false;
+            timers->cancel(timer);
+            timer = TIMER_NONE;
             if (active) {
                 P->displayClear();
                 P->displayText("STOP", PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
@@ -138,22 +128,45 @@ public:
     }
     
     bool isRunning() const {
-        return running;
+        return timers && timers->isRunning(timer);
     }
     
-    String getJsonData() override {
-        int mins = 0, secs = 0;
-        if (running) {
-            long remaining = endTime - millis();
-            if (remaining > 0) {
-                mins = remaining / 60000;
-                secs = (remaining % 60000) / 1000;
+    uint32_t getEventMask() override {
+        return EVENT_MASK(EVENT_TIMER_EXPIRED);
+    }
+    
+    void onEvent(const Event& event) override {
+        if (event.source != SOURCE_POMODORO || (TimerId)event.values[1] != timer) return;
+        timer = TIMER_NONE;
+        
+        if (active) {
+            P->displayClear();
+            if (isWork) {
+                P->displayText("BREAK", PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
+            } else {
+                P->displayText("WORK", PA_CENTER, 0, 0, PA_PRINT, PA_NO_EFFECT);
             }
         }
-        String json = "{\"run\":" + String(running ? 1 : 0) + ",\"work\":" + String(isWork ? 1 : 0) +
-                      ",\"min\":" + String(mins) + ",\"sec\":" + String(secs) +
-                      ",\"wm\":" + String(workMin) + ",\"bm\":" + String(breakMin) + "}";
-        return json;
+    }
+    
+    void writeFields(FieldWriter& out) override {
+        unsigned long remaining = isRunning() ? timers->remaining(timer) : 0;
+        int mins = remaining / 60000;
+        int secs = (remaining % 60000) / 1000;
+        out.writeInt("run", isRunning() ? 1 : 0);
+        out.writeInt("work", isWork ? 1 : 0);
+        out.writeInt("min", mins);
+        out.writeInt("sec", secs);
+        out.writeInt("wm", workMin);
+        out.writeInt("bm", breakMin);
+    }
+
+private:
+    void startSession(bool work, int minutes) {
+        timers->cancel(timer);
+        isWork = work;
+        timer = timers->start(work ? "work" : "break", minutes * 60 * 1000UL, 0, SOURCE_POMODORO);
+        activate();
     }
 };
 
@@ -0,0 +1,170 @@
+#ifndef POWER_GOVERNOR_H
+#define POWER_GOVERNOR_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "ModuleManager.h"
+#include "HttpServer.h"
+#include "FieldWriter.h"
+
+#if defined(CONFIG_PM_ENABLE) && defined(CONFIG_FREERTOS_USE_TICKLESS_IDLE)
+#include <esp_pm.h>
+#define POWER_LIGHT_SLEEP 1
+#else
+#define POWER_LIGHT_SLEEP 0
+#endif
+
+// Idles the CPU between deadlines instead of spinning loop().
+//
+// After each pass the governor takes the shortest idle budget declared by
+// the modules, timers and zone animations (ModuleManager::getIdleBudget)
+// and delays until that deadline. delay() hands the core to the FreeRTOS
+// idle task, which clock-gates it; WiFi modem sleep keeps the radio off
+// between DTIM beacons.
+//
+// Two levels, picked by network activity:
+//   fast  an HTTP client is connected or left in the last
+//         POWER_WAKE_HOLD_MS: full clock, idle in POWER_FAST_POLL_MS
+//         slices that watch for new connections and request bytes
+//   slow  otherwise: POWER_IDLE_MHZ, POWER_POLL_MS slices; builds with
+//         power management and tickless idle go on into automatic light
+//         sleep, keeping the WiFi association through DTIM beacons
+// A new connection ends the idle and ramps straight to fast. Light sleep
+// stops the UART, so it is held off while a sensor streams serial data
+// (a PMS with its fan on).
+//
+// tools/power_model.py estimates the current draw and wake latency this
+// gives for typical module schedules.
+
+#ifndef POWER_SAVE_ENABLED
+#define POWER_SAVE_ENABLED 1
+#endif
+#define POWER_FULL_MHZ 240
+#define POWER_IDLE_MHZ 80            // lowest clock WiFi keeps working at
+#define POWER_POLL_MS 10             // connection check interval, slow level
+#define POWER_FAST_POLL_MS 1         // and with clients around
+#define POWER_MIN_IDLE_MS 2          // shorter budgets are spent in the loop
+#define POWER_MAX_IDLE_MS 1000       // re-evaluate at least this often
+#define POWER_WAKE_HOLD_MS 2000      // stay fast after the last client
+
+class PowerGovernor {
+private:
+    ModuleManager& manager;
+    HttpServer& http;
+    WiFiServer& server;
+
+    bool enabled = POWER_SAVE_ENABLED;
+    bool fast = false;
+    bool lightSleep = false;
+    unsigned long lastActivity = 0;
+    unsigned long since = 0;
+
+    unsigned long idleMs = 0;
+    uint32_t idles = 0;
+    uint32_t wakes = 0;          // idles cut short by a client
+    unsigned long maxLate = 0;   // worst overrun of an idle budget
+
+#if POWER_LIGHT_SLEEP
+    esp_pm_lock_handle_t cpuLock = nullptr;
+    esp_pm_lock_handle_t sleepLock = nullptr;
+#endif
+
+public:
+    PowerGovernor(ModuleManager& mgr, HttpServer& httpServer, WiFiServer& wifiServer)
+        : manager(mgr), http(httpServer), server(wifiServer) {}
+
+    void begin() {
+#if POWER_LIGHT_SLEEP
+        esp_pm_config_esp32_t config = { POWER_FULL_MHZ, POWER_IDLE_MHZ, true };
+        esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "busy", &cpuLock);
+        esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "uart", &sleepLock);
+        esp_pm_lock_acquire(sleepLock);
+        if (esp_pm_configure(&config) != ESP_OK) {
+            Serial.println("[Power] esp_pm_configure failed, light sleep off");
+        }
+#endif
+        since = millis();
+        lastActivity = millis();
+        WiFi.setSleep(true);
+        setFast(true);
+        Serial.printf("[Power] Governor %s, idle at %d MHz%s\n", enabled ? "on" : "off",
+                      POWER_IDLE_MHZ, POWER_LIGHT_SLEEP ? " with light sleep" : "");
+    }
+
+    void setEnabled(bool on) {
+        enabled = on;
+        if (!on) setFast(true);
+    }
+
+    bool isEnabled() const { return enabled; }
+
+    // Call at the end of loop() with any deadline the module manager does
+    // not know about (telemetry)
+    void update(unsigned long otherBudget = 0xFFFFFFFFUL) {
+        if (!enabled) return;
+
+        if (http.hasClients()) lastActivity = millis();
+        setFast(millis() - lastActivity < POWER_WAKE_HOLD_MS);
+
+        unsigned long budget = min(manager.getIdleBudget(), otherBudget);
+        if (budget < POWER_MIN_IDLE_MS) return;
+        if (budget > POWER_MAX_IDLE_MS) budget = POWER_MAX_IDLE_MS;
+
+        allowLightSleep(!fast && !manager.blocksLightSleep());
+        unsigned long slice = fast ? POWER_FAST_POLL_MS : POWER_POLL_MS;
+
+        unsigned long start = millis();
+        unsigned long elapsed = 0;
+        while (elapsed < budget) {
+            delay(min(budget - elapsed, slice));
+            elapsed = millis() - start;
+            if (server.hasClient() || (fast && http.hasPendingInput())) {
+                // Picked up by the next http.update()
+                wakes++;
+                lastActivity = millis();
+                setFast(true);
+                break;
+            }
+        }
+
+        idles++;
+        idleMs += elapsed;
+        if (elapsed > budget && elapsed - budget > maxLate) maxLate = elapsed - budget;
+    }
+
+    void writeFields(FieldWriter& out) {
+        unsigned long uptime = millis() - since;
+        out.writeInt("on", enabled ? 1 : 0);
+        out.writeInt("mhz", getCpuFrequencyMhz());
+        out.writeInt("fast", fast ? 1 : 0);
+        out.writeInt("light", lightSleep ? 1 : 0);
+        out.writeInt("idle", uptime ? (uint64_t)idleMs * 100 / uptime : 0);
+        out.writeInt("idles", idles);
+        out.writeInt("wakes", wakes);
+        out.writeInt("late", maxLate);
+        out.writeInt("budget", min(manager.getIdleBudget(), (unsigned long)POWER_MAX_IDLE_MS));
+    }
+
+private:
+    void setFast(bool on) {
+        if (on == fast) return;
+        fast = on;
+#if POWER_LIGHT_SLEEP
+        if (on) esp_pm_lock_acquire(cpuLock);
+        else esp_pm_lock_release(cpuLock);
+#else
+        setCpuFrequencyMhz(on ? POWER_FULL_MHZ : POWER_IDLE_MHZ);
+#endif
+    }
+
+    void allowLightSleep(bool allow) {
+#if POWER_LIGHT_SLEEP
+        if (allow == lightSleep) return;
+        lightSleep = allow;
+        if (allow) esp_pm_lock_release(sleepLock);
+        else esp_pm_lock_acquire(sleepLock);
+#endif
+    }
+};
+
+#endif // POWER_GOVERNOR_H
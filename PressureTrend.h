@@ -0,0 +1,133 @@
+#ifndef PRESSURE_TREND_H
+#define PRESSURE_TREND_H
+
+#include <Arduino.h>
+
+// Rolling 3-hour pressure window with a least-squares trend and a
+// Zambretti short-term forecast.
+//
+// One reading per PRESSURE_SAMPLE_MS is kept as a uint16 count of Pa above
+// PRESSURE_BASE_PA in a fixed ring. The regression needs only Σy and Σx·y
+// (x = position in the window, oldest 0), kept as exact integers: a new
+// sample adds to both, and dropping the oldest shifts every x down by one,
+// which takes Σy off Σx·y. Σx and Σx² depend only on the count, so each
+// sample costs the same few integer operations however full the window is.
+
+#define PRESSURE_SAMPLE_MS 60000UL
+#define PRESSURE_WINDOW_SAMPLES (3 * 3600000UL / PRESSURE_SAMPLE_MS)
+#define PRESSURE_MIN_SAMPLES 30             // trend reported after 30 min
+#define PRESSURE_BASE_PA 50000              // 500-1155 hPa fits a uint16
+#define PRESSURE_STEADY_HPA 1.6f            // 3 h change counted as steady
+
+enum PressureTendency : int8_t {
+    PRESSURE_FALLING = -1,
+    PRESSURE_STEADY = 0,
+    PRESSURE_RISING = 1
+};
+
+class PressureTrend {
+private:
+    uint16_t ring[PRESSURE_WINDOW_SAMPLES];
+    uint16_t oldest = 0;
+    uint16_t count = 0;
+    int64_t sumY = 0;
+    int64_t sumXY = 0;
+    unsigned long lastSample = 0;
+
+public:
+    // True when the next reading should be kept
+    bool isDue() const {
+        return count == 0 || millis() - lastSample >= PRESSURE_SAMPLE_MS;
+    }
+
+    void add(uint32_t pa) {
+        uint16_t y = pa <= PRESSURE_BASE_PA ? 0 :
+                     pa - PRESSURE_BASE_PA > 0xFFFF ? 0xFFFF : pa - PRESSURE_BASE_PA;
+        lastSample = millis();
+
+        if (count == PRESSURE_WINDOW_SAMPLES) {
+            sumY -= ring[oldest];
+            sumXY -= sumY;
+            ring[oldest] = y;
+            oldest = (oldest + 1) % PRESSURE_WINDOW_SAMPLES;
+            sumXY += (int64_t)(count - 1) * y;
+            sumY += y;
+            return;
+        }
+
+        ring[(oldest + count) % PRESSURE_WINDOW_SAMPLES] = y;
+        sumXY += (int64_t)count * y;
+        sumY += y;
+        count++;
+    }
+
+    void clear() {
+        oldest = count = 0;
+        sumY = sumXY = 0;
+    }
+
+    bool isReady() const { return count >= PRESSURE_MIN_SAMPLES; }
+    uint16_t getCount() const { return count; }
+
+    // Least-squares slope as hPa per 3 hours
+    float getTrend() const {
+        if (count < 2) return 0;
+        int64_t n = count;
+        int64_t sx = n * (n - 1) / 2;
+        int64_t sxx = (n - 1) * n * (2 * n - 1) / 6;
+        int64_t num = n * sumXY - sx * sumY;
+        int64_t den = n * sxx - sx * sx;
+        return (float)num / den * (3 * 3600000UL / PRESSURE_SAMPLE_MS) / 100.0f;
+    }
+
+    PressureTendency getTendency() const {
+        float trend = getTrend();
+        if (trend >= PRESSURE_STEADY_HPA) return PRESSURE_RISING;
+        if (trend <= -PRESSURE_STEADY_HPA) return PRESSURE_FALLING;
+        return PRESSURE_STEADY;
+    }
+
+    // Zambretti forecast number 1-32 for a sea-level pressure in hPa:
+    // 1-9 falling, 10-19 steady, 20-32 rising, lower is fairer
+    uint8_t getForecast(float seaLevelHpa) const {
+        int z;
+        switch (getTendency()) {
+            case PRESSURE_FALLING:
+                z = lroundf(127 - 0.12f * seaLevelHpa);
+                return constrain(z, 1, 9);
+            case PRESSURE_RISING:
+                z = lroundf(185 - 0.16f * seaLevelHpa);
+                return constrain(z, 20, 32);
+            default:
+                z = lroundf(144 - 0.13f * seaLevelHpa);
+                return constrain(z, 10, 19);
+        }
+    }
+
+    static const char* tendencyName(PressureTendency tendency) {
+        return tendency == PRESSURE_RISING ? "rising" :
+               tendency == PRESSURE_FALLING ? "falling" : "steady";
+    }
+
+    static const char* forecastText(uint8_t z) {
+        static const char* const TEXT[] = {
+            "Settled fine", "Fine weather", "Fine, becoming less settled",
+            "Fairly fine, showery later", "Showery, becoming more unsettled",
+            "Unsettled, rain later", "Rain at times, worse later",
+            "Rain at times, becoming very unsettled", "Very unsettled, rain",
+            "Settled fine", "Fine weather", "Fine, possibly showers",
+            "Fairly fine, showers likely", "Showery, bright intervals",
+            "Changeable, some rain", "Unsettled, rain at times",
+            "Rain at frequent intervals", "Very unsettled, rain", "Stormy, much rain",
+            "Settled fine", "Fine weather", "Becoming fine", "Fairly fine, improving",
+            "Fairly fine, possibly showers early", "Showery early, improving",
+            "Changeable, mending", "Rather unsettled, clearing later",
+            "Unsettled, probably improving", "Unsettled, short fine intervals",
+            "Very unsettled, finer at times", "Stormy, possibly improving",
+            "Stormy, much rain"
+        };
+        return z >= 1 && z <= 32 ? TEXT[z - 1] : "";
+    }
+};
+
+#endif // PRESSURE_TREND_H
@@ -0,0 +1,163 @@
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <Arduino.h>
+
+// Read-only view of request text: a pointer and a length into the
+// connection's receive buffer or a RequestArena, never copied. The calls
+// mirror the String ones handlers used (indexOf, substring, toInt), so
+// parsing reads the same but no step allocates.
+class StrView {
+private:
+    const char* ptr;
+    size_t len;
+
+public:
+    StrView() : ptr(""), len(0) {}
+    StrView(const char* s) : ptr(s), len(strlen(s)) {}
+    StrView(const char* s, size_t n) : ptr(s), len(n) {}
+
+    const char* data() const { return ptr; }
+    size_t length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+
+    int indexOf(char c, int from = 0) const {
+        for (size_t i = from < 0 ? 0 : from; i < len; i++) {
+            if (ptr[i] == c) return i;
+        }
+        return -1;
+    }
+
+    int indexOf(const char* s, int from = 0) const {
+        size_t n = strlen(s);
+        for (size_t i = from < 0 ? 0 : from; i + n <= len; i++) {
+            if (memcmp(ptr + i, s, n) == 0) return i;
+        }
+        return -1;
+    }
+
+    // Clamped to the view; to < 0 runs to the end, as a -1 from indexOf
+    // did with String::substring
+    StrView substring(int from, int to = -1) const {
+        if (to < 0 || (size_t)to > len) to = len;
+        if (from < 0) from = 0;
+        if (from > to) from = to;
+        return StrView(ptr + from, to - from);
+    }
+
+    bool startsWith(const char* s) const {
+        size_t n = strlen(s);
+        return n <= len && memcmp(ptr, s, n) == 0;
+    }
+
+    bool operator==(const char* s) const {
+        return strlen(s) == len && memcmp(ptr, s, len) == 0;
+    }
+
+    // Leading integer, 0 if there is none, like String::toInt
+    long toInt() const {
+        size_t i = 0;
+        while (i < len && ptr[i] == ' ') i++;
+        bool negative = i < len && ptr[i] == '-';
+        if (i < len && (ptr[i] == '-' || ptr[i] == '+')) i++;
+        long value = 0;
+        for (; i < len && isdigit((unsigned char)ptr[i]); i++) {
+            value = value * 10 + (ptr[i] - '0');
+        }
+        return negative ? -value : value;
+    }
+
+    float toFloat() const {
+        char number[24];
+        copyTo(number, sizeof(number));
+        return strtof(number, nullptr);
+    }
+
+    // NUL-terminated copy into dst, truncated to fit; returns its length
+    size_t copyTo(char* dst, size_t size) const {
+        if (size == 0) return 0;
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, ptr, n);
+        dst[n] = '\0';
+        return n;
+    }
+
+    // Query value of key: "50" for "speed" in "GET /t?msg=hi&speed=50 HTTP/1.1",
+    // empty if the key is absent
+    StrView param(const char* key) const {
+        size_t n = strlen(key);
+        for (int at = indexOf(key); at >= 0; at = indexOf(key, at + 1)) {
+            if (at == 0 || (ptr[at - 1] != '?' && ptr[at - 1] != '&')) continue;
+            if ((size_t)at + n >= len || ptr[at + n] != '=') continue;
+            int start = at + n + 1;
+            int end = indexOf('&', start);
+            if (end < 0) end = indexOf(' ', start);
+            return substring(start, end);
+        }
+        return StrView();
+    }
+};
+
+// Room for a response chunk buffer plus a whole request buffer decoded
+#ifndef REQUEST_ARENA_SIZE
+#define REQUEST_ARENA_SIZE 1280
+#endif
+
+// Scratch memory for one request: the response chunk buffer, decoded
+// parameters, batch command lines. Allocation bumps a pointer and nothing
+// is freed on its own; reset() drops it all in O(1) once the response is
+// out, so request handling stays off the general heap and cannot
+// fragment it.
+class RequestArena {
+private:
+    uint8_t buffer[REQUEST_ARENA_SIZE] __attribute__((aligned(4)));
+    size_t used = 0;
+    size_t peak = 0;
+    uint32_t failures = 0;
+
+public:
+    // nullptr when the arena is full
+    void* alloc(size_t size) {
+        size_t start = (used + 3) & ~(size_t)3;
+        if (start + size > REQUEST_ARENA_SIZE) {
+            failures++;
+            return nullptr;
+        }
+        used = start + size;
+        if (used > peak) peak = used;
+        return buffer + start;
+    }
+
+    // Percent-decodes text into a NUL-terminated copy; nullptr when full
+    char* decode(StrView encoded, size_t* length = nullptr) {
+        char* out = (char*)alloc(encoded.length() + 1);
+        if (!out) return nullptr;
+        const char* src = encoded.data();
+        size_t len = encoded.length();
+        size_t n = 0;
+        for (size_t i = 0; i < len; i++) {
+            if (src[i] == '%' && i + 2 < len && isxdigit(src[i + 1]) && isxdigit(src[i + 2])) {
+                char hex[3] = { src[i + 1], src[i + 2], '\0' };
+                out[n++] = (char)strtol(hex, nullptr, 16);
+                i += 2;
+            } else {
+                out[n++] = src[i];
+            }
+        }
+        out[n] = '\0';
+        if (length) *length = n;
+        return out;
+    }
+
+    // Rewinds to an earlier mark(), dropping what was allocated since
+    size_t mark() const { return used; }
+    void release(size_t mark) { if (mark < used) used = mark; }
+
+    void reset() { used = 0; }
+
+    size_t getUsed() const { return used; }
+    size_t getPeak() const { return peak; }
+    uint32_t getFailures() const { return failures; }
+};
+
+#endif // REQUEST_ARENA_H
@@ -0,0 +1,54 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <Arduino.h>
+#include "FieldWriter.h"
+
+// Recent readings of one sensor channel in a fixed ring, oldest first.
+// Values are scaled integers (0.1 °C, ug/m3) so a sample costs two bytes
+// and the ring never touches the heap.
+
+#define SENSOR_HISTORY_SIZE 60
+#define SENSOR_HISTORY_MS 60000UL    // one history entry per minute
+
+template <uint16_t N>
+class SampleRing {
+private:
+    int16_t values[N];
+    uint16_t oldest = 0;
+    uint16_t count = 0;
+    uint32_t total = 0;
+
+public:
+    void add(int16_t value) {
+        total++;
+        if (count < N) {
+            values[(oldest + count) % N] = value;
+            count++;
+            return;
+        }
+        values[oldest] = value;
+        oldest = (oldest + 1) % N;
+    }
+
+    void clear() { oldest = count = 0; }
+
+    uint16_t size() const { return count; }
+    // Readings ever added; lets readers tell how many are new since they looked
+    uint32_t getTotal() const { return total; }
+    static uint16_t capacity() { return N; }
+
+    // 0 is the oldest reading
+    int16_t operator[](uint16_t i) const { return values[(oldest + i) % N]; }
+    int16_t newest() const { return count ? values[(oldest + count - 1) % N] : 0; }
+
+    void writeArray(FieldWriter& out, const char* key) const {
+        out.beginArray(key);
+        for (uint16_t i = 0; i < count; i++) {
+            out.writeInt(nullptr, (*this)[i]);
+        }
+        out.endArray();
+    }
+};
+
+#endif // SAMPLE_RING_H
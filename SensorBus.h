@@ -0,0 +1,103 @@
+#ifndef SENSOR_BUS_H
+#define SENSOR_BUS_H
+
+#include <Arduino.h>
+#include "FieldWriter.h"
+#include "PerfCounters.h"
+
+#define SENSOR_BUS_MAX_DEVICES 8
+#define SENSOR_IDLE_FOREVER 0xFFFFFFFFUL
+
+// One physical sensor. A read is split into short bus transactions so
+// several sensors can share an I2C bus or the loop without any one of them
+// holding it for a whole measurement.
+class SensorDevice {
+public:
+    virtual ~SensorDevice() {}
+
+    virtual bool begin() = 0;
+
+    // Timekeeping without bus traffic; runs for every device every pass
+    virtual void update() {}
+
+    // One bounded transaction if the device has one due; true if the bus
+    // was used
+    virtual bool transact() = 0;
+
+    // Milliseconds until update() or transact() next has work
+    virtual unsigned long getIdleBudget() { return 0; }
+    virtual bool blocksLightSleep() { return false; }
+
+    // Instance name in JSON and SENSOR_SAMPLE events, e.g. "indoor"
+    virtual const char* getLabel() = 0;
+    virtual void writeFields(FieldWriter& out) {}
+
+protected:
+    static unsigned long dueIn(unsigned long since, unsigned long interval) {
+        unsigned long elapsed = millis() - since;
+        return elapsed >= interval ? 0 : interval - elapsed;
+    }
+};
+
+// Polls the devices sharing one bus. Each update() runs every device's
+// bookkeeping, then hands the bus to a single device with a transaction
+// due, starting after the one served last, so a slow or busy sensor
+// cannot starve the others and a pass never waits on more than one
+// transaction.
+class SensorBus {
+private:
+    const char* name;
+    SensorDevice* devices[SENSOR_BUS_MAX_DEVICES];
+    uint8_t count = 0;
+    uint8_t next = 0;
+    uint32_t transactions = 0;
+
+public:
+    explicit SensorBus(const char* busName) : name(busName) {}
+
+    bool add(SensorDevice* device) {
+        if (count == SENSOR_BUS_MAX_DEVICES) {
+            Serial.printf("[Sensors] %s full, %s not polled\n", name, device->getLabel());
+            return false;
+        }
+        devices[count++] = device;
+        return true;
+    }
+
+    void update() {
+        if (count == 0) return;
+        PERF_SCOPE("sensors", "poll");
+        for (uint8_t i = 0; i < count; i++) {
+            devices[i]->update();
+        }
+        for (uint8_t n = 0; n < count; n++) {
+            uint8_t i = (next + n) % count;
+            if (devices[i]->transact()) {
+                next = (i + 1) % count;
+                transactions++;
+                return;
+            }
+        }
+    }
+
+    unsigned long getIdleBudget() {
+        unsigned long budget = SENSOR_IDLE_FOREVER;
+        for (uint8_t i = 0; i < count && budget > 0; i++) {
+            budget = min(budget, devices[i]->getIdleBudget());
+        }
+        return budget;
+    }
+
+    bool blocksLightSleep() {
+        for (uint8_t i = 0; i < count; i++) {
+            if (devices[i]->blocksLightSleep()) return true;
+        }
+        return false;
+    }
+
+    const char* getName() const { return name; }
+    uint8_t getCount() const { return count; }
+    uint32_t getTransactions() const { return transactions; }
+};
+
+#endif // SENSOR_BUS_H
@@ -0,0 +1,106 @@
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <Arduino.h>
+#include "SampleRing.h"
+#include "DisplayZone.h"
+#include "PerfCounters.h"
+
+// Bar graph of a SampleRing, one matrix column per reading, for
+// DisplayZone::drawColumns.
+//
+// Columns are rendered once, when their reading arrives, into a ring
+// stored twice over so the newest N are always contiguous: a new reading
+// writes one column byte into both copies and nothing else moves. The 8
+// rows cover a band of base + 8 * step; a reading outside it re-centres
+// the band on the ring's range and re-renders every column, which is the
+// only time the graph is redrawn from scratch.
+
+#define SPARKLINE_ROWS 8
+
+template <uint16_t N>
+class Sparkline {
+private:
+    uint8_t columns[2 * N];
+    uint16_t next = 0;           // slot the next column goes in
+    uint16_t count = 0;
+    uint32_t seen = 0;           // ring readings already rendered
+    const int16_t minStep;       // finest value change one row shows
+    int32_t base = 0;
+    int32_t step;
+    uint32_t rebuilds = 0;
+
+public:
+    explicit Sparkline(int16_t minimumStep) : minStep(minimumStep), step(minimumStep) {}
+
+    // Renders readings added to ring since the last call; true if the
+    // graph changed
+    bool update(const SampleRing<N>& ring) {
+        uint32_t added = ring.getTotal() - seen;
+        if (added == 0) return false;
+        PERF_SCOPE("spark", "update");
+        seen = ring.getTotal();
+        // Missed readings or a cleared ring: start over
+        bool inStep = added == 1 && ring.size() == (count < N ? count + 1 : N);
+        if (!inStep || !inBand(ring.newest())) {
+            rebuild(ring);
+        } else {
+            push(columnFor(ring.newest()));
+        }
+        return true;
+    }
+
+    // Newest reading at the right edge; older ones run off the left
+    void draw(DisplayZone* zone) const {
+        zone->drawColumns(getColumns(), count, (int16_t)count - (int16_t)zone->getColumnCount());
+    }
+
+    // Oldest first
+    const uint8_t* getColumns() const { return columns + next + N - count; }
+    uint16_t getCount() const { return count; }
+    uint32_t getRebuilds() const { return rebuilds; }
+
+    // Bar from the bottom row (bit 7, as in the font glyphs) up to the
+    // reading's row
+    uint8_t columnFor(int16_t value) const {
+        int32_t row = ((int32_t)value - base) / step;
+        if (row < 0) row = 0;
+        if (row >= SPARKLINE_ROWS) row = SPARKLINE_ROWS - 1;
+        return (uint8_t)(0xFF << (SPARKLINE_ROWS - 1 - row));
+    }
+
+private:
+    bool inBand(int16_t value) const {
+        return value >= base && value < base + SPARKLINE_ROWS * step;
+    }
+
+    void push(uint8_t column) {
+        columns[next] = column;
+        columns[next + N] = column;
+        next = (next + 1) % N;
+        if (count < N) count++;
+    }
+
+    void rebuild(const SampleRing<N>& ring) {
+        rebuilds++;
+        next = count = 0;
+        if (ring.size() == 0) return;
+
+        int16_t lo = ring[0], hi = ring[0];
+        for (uint16_t i = 1; i < ring.size(); i++) {
+            if (ring[i] < lo) lo = ring[i];
+            if (ring[i] > hi) hi = ring[i];
+        }
+        int32_t span = (int32_t)hi - lo + 1;
+        step = (span + SPARKLINE_ROWS - 1) / SPARKLINE_ROWS;
+        if (step < minStep) step = minStep;
+        // Centre the range so small moves either way stay in band
+        base = lo - (SPARKLINE_ROWS * step - span) / 2;
+
+        for (uint16_t i = 0; i < ring.size(); i++) {
+            push(columnFor(ring[i]));
+        }
+    }
+};
+
+#endif // SPARKLINE_H
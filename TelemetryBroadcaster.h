@@ -0,0 +1,160 @@
+#ifndef TELEMETRY_BROADCASTER_H
+#define TELEMETRY_BROADCASTER_H
+
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <time.h>
+#include "ModuleManager.h"
+#include "BME280Module.h"
+#include "AirQualityModule.h"
+
+// Defaults; override in config.h
+#ifndef TELEMETRY_ENABLED
+#define TELEMETRY_ENABLED 0
+#endif
+#ifndef TELEMETRY_GROUP
+#define TELEMETRY_GROUP "239.12.34.56"
+#endif
+#ifndef TELEMETRY_PORT
+#define TELEMETRY_PORT 4210
+#endif
+#ifndef TELEMETRY_INTERVAL_MS
+#define TELEMETRY_INTERVAL_MS 5000
+#endif
+#define TELEMETRY_PUSH_GAP_MS 1000   // min spacing of event-driven packets
+
+#define TELEMETRY_MAGIC 0x4B53     // "SK" on the wire
+#define TELEMETRY_VERSION 1
+
+#define TELEMETRY_FLAG_BME_OK   0x01
+#define TELEMETRY_FLAG_PM_VALID 0x02
+#define TELEMETRY_FLAG_PMS_ON   0x04
+
+// Fixed 34-byte datagram, little-endian, no padding. Any layout change
+// must bump TELEMETRY_VERSION; tools/telemetry_collector.py mirrors it.
+struct __attribute__((packed)) TelemetryPacket {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t activeModule;      // index into ModuleManager of zone 0's, 0xFF if none
+    uint32_t sequence;
+    uint32_t unixTime;         // 0 until NTP has synced
+    uint32_t uptimeMs;
+    int16_t temperature;       // 0.01 C
+    uint16_t humidity;         // 0.01 %
+    uint32_t pressure;         // Pa
+    uint16_t pm1_0;            // ug/m3
+    uint16_t pm2_5;
+    uint16_t pm10;
+    uint16_t pmAge;            // seconds since the PM sample, saturates at 0xFFFF
+    uint8_t flags;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(TelemetryPacket) == 34, "TelemetryPacket layout changed");
+
+// Multicasts one TelemetryPacket every TELEMETRY_INTERVAL_MS, built from
+// the modules' current state. Collectors join the group instead of polling
+// each clock over HTTP. New sensor samples and module switches arriving on
+// the event bus push a packet early, at most every TELEMETRY_PUSH_GAP_MS.
+class TelemetryBroadcaster : public EventListener {
+private:
+    WiFiUDP udp;
+    IPAddress group;
+    ModuleManager& manager;
+    BME280Module* weather = nullptr;
+    AirQualityModule* airQuality = nullptr;
+
+    bool enabled = TELEMETRY_ENABLED;
+    unsigned long interval = TELEMETRY_INTERVAL_MS;
+    unsigned long lastSend = 0;
+    uint32_t sequence = 0;
+    bool pushPending = false;
+
+public:
+    explicit TelemetryBroadcaster(ModuleManager& mgr) : manager(mgr) {}
+
+    void begin(BME280Module* bme, AirQualityModule* aqi) {
+        weather = bme;
+        airQuality = aqi;
+        group.fromString(TELEMETRY_GROUP);
+        manager.getEventBus().subscribe(this, EVENT_MASK(EVENT_SENSOR_SAMPLE) |
+                                              EVENT_MASK(EVENT_MODULE_ACTIVATED));
+        if (enabled) {
+            Serial.printf("Telemetry -> %s:%d every %lums\n", TELEMETRY_GROUP, TELEMETRY_PORT, interval);
+        }
+    }
+
+    void update() {
+        if (!enabled || WiFi.status() != WL_CONNECTED) return;
+        unsigned long elapsed = millis() - lastSend;
+        if (elapsed < interval && !(pushPending && elapsed >= TELEMETRY_PUSH_GAP_MS)) return;
+        lastSend = millis();
+        pushPending = false;
+        send();
+    }
+
+    void onEvent(const Event& event) override {
+        pushPending = true;
+    }
+
+    // Milliseconds until the next packet is due
+    unsigned long getIdleBudget() const {
+        if (!enabled || WiFi.status() != WL_CONNECTED) return 0xFFFFFFFFUL;
+        unsigned long elapsed = millis() - lastSend;
+        unsigned long due = pushPending ? TELEMETRY_PUSH_GAP_MS : interval;
+        return elapsed >= due ? 0 : due - elapsed;
+    }
+
+    void setEnabled(bool on) { enabled = on; }
+    void setInterval(unsigned long ms) { interval = ms < 100 ? 100 : ms; }
+    bool isEnabled() const { return enabled; }
+    unsigned long getInterval() const { return interval; }
+
+    void send() {
+        TelemetryPacket pkt;
+        memset(&pkt, 0, sizeof(pkt));
+        fill(pkt);
+
+        udp.beginPacket(group, TELEMETRY_PORT);
+        udp.write((const uint8_t*)&pkt, sizeof(pkt));
+        udp.endPacket();
+    }
+
+private:
+    void fill(TelemetryPacket& pkt) {
+        pkt.magic = TELEMETRY_MAGIC;
+        pkt.version = TELEMETRY_VERSION;
+        pkt.sequence = sequence++;
+        pkt.uptimeMs = millis();
+
+        time_t now = time(nullptr);
+        pkt.unixTime = now > 1600000000 ? (uint32_t)now : 0;
+
+        pkt.activeModule = 0xFF;
+        const std::vector<Module*>& modules = manager.getModules();
+        for (size_t i = 0; i < modules.size(); i++) {
+            if (modules[i] == manager.getActiveModule(0)) pkt.activeModule = i;
+        }
+
+        if (weather && weather->isSensorReady()) {
+            pkt.flags |= TELEMETRY_FLAG_BME_OK;
+            pkt.temperature = (int16_t)lroundf(weather->getTemperature() * 100);
+            pkt.humidity = (uint16_t)lroundf(weather->getHumidity() * 100);
+            pkt.pressure = (uint32_t)lroundf(weather->getPressure() * 100);
+        }
+
+        if (airQuality) {
+            if (airQuality->isSensorOn()) pkt.flags |= TELEMETRY_FLAG_PMS_ON;
+            if (airQuality->hasReading()) {
+                pkt.flags |= TELEMETRY_FLAG_PM_VALID;
+                pkt.pm1_0 = airQuality->getPM1_0();
+                pkt.pm2_5 = airQuality->getPM2_5();
+                pkt.pm10 = airQuality->getPM10();
+                unsigned long age = airQuality->getSampleAge() / 1000;
+                pkt.pmAge = age > 0xFFFF ? 0xFFFF : age;
+            }
+        }
+    }
+};
+
+#endif // TELEMETRY_BROADCASTER_H
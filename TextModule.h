@@ -3,14 +3,59 @@
 
 #include "Module.h"
 
+// Scrolls an alert when PM2.5 rises through this level (µg/m³); re-arms
+// once it falls TEXT_ALERT_HYSTERESIS below
+#ifndef TEXT_ALERT_PM25
+#define TEXT_ALERT_PM25 55
+#endif
+#define TEXT_ALERT_HYSTERESIS 5
+
+#define TEXT_QUEUE_SIZE 8
+#define TEXT_ARENA_SIZE 1024        // message texts, NUL-terminated, packed
+#define TEXT_LENGTH_MAX 400         // longer messages are rejected
+#define TEXT_GLYPH_COLUMNS_MAX 8    // widest font glyph, before the gap
+// Rendered bitmap of the current message, room for the longest one
+#define TEXT_COLUMNS_MAX (TEXT_LENGTH_MAX * (TEXT_GLYPH_COLUMNS_MAX + 1))
+#define TEXT_MAX_REPEATS 20
+
+#define TEXT_PRIORITY_NORMAL 0
+#define TEXT_PRIORITY_TIMER 5
+#define TEXT_PRIORITY_ALERT 9
+
+// Message queue with priorities and repeat counts. Texts live back to back
+// in a fixed arena. The head message is rasterized once into a column
+// bitmap when it reaches the head; each frame, and each repeat, then only
+// copies a window of that bitmap to the zone.
+//
+// queue[0] is the message scrolling, or the last one shown so it can be
+// replayed. Newer messages wait behind it by priority, FIFO within a
+// priority, and never cut a scroll short.
 class TextModule : public Module {
 private:
-    char textMessage[255];
+    struct Message {
+        uint16_t offset;      // into arena
+        uint16_t length;      // without the NUL
+        uint16_t speed;       // ms per column
+        uint8_t priority;
+        uint8_t repeats;      // passes left
+    };
+
+    Message queue[TEXT_QUEUE_SIZE];
+    uint8_t count = 0;
+    char arena[TEXT_ARENA_SIZE];
+    uint16_t arenaUsed = 0;
+
+    uint8_t columns[TEXT_COLUMNS_MAX];
+    uint16_t width = 0;
+    bool rendered = false;          // columns hold queue[0]
+    int16_t scrollPos = 0;
+    unsigned long lastStep = 0;
     bool scrolling = false;
+    bool pmAlertRaised = false;
 
 public:
     TextModule() {
-        strcpy(textMessage, "Welcome!");
+        show("Welcome!");
     }
     
     void init() override {
@@ -19,9 +64,13 @@ public:
     
     void activate() override {
         active = true;
-        scrolling = true;
-        P->displayClear();
-        P->displayText(textMessage, PA_CENTER, 50, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+        if (scrolling) return;
+
+        // Drop the finished head if others wait, otherwise replay it
+        if (count > 1 && queue[0].repeats == 0) remove(0);
+        if (count > 0 && queue[0].repeats == 0) queue[0].repeats = 1;
+        startScroll();
+        if (!scrolling) active = false;
     }
     
     void deactivate() override {
@@ -31,9 +80,21 @@ public:
     
     void update() override {
         if (!active || !scrolling) return;
+        if (millis() - lastStep < queue[0].speed) return;
+        lastStep = millis();
         
-        if (P->displayAnimate()) {
-            // Animation complete, can deactivate or repeat
+        {
+            PERF_SCOPE("text", "frame");
+            P->drawColumns(columns, width, scrollPos);
+        }
+        if (++scrollPos <= (int16_t)width) return;
+
+        // Pass complete: repeat, move on to the next message, or stop
+        if (queue[0].repeats > 0) queue[0].repeats--;
+        if (queue[0].repeats == 0 && count > 1) remove(0);
+        if (queue[0].repeats > 0) {
+            startScroll();
+        } else {
             scrolling = false;
             active = false; // Auto-deactivate after scroll
         }
@@ -43,65 +104,195 @@ public:
         return "TextScroll";
     }
     
+    unsigned long getIdleBudget() override {
+        if (!active || !scrolling) return MODULE_IDLE_FOREVER;
+        return dueIn(lastStep, queue[0].speed);
+    }
+
     const char* getWebControls() override {
         return R"rawliteral(
         <div style="border-left: 5px solid #9C27B0;">
             <h3>💬 Text Scroll</h3>
-            <input type="text" id="textMsg" placeholder="Enter message..." maxlength="250">
+            <input type="text" id="textMsg" placeholder="Enter message..." maxlength="400">
             <select id="textSpeed">
                 <option value="25">Slow</option>
                 <option value="50" selected>Normal</option>
                 <option value="75">Fast</option>
                 <option value="100">Very Fast</option>
             </select>
-            <button onclick="sendRequest('/text/show?msg=' + encodeURIComponent(document.getElementById('textMsg').value) + '&speed=' + document.getElementById('textSpeed').value)">Scroll Text</button>
+            <select id="textRep">
+                <option value="1" selected>Once</option>
+                <option value="3">3x</option>
+                <option value="10">10x</option>
+            </select>
+            <label><input type="checkbox" id="textPri"> Urgent</label>
+            <button onclick="sendRequest('/text/show?msg=' + encodeURIComponent(document.getElementById('textMsg').value) + '&speed=' + document.getElementById('textSpeed').value + '&rep=' + document.getElementById('textRep').value + '&pri=' + (document.getElementById('textPri').checked ? 8 : 0))">Scroll Text</button>
             <button onclick="sendRequest('/text/show?msg=Hello%20World!&speed=50')">Test Message</button>
         </div>
         )rawliteral";
     }
     
-    bool handleWebRequest(String request) override {
-        if (request.indexOf("/text/show") >= 0) {
+    // Whether the message then fits the queue is only known when it is
+    // applied
+    bool acceptsWebRequest(StrView request) override {
+        return request.indexOf("/text/show") >= 0 && request.indexOf("msg=") >= 0;
+    }
+
+    // /text/show?msg=...&speed=50&pri=0..9&rep=1..20
+    bool handleWebRequest(StrView request, RequestArena& arena) override {
+        if (acceptsWebRequest(request)) {
             int start = request.indexOf("msg=") + 4;
             int end = request.indexOf("&", start);
             if (end == -1) end = request.indexOf(" ", start);
             
-            String msg = request.substring(start, end);
-            msg.replace("%20", " ");
-            msg.replace("%21", "!");
-            msg.replace("%3F", "?");
-            msg.toCharArray(textMessage, 255);
+            int speed = intParam(request, "speed=", 50);
+            int priority = constrain(intParam(request, "pri=", TEXT_PRIORITY_NORMAL), 0, 9);
+            int repeats = constrain(intParam(request, "rep=", 1), 1, TEXT_MAX_REPEATS);
             
-            // Get speed if specified
-            int speed = 50; // default
-            if (request.indexOf("speed=") >= 0) {
-                int speedStart = request.indexOf("speed=") + 6;
-                int speedEnd = request.indexOf("&", speedStart);
-                if (speedEnd == -1) speedEnd = request.indexOf(" ", speedStart);
-                speed = request.substring(speedStart, speedEnd).toInt();
-            }
+            size_t length;
+            char* text = urlDecode(request.substring(start, end), arena, &length);
+            if (!text || !enqueue(text, length, speed, priority, repeats)) return false;
             
-            displayText(speed);
+            activate();
             return true;
         }
         
         return false;
     }
     
-    void setText(const char* text) {
-        strncpy(textMessage, text, 254);
-        textMessage[254] = '\0';
+    // Queues a message; false if it does not fit even after dropping
+    // lower-priority ones
+    bool show(const char* text, int speed = 50, uint8_t priority = TEXT_PRIORITY_NORMAL, uint8_t repeats = 1) {
+        return enqueue(text, strlen(text), speed, priority, repeats);
+    }
+    
+    void writeFields(FieldWriter& out) override {
+        out.writeString("msg", getCurrentText());
+        out.writeInt("run", scrolling ? 1 : 0);
+        out.writeInt("queued", count > 0 ? count - 1 : 0);
+        out.writeInt("arena", arenaUsed);
+    }
+    
+    uint32_t getEventMask() override {
+        return EVENT_MASK(EVENT_SENSOR_SAMPLE) | EVENT_MASK(EVENT_TIMER_EXPIRED);
     }
     
-    void displayText(int speed = 50) {
-        activate();
-        P->displayClear();
-        P->displayText(textMessage, PA_CENTER, speed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+    void onEvent(const Event& event) override {
+        // User timers and reminders from /api/timers scroll their name
+        if (event.topic == EVENT_TIMER_EXPIRED) {
+            if (event.source != SOURCE_TIMER) return;
+            show(event.name[0] ? event.name : "TIMER", 50, TEXT_PRIORITY_TIMER, 3);
+            publish(EVENT_MODULE_REQUEST, SOURCE_NONE, getName());
+            return;
+        }
+        
+        if (event.source != SOURCE_PMS) return;
+        float pm25 = event.values[1];
+        
+        if (!pmAlertRaised && pm25 >= TEXT_ALERT_PM25) {
+            pmAlertRaised = true;
+            char alert[32];
+            snprintf(alert, sizeof(alert), "PM2.5 HIGH: %d ug/m3", (int)pm25);
+            show(alert, 50, TEXT_PRIORITY_ALERT, 2);
+            // Manager shows us on dispatch; activate() starts the scroll
+            publish(EVENT_MODULE_REQUEST, SOURCE_NONE, getName());
+        } else if (pmAlertRaised && pm25 < TEXT_ALERT_PM25 - TEXT_ALERT_HYSTERESIS) {
+            pmAlertRaised = false;
+        }
     }
     
     const char* getCurrentText() const {
-        return textMessage;
+        return count > 0 ? arena + queue[0].offset : "";
+    }
+
+private:
+    bool enqueue(const char* text, size_t length, int speed, uint8_t priority, uint8_t repeats) {
+        if (length > TEXT_LENGTH_MAX) {
+            Serial.printf("[Text] Message of %u chars rejected, max %u\n",
+                          (unsigned)length, TEXT_LENGTH_MAX);
+            return false;
+        }
+
+        // Make room by dropping the newest waiting message of lower
+        // priority; a finished head may go too, a scrolling one never
+        while (count == TEXT_QUEUE_SIZE || arenaUsed + length + 1 > TEXT_ARENA_SIZE) {
+            uint8_t victim = count - 1;
+            if (victim == 0 && !scrolling && (queue[0].repeats == 0 || queue[0].priority < priority)) {
+                remove(0);
+                continue;
+            }
+            if (victim == 0 || queue[victim].priority >= priority) {
+                Serial.println("[Text] Queue full, message dropped");
+                return false;
+            }
+            remove(victim);
+        }
+
+        Message m;
+        m.offset = arenaUsed;
+        m.length = length;
+        m.speed = speed > 0 ? speed : 50;
+        m.priority = priority;
+        m.repeats = repeats > 0 ? repeats : 1;
+        memcpy(arena + arenaUsed, text, length);
+        arena[arenaUsed + length] = '\0';
+        arenaUsed += length + 1;
+
+        // Behind the head and every message of equal or higher priority
+        uint8_t pos = count;
+        while (pos > 1 && queue[pos - 1].priority < priority) {
+            queue[pos] = queue[pos - 1];
+            pos--;
+        }
+        queue[pos] = m;
+        if (pos == 0) rendered = false;
+        count++;
+        return true;
+    }
+
+    // Removes a message and closes its gap in the arena
+    void remove(uint8_t index) {
+        uint16_t offset = queue[index].offset;
+        uint16_t size = queue[index].length + 1;
+        memmove(arena + offset, arena + offset + size, arenaUsed - offset - size);
+        arenaUsed -= size;
+
+        for (uint8_t i = index; i + 1 < count; i++) queue[i] = queue[i + 1];
+        if (index == 0) rendered = false;
+        count--;
+        for (uint8_t i = 0; i < count; i++) {
+            if (queue[i].offset > offset) queue[i].offset -= size;
+        }
+    }
+
+    void startScroll() {
+        if (count == 0) {
+            scrolling = false;
+            return;
+        }
+        if (!scrolling) P->release();
+
+        // A repeat or replay scrolls the bitmap it already has
+        if (!rendered) {
+            width = P->renderText(arena + queue[0].offset, columns, TEXT_COLUMNS_MAX);
+            rendered = true;
+        }
+        scrollPos = -(int16_t)P->getColumnCount();
+        lastStep = 0;
+        scrolling = true;
+    }
+
+    static int intParam(StrView request, const char* key, int fallback) {
+        int idx = request.indexOf(key);
+        if (idx < 0) return fallback;
+        return request.substring(idx + strlen(key)).toInt();
+    }
+
+    // Percent-decoded copy of the message in the request arena
+    static char* urlDecode(StrView encoded, RequestArena& arena, size_t* length) {
+        PERF_SCOPE("text", "decode");
+        return arena.decode(encoded, length);
     }
 };
 
-#endif // TEXT_MODULE_H
\ No newline at end of file
+#endif // TEXT_MODULE_H
@@ -0,0 +1,388 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <Arduino.h>
+#include <time.h>
+#include "EventBus.h"
+#include "FieldWriter.h"
+#include "RequestArena.h"
+
+// Named countdowns, repeating alarms and wall-clock reminders on a
+// hierarchical timing wheel.
+//
+// Time is kept as a 32-bit count of TIMER_TICK_MS ticks, advanced from
+// millis() deltas, and deadlines are compared by signed difference, so
+// neither the millis() rollover at 49.7 days nor the tick rollover
+// matters. Level L of the wheel holds timers due in [64^L, 64^(L+1))
+// ticks; a slot is cascaded to the level below when the tick reaches it.
+// Insert and cancel unlink from a doubly linked slot list (O(1)); each
+// timer is touched at most once per level before it fires. Timers live in
+// a fixed pool, so nothing is allocated at runtime. A bitmap per level
+// marks the occupied slots, so the idle budget is found from the next
+// occupied slot of each level without visiting any timer.
+//
+// Expiry, start and cancel are published on the event bus as
+// EVENT_TIMER_EXPIRED/STARTED/STOPPED with the timer's source, a copy of
+// its name and its id in values[1].
+
+#ifndef TIMER_MAX
+#define TIMER_MAX 24
+#endif
+#define TIMER_TICK_MS 10
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS 4                 // 2^24 ticks = 46.6 h in range
+#define TIMER_NAME_LEN 16
+#define TIMER_MAX_DELAY_MS (7UL * 24 * 3600 * 1000)
+
+// Pool index in the low 16 bits, a reuse counter above it, so a stale id
+// never matches a newer timer. Fits a float event value exactly.
+typedef uint32_t TimerId;
+#define TIMER_NONE 0
+
+enum TimerKind : uint8_t {
+    TIMER_ONESHOT,
+    TIMER_REPEAT,
+    TIMER_REMINDER       // wall-clock time of day, optionally daily
+};
+
+class TimerWheel {
+private:
+    static const uint16_t NIL = 0xFFFF;
+    static const uint32_t SECONDS_PER_DAY = 24UL * 3600;
+
+    struct Timer {
+        uint32_t expires;        // tick
+        uint32_t period;         // ticks; 0 = one-shot
+        uint16_t next;
+        uint16_t prev;
+        uint16_t bucket;         // level * TIMER_WHEEL_SLOTS + slot, NIL if not queued
+        uint8_t generation;
+        TimerKind kind;
+        EventSource source;
+        bool daily;
+        uint16_t minuteOfDay;    // reminders
+        char name[TIMER_NAME_LEN];
+    };
+
+    Timer pool[TIMER_MAX];
+    uint16_t heads[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t occupied[TIMER_WHEEL_LEVELS] = {};   // bit per non-empty slot
+    uint16_t freeList = 0;
+    uint16_t activeCount = 0;
+
+    uint32_t tick = 0;
+    uint32_t lastMillis = 0;     // 32-bit like the ESP32's millis(), so deltas wrap with it
+    EventBus& bus;
+
+    uint32_t fired = 0;
+
+public:
+    explicit TimerWheel(EventBus& eventBus) : bus(eventBus) {
+        for (uint8_t l = 0; l < TIMER_WHEEL_LEVELS; l++) {
+            for (uint8_t s = 0; s < TIMER_WHEEL_SLOTS; s++) heads[l][s] = NIL;
+        }
+        for (uint16_t i = 0; i < TIMER_MAX; i++) {
+            pool[i].next = i + 1 < TIMER_MAX ? i + 1 : NIL;
+            pool[i].bucket = NIL;
+            pool[i].generation = 1;
+        }
+        lastMillis = millis();
+    }
+
+    // Fires after delayMs, then every periodMs if non-zero
+    TimerId start(const char* name, unsigned long delayMs, unsigned long periodMs = 0,
+                  EventSource source = SOURCE_TIMER) {
+        if (delayMs > TIMER_MAX_DELAY_MS || periodMs > TIMER_MAX_DELAY_MS) return TIMER_NONE;
+        uint16_t i = allocate(name, periodMs ? TIMER_REPEAT : TIMER_ONESHOT, source);
+        if (i == NIL) return TIMER_NONE;
+
+        pool[i].period = toTicks(periodMs);
+        schedule(i, tick + toTicks(delayMs));
+        bus.publish(EVENT_TIMER_STARTED, source, pool[i].name, delayMs, idOf(i));
+        return idOf(i);
+    }
+
+    // Fires at the next hour:minute local time; needs NTP time
+    TimerId startReminder(const char* name, uint8_t hour, uint8_t minute, bool daily,
+                          EventSource source = SOURCE_TIMER) {
+        if (hour > 23 || minute > 59) return TIMER_NONE;
+        long seconds = secondsUntil(hour * 60 + minute);
+        if (seconds < 0) return TIMER_NONE;
+        uint16_t i = allocate(name, TIMER_REMINDER, source);
+        if (i == NIL) return TIMER_NONE;
+
+        pool[i].daily = daily;
+        pool[i].minuteOfDay = hour * 60 + minute;
+        schedule(i, tick + toTicks(seconds * 1000UL));
+        bus.publish(EVENT_TIMER_STARTED, source, pool[i].name, seconds * 1000.0f, idOf(i));
+        return idOf(i);
+    }
+
+    bool cancel(TimerId id) {
+        uint16_t i = indexOf(id);
+        if (i == NIL) return false;
+        bus.publish(EVENT_TIMER_STOPPED, pool[i].source, pool[i].name, 0, id);
+        unlink(i);
+        release(i);
+        return true;
+    }
+
+    bool isRunning(TimerId id) const {
+        return indexOf(id) != NIL;
+    }
+
+    // Milliseconds until the timer fires, 0 if it is not running
+    unsigned long remaining(TimerId id) const {
+        uint16_t i = indexOf(id);
+        if (i == NIL) return 0;
+        int32_t ticks = (int32_t)(pool[i].expires - tick);
+        long ms = (long)ticks * TIMER_TICK_MS - (long)((uint32_t)millis() - lastMillis);
+        return ms > 0 ? ms : 0;
+    }
+
+    // Called once per loop; catches up on every tick since the last call
+    void update() {
+        uint32_t now = millis();
+        uint32_t steps = (now - lastMillis) / TIMER_TICK_MS;
+        if (steps == 0) return;
+        lastMillis += steps * TIMER_TICK_MS;
+
+        if (activeCount == 0) {
+            tick += steps;
+            return;
+        }
+        while (steps--) step();
+    }
+
+    // Milliseconds until the loop must next call update(), so it can idle
+    // until then. Exact when a timer is due within TIMER_WHEEL_SLOTS
+    // ticks; otherwise when the next occupied slot above cascades, which
+    // is never later than the timers in it.
+    unsigned long getIdleBudget() const {
+        if (activeCount == 0) return 0xFFFFFFFFUL;
+        uint32_t soonest = UINT32_MAX;
+        for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+            if (!occupied[level]) continue;
+            // Slots come due in order from the one after the current one;
+            // the current one itself holds the next revolution
+            uint8_t shift = TIMER_WHEEL_BITS * level;
+            uint32_t current = tick >> shift;
+            uint8_t from = (current + 1) & (TIMER_WHEEL_SLOTS - 1);
+            uint64_t bits = occupied[level];
+            if (from) bits = (bits >> from) | (bits << (TIMER_WHEEL_SLOTS - from));
+            uint32_t ahead = __builtin_ctzll(bits);
+            uint32_t ticks = ((current + 1 + ahead) << shift) - tick;
+            if (ticks < soonest) soonest = ticks;
+        }
+        long ms = (long)soonest * TIMER_TICK_MS - (long)((uint32_t)millis() - lastMillis);
+        return ms > 0 ? ms : 0;
+    }
+
+    uint16_t getActiveCount() const { return activeCount; }
+    uint32_t getFired() const { return fired; }
+
+    // Handles /api/timers/add and /api/timers/cancel:
+    //   /api/timers/add?name=tea&in=300           one-shot, seconds
+    //   /api/timers/add?name=stretch&in=1800&every=1800
+    //   /api/timers/add?name=standup&at=09:30&daily=1
+    //   /api/timers/cancel?id=65537
+    bool handleWebRequest(StrView request, RequestArena& arena) {
+        if (request.indexOf("/api/timers/cancel") >= 0) {
+            char id[12];
+            request.param("id").copyTo(id, sizeof(id));
+            return cancel(strtoul(id, nullptr, 10));
+        }
+
+        if (request.indexOf("/api/timers/add") >= 0) {
+            StrView encoded = request.param("name");
+            const char* name = encoded.isEmpty() ? "TIMER" : arena.decode(encoded);
+            if (!name) return false;
+
+            StrView at = request.param("at");
+            if (!at.isEmpty()) {
+                int colon = at.indexOf("%3A") >= 0 ? at.indexOf("%3A") + 3 : at.indexOf(':') + 1;
+                if (colon <= 0) return false;
+                return startReminder(name, at.toInt(), at.substring(colon).toInt(),
+                                     request.param("daily") == "1") != TIMER_NONE;
+            }
+
+            StrView in = request.param("in");
+            if (in.isEmpty()) return false;
+            return start(name, in.toInt() * 1000UL, request.param("every").toInt() * 1000UL) != TIMER_NONE;
+        }
+
+        return request.indexOf("/api/timers") >= 0;
+    }
+
+    // One object per timer, keyed by id
+    void writeFields(FieldWriter& out) {
+        char key[12];
+        for (uint16_t i = 0; i < TIMER_MAX; i++) {
+            if (pool[i].bucket == NIL) continue;
+            snprintf(key, sizeof(key), "%lu", (unsigned long)idOf(i));
+            out.beginObject(key);
+            out.writeString("name", pool[i].name);
+            out.writeString("kind", pool[i].kind == TIMER_REMINDER ? "at" :
+                                    pool[i].kind == TIMER_REPEAT ? "every" : "once");
+            out.writeInt("left", remaining(idOf(i)) / 1000);
+            out.writeInt("every", pool[i].kind == TIMER_REMINDER ? (pool[i].daily ? SECONDS_PER_DAY : 0)
+                                                                 : pool[i].period * TIMER_TICK_MS / 1000);
+            out.writeInt("src", pool[i].source);
+            out.endObject();
+        }
+    }
+
+private:
+    // At least one tick, so a new deadline is never the slot just handled
+    static uint32_t toTicks(unsigned long ms) {
+        uint32_t ticks = (ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+        return ticks ? ticks : 1;
+    }
+
+    TimerId idOf(uint16_t i) const {
+        return ((TimerId)pool[i].generation << 16) | i;
+    }
+
+    uint16_t indexOf(TimerId id) const {
+        uint16_t i = id & 0xFFFF;
+        if (i >= TIMER_MAX || pool[i].bucket == NIL) return NIL;
+        return pool[i].generation == (id >> 16) ? i : NIL;
+    }
+
+    uint16_t allocate(const char* name, TimerKind kind, EventSource source) {
+        if (freeList == NIL) {
+            Serial.println("[Timer] Pool full");
+            return NIL;
+        }
+        uint16_t i = freeList;
+        freeList = pool[i].next;
+
+        Timer& t = pool[i];
+        strncpy(t.name, name, TIMER_NAME_LEN - 1);
+        t.name[TIMER_NAME_LEN - 1] = '\0';
+        t.kind = kind;
+        t.source = source;
+        t.period = 0;
+        t.daily = false;
+        t.minuteOfDay = 0;
+        activeCount++;
+        return i;
+    }
+
+    void release(uint16_t i) {
+        pool[i].bucket = NIL;
+        pool[i].generation = pool[i].generation == 0xFF ? 1 : pool[i].generation + 1;
+        pool[i].next = freeList;
+        freeList = i;
+        activeCount--;
+    }
+
+    void schedule(uint16_t i, uint32_t expires) {
+        Timer& t = pool[i];
+        t.expires = expires;
+
+        int32_t delta = (int32_t)(expires - tick);
+        uint8_t level = 0;
+        uint8_t slot;
+        if (delta <= 0) {
+            // Due now (only while cascading) or overdue: next tick
+            slot = (delta == 0 ? tick : tick + 1) & (TIMER_WHEEL_SLOTS - 1);
+        } else {
+            while (level < TIMER_WHEEL_LEVELS - 1 &&
+                   (uint32_t)delta >= (1UL << (TIMER_WHEEL_BITS * (level + 1)))) {
+                level++;
+            }
+            if ((uint32_t)delta >= (1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))) {
+                // Beyond the wheel: park in the top slot visited last and
+                // re-place it when that slot cascades
+                slot = ((tick >> (TIMER_WHEEL_BITS * level)) - 1) & (TIMER_WHEEL_SLOTS - 1);
+            } else {
+                slot = (expires >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1);
+            }
+        }
+
+        uint16_t& head = heads[level][slot];
+        t.bucket = level * TIMER_WHEEL_SLOTS + slot;
+        t.prev = NIL;
+        t.next = head;
+        if (head != NIL) pool[head].prev = i;
+        head = i;
+        occupied[level] |= 1ULL << slot;
+    }
+
+    void unlink(uint16_t i) {
+        Timer& t = pool[i];
+        if (t.prev != NIL) {
+            pool[t.prev].next = t.next;
+        } else {
+            uint8_t level = t.bucket / TIMER_WHEEL_SLOTS;
+            uint8_t slot = t.bucket % TIMER_WHEEL_SLOTS;
+            heads[level][slot] = t.next;
+            if (t.next == NIL) occupied[level] &= ~(1ULL << slot);
+        }
+        if (t.next != NIL) pool[t.next].prev = t.prev;
+    }
+
+    void step() {
+        tick++;
+
+        // Cascade every level whose lower levels all wrapped this tick,
+        // highest first so moved timers land in slots handled next
+        uint8_t top = 0;
+        while (top < TIMER_WHEEL_LEVELS - 1 &&
+               ((tick >> (TIMER_WHEEL_BITS * top)) & (TIMER_WHEEL_SLOTS - 1)) == 0) {
+            top++;
+        }
+        for (uint8_t level = top; level > 0; level--) {
+            uint8_t slot = (tick >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1);
+            uint16_t i = heads[level][slot];
+            heads[level][slot] = NIL;
+            occupied[level] &= ~(1ULL << slot);
+            while (i != NIL) {
+                uint16_t next = pool[i].next;
+                schedule(i, pool[i].expires);
+                i = next;
+            }
+        }
+
+        uint8_t slot = tick & (TIMER_WHEEL_SLOTS - 1);
+        uint16_t i = heads[0][slot];
+        heads[0][slot] = NIL;
+        occupied[0] &= ~(1ULL << slot);
+        while (i != NIL) {
+            uint16_t next = pool[i].next;
+            expire(i);
+            i = next;
+        }
+    }
+
+    void expire(uint16_t i) {
+        Timer& t = pool[i];
+        fired++;
+        bus.publish(EVENT_TIMER_EXPIRED, t.source, t.name, 0, idOf(i));
+
+        if (t.kind == TIMER_REPEAT) {
+            schedule(i, t.expires + t.period);
+        } else if (t.kind == TIMER_REMINDER && t.daily) {
+            // Re-derive from the wall clock so NTP corrections and DST apply
+            long seconds = secondsUntil(t.minuteOfDay);
+            schedule(i, tick + toTicks((seconds > 0 ? seconds : SECONDS_PER_DAY) * 1000UL));
+        } else {
+            release(i);
+        }
+    }
+
+    // Seconds from now until the next occurrence of minuteOfDay, local
+    // time; -1 while the clock is not set
+    static long secondsUntil(uint16_t minuteOfDay) {
+        struct tm now;
+        if (!getLocalTime(&now, 0)) return -1;
+        long current = now.tm_hour * 3600L + now.tm_min * 60 + now.tm_sec;
+        long seconds = minuteOfDay * 60L - current;
+        if (seconds <= 0) seconds += SECONDS_PER_DAY;
+        return seconds;
+    }
+};
+
+#endif // TIMER_WHEEL_H
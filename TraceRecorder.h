@@ -0,0 +1,179 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include "FieldWriter.h"
+
+// Field capture of sensor input and HTTP traffic into a compact binary
+// trace, for replay on the desk with tools/trace_replay.cpp.
+//
+// Layout, little-endian:
+//   header  "SKTR" u16 version, u16 reserved, u32 millis() at start
+//   record  u8 type, varint ms since the previous record, varint length,
+//           payload
+//
+// Capture stops when the buffer is full rather than wrapping, so a trace
+// always starts at its header and replays deterministically. Idle cost is
+// one branch per hook; the buffer is only allocated while a trace exists.
+
+#define TRACE_BUFFER_SIZE 32768
+#define TRACE_MAGIC "SKTR"
+#define TRACE_VERSION 1
+#define TRACE_PENDING_SIZE 64
+
+enum TraceType : uint8_t {
+    TRACE_PMS_RX = 1,        // bytes consumed from the PMS UART
+    TRACE_BME_READ = 2,      // float32 temperature C, humidity %, pressure hPa
+    TRACE_HTTP_REQUEST = 3,  // request line, NUL, body
+    TRACE_HTTP_TIME = 4,     // u32 microseconds spent handling the request
+    TRACE_MARK = 5           // free text
+};
+
+class TraceRecorder {
+private:
+    uint8_t* buffer = nullptr;
+    size_t used = 0;
+    bool capturing = false;
+    bool truncated = false;
+    unsigned long lastMillis = 0;
+    uint32_t records = 0;
+
+    // UART bytes waiting to become one TRACE_PMS_RX record
+    uint8_t pending[TRACE_PENDING_SIZE];
+    uint8_t pendingLen = 0;
+    unsigned long pendingAt = 0;
+
+public:
+    static TraceRecorder& instance() {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    bool start() {
+        if (!buffer) buffer = (uint8_t*)malloc(TRACE_BUFFER_SIZE);
+        if (!buffer) {
+            Serial.println("[Trace] No memory for trace buffer");
+            return false;
+        }
+        lastMillis = millis();
+        uint32_t start = lastMillis;
+        memcpy(buffer, TRACE_MAGIC, 4);
+        buffer[4] = TRACE_VERSION;
+        buffer[5] = 0;
+        buffer[6] = 0;
+        buffer[7] = 0;
+        memcpy(buffer + 8, &start, 4);
+        used = 12;
+        records = 0;
+        pendingLen = 0;
+        truncated = false;
+        capturing = true;
+        Serial.printf("[Trace] Capturing into %u bytes\n", TRACE_BUFFER_SIZE);
+        return true;
+    }
+
+    void stop() {
+        if (!capturing) return;
+        flushPending();
+        capturing = false;
+        Serial.printf("[Trace] Stopped: %u records, %u bytes\n", (unsigned)records, (unsigned)used);
+    }
+
+    // Frees the buffer; the trace is lost
+    void clear() {
+        stop();
+        free(buffer);
+        buffer = nullptr;
+        used = 0;
+    }
+
+    bool isCapturing() const { return capturing; }
+
+    void record(TraceType type, const void* data, size_t len) {
+        if (!capturing) return;
+        flushPending();
+        append(type, millis(), (const uint8_t*)data, len, nullptr, 0);
+    }
+
+    // Bytes read from the PMS UART; consecutive calls share one record
+    void recordSerial(const uint8_t* data, size_t len) {
+        if (!capturing) return;
+        while (len--) {
+            if (pendingLen == TRACE_PENDING_SIZE) flushPending();
+            if (pendingLen == 0) pendingAt = millis();
+            pending[pendingLen++] = *data++;
+        }
+    }
+
+    void recordSerial(uint8_t b) {
+        recordSerial(&b, 1);
+    }
+
+    void flushPending() {
+        if (!pendingLen) return;
+        uint8_t len = pendingLen;
+        pendingLen = 0;
+        append(TRACE_PMS_RX, pendingAt, pending, len, nullptr, 0);
+    }
+
+    void recordRequest(const char* line, const char* body, size_t bodyLength) {
+        if (!capturing) return;
+        flushPending();
+        append(TRACE_HTTP_REQUEST, millis(), (const uint8_t*)line, strlen(line) + 1,
+               (const uint8_t*)body, bodyLength);
+    }
+
+    void recordTime(TraceType type, uint32_t micros) {
+        record(type, &micros, sizeof(micros));
+    }
+
+    const uint8_t* getData() const { return buffer; }
+    size_t getSize() const { return buffer ? used : 0; }
+
+    void writeFields(FieldWriter& out) {
+        out.writeInt("on", capturing ? 1 : 0);
+        out.writeInt("bytes", getSize());
+        out.writeInt("records", records);
+        out.writeInt("full", truncated ? 1 : 0);
+        out.writeInt("cap", TRACE_BUFFER_SIZE);
+    }
+
+private:
+    TraceRecorder() {}
+
+    void append(TraceType type, unsigned long at, const uint8_t* a, size_t aLen,
+                const uint8_t* b, size_t bLen) {
+        size_t len = aLen + bLen;
+        if (used + 1 + 5 + 5 + len > TRACE_BUFFER_SIZE) {
+            truncated = true;
+            capturing = false;
+            Serial.println("[Trace] Buffer full, capture stopped");
+            return;
+        }
+
+        // Records are written in call order; a coalesced UART record may
+        // carry an earlier timestamp than the previous record
+        long delta = (long)(at - lastMillis);
+        if (delta < 0) delta = 0;
+        lastMillis += delta;
+
+        buffer[used++] = type;
+        writeVarint(delta);
+        writeVarint(len);
+        memcpy(buffer + used, a, aLen);
+        used += aLen;
+        if (bLen) memcpy(buffer + used, b, bLen);
+        used += bLen;
+        records++;
+    }
+
+    void writeVarint(uint32_t v) {
+        while (v >= 0x80) {
+            buffer[used++] = (v & 0x7F) | 0x80;
+            v >>= 7;
+        }
+        buffer[used++] = v;
+    }
+};
+
+#endif // TRACE_RECORDER_H
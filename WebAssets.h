@@ -0,0 +1,270 @@
+// Generated by tools/build_web_assets.py from web/ - do not edit.
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+// index.html: 13553 bytes raw, 12331 minified, 4112 gzipped
+constexpr const char INDEX_HTML_TYPE[] = "text/html; charset=UTF-8";
+constexpr uint8_t INDEX_HTML_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x3b, 0x6b, 0x73, 0xdb, 0x36,
+    0xb6, 0xdf, 0xf3, 0x2b, 0x58, 0x65, 0x53, 0x4a, 0xd7, 0x22, 0x45, 0x52, 0x96, 0x2d, 0x53, 0x96,
+    0x7d, 0x5b, 0x37, 0xb9, 0x9b, 0x99, 0x66, 0x9b, 0xad, 0x93, 0xed, 0xec, 0x78, 0x3d, 0x3b, 0x14,
+    0x09, 0x4a, 0x4c, 0x48, 0x82, 0x21, 0x40, 0xc9, 0x8e, 0xa2, 0xff, 0xbe, 0xe7, 0x00, 0x24, 0xc5,
+    0x97, 0x14, 0xbb, 0xb3, 0x1f, 0x6e, 0x3b, 0x55, 0x04, 0xe0, 0xe0, 0xbc, 0x9f, 0x50, 0x7a, 0xf9,
+    0xc3, 0x2f, 0xbf, 0xdd, 0x7c, 0xf8, 0xe7, 0xfb, 0xd7, 0xca, 0x8a, 0x47, 0xe1, 0xd5, 0x25, 0x7e,
+    0x2a, 0xa1, 0x13, 0x2f, 0xe7, 0x3d, 0x12, 0xf7, 0x60, 0x4d, 0x1c, 0xef, 0xea, 0x32, 0x22, 0xdc,
+    0x51, 0xdc, 0x95, 0x93, 0x32, 0xc2, 0xe7, 0xbd, 0x8f, 0x1f, 0xde, 0x68, 0xd3, 0x5e, 0xbe, 0x1b,
+    0x3b, 0x11, 0x99, 0xf7, 0xd6, 0x01, 0xd9, 0x24, 0x34, 0xe5, 0x3d, 0xc5, 0xa5, 0x31, 0x27, 0x31,
+    0x40, 0x6d, 0x02, 0x8f, 0xaf, 0xe6, 0x1e, 0x59, 0x07, 0x2e, 0xd1, 0xc4, 0x62, 0x18, 0xc4, 0x01,
+    0x0f, 0x9c, 0x50, 0x63, 0xae, 0x13, 0x92, 0xb9, 0x39, 0x8c, 0x9c, 0x87, 0x20, 0xca, 0xa2, 0x62,
+    0x0d, 0x28, 0x79, 0xc0, 0x43, 0x72, 0x75, 0x1b, 0x39, 0x29, 0xbf, 0x09, 0xa9, 0xfb, 0xf9, 0x72,
+    0x24, 0x77, 0x2e, 0x19, 0x7f, 0x84, 0x3f, 0xfe, 0x67, 0xbb, 0xa0, 0x0f, 0x1a, 0x0b, 0xbe, 0x06,
+    0xf1, 0xd2, 0x5e, 0xd0, 0xd4, 0x23, 0xa9, 0x06, 0x3b, 0x33, 0x80, 0x5f, 0x06, 0xb1, 0x6d, 0xcc,
+    0x12, 0xc7, 0xf3, 0xf0, 0xcc, 0xd8, 0xd9, 0x29, 0xa5, 0x7c, 0xab, 0x69, 0x8b, 0xa5, 0xfd, 0xd2,
+    0xf0, 0x4c, 0xd3, 0x3c, 0x9f, 0x69, 0x1a, 0x33, 0xed, 0x97, 0xe6, 0x99, 0xb9, 0xb0, 0x2c, 0x5c,
+    0x58, 0xb0, 0x70, 0x2d, 0xd3, 0x9a, 0xc2, 0x62, 0xe1, 0xd9, 0x2f, 0xc7, 0xc6, 0xf8, 0x6c, 0xec,
+    0xc1, 0x82, 0x03, 0x18, 0x39, 0x23, 0x9e, 0x3f, 0xc6, 0x05, 0x80, 0x4d, 0x17, 0x17, 0xa7, 0x17,
+    0x04, 0x17, 0x63, 0xfb, 0xe5, 0xe9, 0xf4, 0xd4, 0x9f, 0xe0, 0x1d, 0xc7, 0x75, 0xed, 0x97, 0x93,
+    0xa9, 0x73, 0xe6, 0xfb, 0xb0, 0x5a, 0xa6, 0x31, 0xa0, 0xf0, 0x17, 0x17, 0x13, 0x03, 0x56, 0x29,
+    0x01, 0x84, 0xfe, 0x74, 0x62, 0x9e, 0x5e, 0xc0, 0x8a, 0xa6, 0xc0, 0x85, 0x67, 0x5d, 0x5c, 0x08,
+    0xc2, 0x49, 0x96, 0xda, 0x2f, 0x17, 0xee, 0xd4, 0xf5, 0xfd, 0xdd, 0x82, 0x7a, 0x8f, 0x5b, 0x1f,
+    0x74, 0xa6, 0xf9, 0x4e, 0x14, 0x84, 0x8f, 0xb6, 0xe6, 0x24, 0x49, 0x48, 0x34, 0xf6, 0xc8, 0x38,
+    0x89, 0x86, 0xea, 0x2d, 0x59, 0x52, 0xa2, 0x7c, 0x7c, 0xab, 0x0e, 0x7f, 0xa7, 0x0b, 0xca, 0xe9,
+    0x90, 0x39, 0x31, 0xd3, 0x18, 0x49, 0x03, 0x7f, 0xb6, 0x70, 0xdc, 0xcf, 0xcb, 0x94, 0x66, 0xb1,
+    0x67, 0xaf, 0x9d, 0xb4, 0x8f, 0xb2, 0x0e, 0x66, 0x2e, 0x0d, 0x69, 0x9a, 0xaf, 0xb9, 0x39, 0x98,
+    0x45, 0x41, 0xac, 0xad, 0x48, 0xb0, 0x5c, 0x71, 0xdb, 0x34, 0x8c, 0xf5, 0x6a, 0xa7, 0x6f, 0x52,
+    0x27, 0xd9, 0x82, 0xea, 0xa5, 0x51, 0xec, 0x89, 0x65, 0x24, 0x7b, 0x0d, 0x2a, 0x4e, 0xc6, 0x69,
+    0xa9, 0x46, 0xf3, 0x2c, 0x79, 0x50, 0xcc, 0x53, 0xf8, 0x18, 0x5b, 0xc9, 0xc3, 0x0e, 0x9d, 0x81,
+    0xa4, 0x5b, 0x4e, 0x1e, 0xb8, 0xe6, 0x84, 0xc1, 0x32, 0xb6, 0x5d, 0x30, 0x35, 0x49, 0xeb, 0xf0,
+    0x86, 0x62, 0xee, 0x81, 0x95, 0x95, 0x29, 0xc5, 0x03, 0xa3, 0x11, 0x5b, 0x90, 0x12, 0xcb, 0x8d,
+    0x64, 0xe9, 0xcc, 0x30, 0x66, 0x21, 0xe1, 0x80, 0x43, 0x63, 0x89, 0xe3, 0x22, 0x0e, 0x4d, 0x1f,
+    0xef, 0x6f, 0xeb, 0x8c, 0x6f, 0xbd, 0x80, 0x25, 0xa1, 0xf3, 0x68, 0x07, 0x71, 0x18, 0xc4, 0x44,
+    0xf3, 0x43, 0xf2, 0x30, 0x13, 0xd4, 0xb5, 0x00, 0x54, 0xc4, 0x0a, 0x1e, 0x96, 0x4e, 0x62, 0x9f,
+    0x15, 0xe8, 0x05, 0x35, 0x64, 0xa3, 0xae, 0x0f, 0x6b, 0x90, 0x0b, 0xaa, 0x71, 0x2a, 0xa0, 0x4b,
+    0x3a, 0x49, 0x90, 0x6c, 0xa5, 0x3e, 0xce, 0xe1, 0x52, 0xae, 0x30, 0xfc, 0x9a, 0x7b, 0x59, 0xea,
+    0x78, 0x41, 0xc6, 0xec, 0x89, 0xf1, 0xaa, 0xad, 0x76, 0xb0, 0xf5, 0x60, 0xc6, 0x53, 0x30, 0x0c,
+    0xb8, 0x37, 0x8d, 0x6d, 0x7d, 0xcc, 0xaa, 0x78, 0x75, 0x1a, 0x6f, 0x5b, 0x77, 0xc0, 0x5b, 0x06,
+    0x33, 0xe1, 0xcc, 0x2b, 0xc7, 0xa3, 0x1b, 0x50, 0xbc, 0xa1, 0xa0, 0xf2, 0xf6, 0xa7, 0x3b, 0x9d,
+    0x3b, 0x0b, 0x56, 0x4a, 0x2f, 0xc4, 0x46, 0x19, 0x4f, 0xf7, 0x4c, 0x81, 0x43, 0x70, 0x1a, 0xd9,
+    0x26, 0xdc, 0x63, 0x34, 0x0c, 0xbc, 0xfc, 0xf6, 0xc2, 0x2b, 0xc5, 0x2c, 0x20, 0xf0, 0x12, 0x5d,
+    0x93, 0xd4, 0x0f, 0xe9, 0x46, 0x7b, 0xb0, 0x85, 0x91, 0xc1, 0x06, 0x8b, 0xcf, 0x01, 0xd7, 0xca,
+    0x7d, 0xe6, 0xa6, 0x34, 0x0c, 0xd1, 0x06, 0x9c, 0x66, 0xee, 0x4a, 0x30, 0xb0, 0x2d, 0x4c, 0x7b,
+    0x91, 0x7b, 0x42, 0x55, 0xbf, 0xe3, 0x86, 0x35, 0x27, 0x60, 0xcd, 0xa6, 0xbe, 0xdd, 0x2c, 0x65,
+    0xb0, 0x91, 0xd0, 0x40, 0x58, 0xa9, 0xce, 0xb9, 0x55, 0x72, 0x2e, 0xd4, 0x97, 0x38, 0x29, 0xd8,
+    0x72, 0xb6, 0x59, 0x81, 0x61, 0x85, 0x3f, 0x10, 0x3b, 0xa6, 0xe8, 0xae, 0x35, 0xed, 0x9a, 0x13,
+    0x26, 0x58, 0x43, 0xbd, 0x56, 0xa9, 0x41, 0x38, 0x0e, 0x0a, 0xfc, 0xcd, 0xfd, 0x9d, 0x9e, 0x38,
+    0x31, 0x29, 0x95, 0x19, 0xd3, 0x98, 0xc8, 0x2d, 0x44, 0x52, 0xec, 0x2e, 0x30, 0xe3, 0xec, 0xf4,
+    0x65, 0x1a, 0x78, 0xe5, 0x1e, 0x2e, 0x66, 0xf8, 0xa1, 0x81, 0xaf, 0xc1, 0x0e, 0x30, 0x06, 0xb8,
+    0xb3, 0x28, 0x66, 0xb6, 0xe9, 0xa7, 0x0a, 0xfc, 0x27, 0x8c, 0x62, 0xee, 0x63, 0xa8, 0xd4, 0x39,
+    0xba, 0xd7, 0xff, 0x46, 0xc4, 0x0b, 0x9c, 0xfe, 0x3e, 0xda, 0xc6, 0x67, 0x00, 0x39, 0xd8, 0x4a,
+    0x22, 0x07, 0xf1, 0xee, 0x76, 0xba, 0xeb, 0xa4, 0x5e, 0xdb, 0x6d, 0x98, 0x59, 0x88, 0xd8, 0x69,
+    0xf5, 0xba, 0xb3, 0x0a, 0xa6, 0xca, 0xd0, 0x44, 0xdb, 0xb5, 0x23, 0xb7, 0xa2, 0xd8, 0xaa, 0xea,
+    0x14, 0xdd, 0x62, 0x92, 0x07, 0x7b, 0x85, 0xfe, 0xb1, 0xed, 0xd0, 0x2b, 0x1f, 0x0f, 0x24, 0x88,
+    0xa2, 0x87, 0x8b, 0xb0, 0x12, 0xe5, 0x82, 0xae, 0x20, 0x25, 0xb0, 0xfb, 0x34, 0x8d, 0xec, 0x2c,
+    0x49, 0x48, 0xea, 0x3a, 0x8c, 0x34, 0xc3, 0xdd, 0xd4, 0x5b, 0x51, 0x3a, 0x6e, 0xba, 0x2f, 0xb0,
+    0xbe, 0xd3, 0xd7, 0x4e, 0x95, 0x86, 0x35, 0x6d, 0xf8, 0xde, 0x39, 0x66, 0x12, 0xcc, 0x0f, 0x45,
+    0xb2, 0xd3, 0xad, 0xaa, 0x70, 0xb9, 0x54, 0x10, 0x99, 0x3a, 0x96, 0xad, 0x2a, 0xb7, 0xe6, 0xf1,
+    0x2c, 0x31, 0x41, 0xe2, 0x64, 0x5d, 0xcd, 0x7a, 0x21, 0xf1, 0x39, 0xee, 0x29, 0x02, 0x97, 0xe2,
+    0x05, 0xeb, 0x32, 0x4c, 0xd0, 0xa3, 0x8d, 0xc2, 0x0e, 0x78, 0xbd, 0xc3, 0x4c, 0x3b, 0x9d, 0x11,
+    0xf7, 0xbf, 0x6a, 0xdb, 0xb3, 0xb6, 0xf7, 0x61, 0x0a, 0x46, 0x3a, 0xca, 0x6a, 0xbc, 0x3d, 0x12,
+    0xb2, 0x98, 0x80, 0x1b, 0x37, 0x11, 0x73, 0x2d, 0xeb, 0x1c, 0x4e, 0xb6, 0x3b, 0x3d, 0xa5, 0x9b,
+    0x76, 0x8a, 0x42, 0xdb, 0x74, 0x5c, 0xaa, 0xd3, 0x11, 0x06, 0x84, 0x1b, 0x1a, 0x06, 0xb8, 0x8d,
+    0x1f, 0x02, 0x1b, 0x34, 0x1f, 0x0b, 0x12, 0x36, 0x59, 0x6e, 0xd8, 0x67, 0x17, 0xc4, 0x49, 0xc6,
+    0xef, 0xf8, 0x63, 0x42, 0xe6, 0x71, 0x16, 0x2d, 0x48, 0x7a, 0x3f, 0xac, 0x6c, 0xa1, 0xa9, 0xee,
+    0x87, 0x8c, 0x84, 0xc4, 0xe5, 0x1d, 0x7a, 0xb6, 0x8e, 0xea, 0xb9, 0x59, 0x40, 0x0b, 0x25, 0x4f,
+    0x31, 0x01, 0x1a, 0xad, 0x8a, 0xd0, 0x28, 0x39, 0x18, 0x65, 0x32, 0xd2, 0xa1, 0xda, 0xbe, 0x9a,
+    0xd1, 0x8c, 0xa3, 0x53, 0x8a, 0x84, 0xd3, 0x8e, 0x35, 0x45, 0xe4, 0x32, 0xc1, 0xb8, 0xed, 0x53,
+    0x37, 0x63, 0x39, 0xcf, 0x72, 0xb1, 0x3d, 0x94, 0xcb, 0x2a, 0x92, 0x02, 0xc6, 0x25, 0xb9, 0xdf,
+    0x56, 0x28, 0x02, 0x04, 0x68, 0xbb, 0x75, 0xa9, 0x28, 0xf0, 0x58, 0xcb, 0x0d, 0x50, 0xf4, 0xb2,
+    0xb3, 0xac, 0x3e, 0xd9, 0xfd, 0xce, 0x2a, 0xf5, 0xc4, 0x5e, 0x05, 0x9e, 0x47, 0x62, 0x44, 0x9a,
+    0x1b, 0xaf, 0x50, 0xd9, 0xf9, 0x81, 0x9a, 0xd1, 0xa8, 0x09, 0xcd, 0xe0, 0x6b, 0x25, 0x7b, 0x40,
+    0x2c, 0x64, 0x6e, 0xe4, 0xef, 0x62, 0xdb, 0x76, 0x57, 0xc4, 0xfd, 0x4c, 0xbc, 0x13, 0xc8, 0x29,
+    0x1d, 0xa5, 0x56, 0x88, 0x2f, 0x69, 0xbc, 0xf4, 0xa1, 0xe5, 0x2a, 0xf9, 0x54, 0x04, 0x7c, 0x2d,
+    0xfb, 0xcf, 0x9a, 0xac, 0xef, 0xf4, 0x05, 0x8f, 0x9f, 0xda, 0x82, 0x7c, 0xca, 0x18, 0x0f, 0xfc,
+    0x47, 0x2d, 0xef, 0x81, 0x8b, 0xed, 0x8a, 0x75, 0xca, 0x88, 0x35, 0x10, 0xff, 0x59, 0xe9, 0x4d,
+    0xd2, 0x41, 0xbe, 0xeb, 0x59, 0xad, 0x62, 0x5b, 0x57, 0x64, 0x43, 0x71, 0x15, 0xa1, 0x9b, 0x6d,
+    0x0f, 0x4a, 0x65, 0x3b, 0x2e, 0x0f, 0xd6, 0x64, 0xbb, 0x4f, 0xd2, 0xa2, 0x0f, 0xef, 0xeb, 0x17,
+    0x53, 0x48, 0x51, 0x0b, 0x2d, 0x49, 0x83, 0x6e, 0x65, 0xe2, 0x21, 0x74, 0x28, 0xdd, 0x4d, 0x0d,
+    0x1e, 0x42, 0x43, 0xb4, 0xed, 0xec, 0x92, 0xf0, 0x10, 0x7a, 0xe1, 0xf6, 0x21, 0x6c, 0x96, 0x36,
+    0x32, 0x0c, 0x43, 0x90, 0xcf, 0xd2, 0x36, 0x1c, 0x6c, 0x36, 0xe1, 0x20, 0xc4, 0xaa, 0x70, 0xd5,
+    0x46, 0xe2, 0xa9, 0x51, 0x6e, 0x21, 0x63, 0x8e, 0xb7, 0x24, 0x4d, 0x43, 0xd7, 0x7d, 0x02, 0x73,
+    0xfb, 0xb4, 0x95, 0x00, 0x4c, 0xa3, 0x6e, 0x27, 0xb3, 0x9d, 0x61, 0x21, 0x11, 0x87, 0xdb, 0xa7,
+    0xa4, 0xd4, 0x69, 0x47, 0xac, 0x34, 0x19, 0x65, 0x21, 0x74, 0xc5, 0xeb, 0x2d, 0xf6, 0xf5, 0x79,
+    0x4b, 0x61, 0xd5, 0x2b, 0x7b, 0x8a, 0x64, 0x5b, 0x49, 0xbe, 0x91, 0xd6, 0x76, 0xba, 0xf3, 0x25,
+    0xd0, 0x16, 0x4e, 0xba, 0xcd, 0xeb, 0xe5, 0x69, 0x4b, 0x30, 0x6b, 0x5f, 0x54, 0xd0, 0x6d, 0x84,
+    0xe4, 0x7b, 0x3d, 0xa3, 0x7e, 0x9c, 0x14, 0x4c, 0x0e, 0xc0, 0x20, 0x40, 0xff, 0xc2, 0xf0, 0xc8,
+    0x72, 0x98, 0x0f, 0x40, 0x8a, 0xf1, 0x6a, 0x98, 0xcf, 0x3b, 0x8a, 0x35, 0x81, 0xef, 0x72, 0x12,
+    0x52, 0x26, 0xb8, 0x2f, 0x27, 0x1f, 0xe5, 0x1c, 0xf7, 0xa7, 0x53, 0x83, 0x9c, 0xfa, 0x0a, 0xc6,
+    0x46, 0xce, 0xd2, 0xbe, 0x11, 0x9f, 0xee, 0x1b, 0xf1, 0xe9, 0xf7, 0x1a, 0xf1, 0xa6, 0x8f, 0x6b,
+    0x18, 0x3c, 0x95, 0x70, 0xc8, 0x8f, 0xb0, 0x70, 0x2b, 0x3a, 0x44, 0x46, 0xa3, 0xf3, 0xc6, 0xac,
+    0x98, 0x2e, 0x17, 0x4e, 0xdf, 0x18, 0xe2, 0xbf, 0xfa, 0x04, 0x98, 0x89, 0xa8, 0x97, 0x85, 0xa4,
+    0xa3, 0x01, 0x3f, 0x6b, 0x15, 0xae, 0xce, 0xda, 0x1b, 0x61, 0xe2, 0x68, 0x65, 0xc2, 0x86, 0xef,
+    0x74, 0x0c, 0x2c, 0xcd, 0x18, 0x3f, 0x96, 0x93, 0xbb, 0x4a, 0xdb, 0x77, 0x1a, 0xf0, 0x56, 0x72,
+    0x45, 0x3e, 0x3b, 0x47, 0x94, 0x63, 0xfd, 0x74, 0x35, 0x9f, 0x5e, 0x8e, 0xe4, 0x70, 0x7e, 0x39,
+    0x92, 0x8f, 0x05, 0x38, 0xd2, 0x5e, 0x5d, 0x42, 0x53, 0xa4, 0xb8, 0xa1, 0xc3, 0xd8, 0xbc, 0x87,
+    0x2a, 0xca, 0x9f, 0x12, 0x48, 0x0a, 0x7f, 0x9a, 0x57, 0x3f, 0xbe, 0xbc, 0xb0, 0x0c, 0x73, 0xa6,
+    0x54, 0x07, 0x7d, 0xd8, 0xae, 0x5e, 0x62, 0xbc, 0x57, 0x5b, 0x83, 0x5f, 0xf4, 0x94, 0xc0, 0x93,
+    0x5f, 0x80, 0x16, 0x1c, 0x5d, 0x5d, 0x62, 0x02, 0x17, 0x9b, 0x8c, 0x3f, 0x00, 0xfc, 0x0d, 0x8d,
+    0x63, 0x28, 0x9f, 0xa0, 0x70, 0x5d, 0xd7, 0x81, 0x2d, 0x38, 0x2d, 0x20, 0x47, 0x05, 0xf5, 0x0a,
+    0xca, 0xdc, 0xc2, 0x12, 0x2d, 0x2c, 0x18, 0xe0, 0x5d, 0x64, 0x60, 0xc2, 0xb8, 0x84, 0x00, 0xdd,
+    0x28, 0x34, 0xee, 0xc1, 0x7f, 0x6e, 0x18, 0xb8, 0x9f, 0x81, 0xd0, 0xa6, 0xaf, 0x0a, 0x86, 0xd5,
+    0x01, 0xd0, 0x93, 0x9c, 0xcb, 0x3b, 0x5d, 0x77, 0x1b, 0x17, 0xff, 0x20, 0x0e, 0x5f, 0x91, 0x14,
+    0xaf, 0xe6, 0x5f, 0x9f, 0x71, 0xf9, 0xa7, 0x20, 0xfd, 0x7b, 0x06, 0x11, 0xce, 0x1f, 0xf1, 0x3e,
+    0xac, 0x94, 0x7c, 0xf9, 0x0c, 0x1c, 0xef, 0x29, 0x88, 0x49, 0x53, 0x8a, 0x18, 0x8a, 0xef, 0xcf,
+    0xb8, 0xfe, 0x01, 0x92, 0xcc, 0xad, 0x18, 0x12, 0x11, 0x01, 0xae, 0xf6, 0x97, 0xa5, 0x9a, 0x2b,
+    0xda, 0xc5, 0xe9, 0xb5, 0xd7, 0xdc, 0xa9, 0x2b, 0x13, 0x36, 0xfa, 0x7c, 0x15, 0xb0, 0xa1, 0x01,
+    0xe8, 0x7e, 0x71, 0xd8, 0x6a, 0x41, 0x61, 0x9c, 0xe8, 0x44, 0xd5, 0x75, 0xcb, 0x1c, 0x08, 0x93,
+    0x73, 0x60, 0x88, 0x15, 0x66, 0x6e, 0x5e, 0xc5, 0x19, 0x4f, 0x10, 0x15, 0xae, 0x63, 0xd4, 0x19,
+    0xc2, 0xf9, 0xab, 0xbe, 0x83, 0xe3, 0x4c, 0x7d, 0x07, 0x46, 0x9b, 0x1e, 0xf8, 0xab, 0x69, 0x4d,
+    0xc7, 0xe3, 0xe9, 0x4c, 0xf9, 0x10, 0x44, 0xa4, 0x4d, 0x05, 0x66, 0x13, 0x49, 0xc1, 0xd5, 0xc0,
+    0x0d, 0x35, 0xcd, 0xd6, 0xb4, 0x36, 0x10, 0xce, 0x0a, 0x05, 0x94, 0x87, 0x50, 0xda, 0x21, 0xa6,
+    0x8f, 0x70, 0x71, 0x0e, 0xff, 0x00, 0x17, 0x30, 0x33, 0x92, 0xd4, 0xe1, 0x59, 0x7a, 0x8c, 0x99,
+    0x8d, 0x64, 0xe6, 0x00, 0x27, 0x95, 0xe8, 0xd9, 0x68, 0x2b, 0x09, 0x28, 0x22, 0xe6, 0x95, 0x02,
+    0x84, 0xa6, 0xe3, 0x99, 0x52, 0x05, 0x48, 0x2a, 0x00, 0xca, 0xea, 0xbd, 0x73, 0x4c, 0xbc, 0x8d,
+    0xe6, 0x97, 0x11, 0x7a, 0x40, 0xc2, 0x67, 0x69, 0xfe, 0xfc, 0x7c, 0x0a, 0x9a, 0xaf, 0x79, 0xfc,
+    0x41, 0x99, 0x1d, 0x6d, 0x7d, 0x4c, 0xe6, 0xf7, 0xef, 0x2c, 0x7d, 0x62, 0x57, 0x24, 0x73, 0x34,
+    0x6b, 0x52, 0x15, 0x2d, 0x17, 0xfd, 0xfd, 0x3b, 0xd3, 0xa8, 0x83, 0x99, 0x46, 0x05, 0xac, 0x8d,
+    0x3e, 0xaf, 0xa6, 0xbd, 0x03, 0x47, 0x65, 0xf6, 0x72, 0xb4, 0x6a, 0xfe, 0xea, 0x54, 0x9f, 0xa3,
+    0x89, 0xdc, 0xf7, 0x27, 0x7c, 0x63, 0x6a, 0x22, 0xeb, 0x65, 0x5c, 0x1f, 0x54, 0x52, 0xf2, 0x24,
+    0x2f, 0x4d, 0x34, 0x88, 0xdf, 0x5b, 0xa8, 0xa6, 0x09, 0xf1, 0x8e, 0x5b, 0x53, 0x3c, 0x02, 0x90,
+    0xf5, 0xa1, 0xc0, 0xb1, 0xce, 0xcf, 0x66, 0xca, 0xeb, 0x35, 0x74, 0x09, 0xec, 0x18, 0x3d, 0x52,
+    0xb5, 0xdc, 0x91, 0x70, 0xce, 0xb9, 0x33, 0xeb, 0xe4, 0x60, 0xd4, 0xc5, 0x1a, 0x33, 0xae, 0xc4,
+    0x6a, 0x51, 0x58, 0xc6, 0x35, 0x40, 0x98, 0x31, 0x01, 0x50, 0x0c, 0x0e, 0x8a, 0x98, 0xa1, 0x7a,
+    0x72, 0x82, 0x94, 0x68, 0xf9, 0xd7, 0x1e, 0x14, 0xd8, 0x30, 0x83, 0xed, 0x89, 0x3e, 0xe9, 0x29,
+    0x8c, 0x93, 0x64, 0xde, 0x33, 0xf0, 0x2b, 0x74, 0x01, 0x2e, 0x59, 0xd1, 0x10, 0xca, 0xc8, 0xbc,
+    0x87, 0x79, 0xe0, 0x2b, 0xc5, 0xdc, 0xe2, 0xfb, 0x8c, 0x70, 0x04, 0x84, 0x1a, 0x38, 0xef, 0x61,
+    0x63, 0x60, 0x9b, 0x5d, 0x06, 0x96, 0x74, 0xab, 0x1b, 0x4b, 0x58, 0x8b, 0x41, 0xa4, 0xce, 0x0e,
+    0xf6, 0x06, 0xb4, 0x97, 0x3f, 0xac, 0xbb, 0x7e, 0xc9, 0x8f, 0x69, 0xf5, 0x94, 0x7c, 0xd2, 0x91,
+    0xb1, 0x7b, 0x65, 0x5a, 0x7f, 0x2d, 0x1d, 0x32, 0x47, 0xf4, 0x0c, 0x7c, 0xd6, 0x69, 0x9e, 0x03,
+    0xae, 0xac, 0xd3, 0x16, 0x9e, 0xaa, 0xfe, 0xeb, 0x75, 0x01, 0x4b, 0xa2, 0x18, 0x0e, 0xaa, 0xc5,
+    0x81, 0xc4, 0xde, 0xef, 0xe4, 0x4b, 0x46, 0x18, 0xef, 0xab, 0x23, 0x17, 0xf5, 0x3e, 0x82, 0x21,
+    0xc8, 0x0f, 0x96, 0xd7, 0xfc, 0xeb, 0x5c, 0x3d, 0xf9, 0x4b, 0x5f, 0xe5, 0x5f, 0xd5, 0x81, 0x2e,
+    0x28, 0x9f, 0xa8, 0x3f, 0xfa, 0x11, 0x87, 0x5d, 0x0f, 0xa6, 0xdc, 0x08, 0xbc, 0x42, 0x87, 0x8b,
+    0xe9, 0xe3, 0xad, 0x18, 0x7d, 0x69, 0xda, 0x57, 0xe5, 0x7c, 0x2b, 0xf8, 0x75, 0xfd, 0xfb, 0x62,
+    0xba, 0x2b, 0xae, 0x63, 0xf1, 0x4b, 0x92, 0xf0, 0xf1, 0x48, 0xe9, 0xa9, 0xf9, 0x82, 0xcc, 0x98,
+    0x65, 0xbd, 0xed, 0xf4, 0x86, 0xe7, 0x5a, 0x65, 0x93, 0x95, 0x5a, 0xbc, 0x69, 0x1a, 0x05, 0x68,
+    0x82, 0xbf, 0xdf, 0x3c, 0xd7, 0x30, 0x15, 0x94, 0x6f, 0x7a, 0x35, 0x54, 0x6f, 0xfe, 0x9b, 0xb6,
+    0xd9, 0x48, 0x3d, 0x8c, 0xb2, 0x38, 0xe0, 0xd7, 0xd9, 0xd3, 0x8c, 0xb0, 0xc9, 0xba, 0x8c, 0x70,
+    0x4b, 0xb8, 0xf2, 0x11, 0xb0, 0x3c, 0xdd, 0x0e, 0xad, 0x2c, 0x8e, 0xb6, 0xe8, 0x12, 0x00, 0xe6,
+    0xc8, 0x83, 0x02, 0x40, 0x36, 0x1d, 0x89, 0xc1, 0xd5, 0xe1, 0x04, 0xbb, 0x10, 0x68, 0x25, 0xcf,
+    0x26, 0xa7, 0x60, 0x60, 0xe7, 0x33, 0x51, 0x6e, 0x49, 0x0c, 0xbd, 0xee, 0xa1, 0x8e, 0x46, 0x22,
+    0x87, 0x39, 0xf4, 0x28, 0x72, 0x16, 0x12, 0x92, 0xe4, 0x98, 0xcf, 0x2d, 0xc0, 0x7c, 0x8b, 0x1b,
+    0x2d, 0xd4, 0xdf, 0x11, 0xb6, 0x91, 0x8a, 0x1b, 0x5e, 0xc7, 0xc2, 0xc2, 0xc4, 0x7f, 0xd0, 0xf4,
+    0x73, 0x61, 0xdf, 0xba, 0x6f, 0xc4, 0xcb, 0x22, 0xd3, 0x6d, 0x7a, 0x0a, 0x4c, 0x7b, 0x90, 0x90,
+    0xe0, 0x4f, 0xe7, 0x61, 0xde, 0x3b, 0x33, 0x4a, 0x57, 0x19, 0x1b, 0x28, 0x8b, 0xb8, 0x38, 0xef,
+    0x41, 0x94, 0x25, 0x9b, 0x35, 0x98, 0x08, 0x87, 0xc1, 0x9b, 0xfc, 0x77, 0x38, 0xec, 0x94, 0xa4,
+    0xcd, 0x8a, 0x8a, 0x5f, 0xf0, 0xb0, 0x2e, 0xd0, 0x43, 0xde, 0x1d, 0x1b, 0x05, 0x13, 0xe2, 0x13,
+    0xc8, 0x1d, 0xac, 0x74, 0x7b, 0xde, 0x7f, 0x4e, 0x89, 0xf3, 0x5d, 0xe6, 0x17, 0x39, 0xf3, 0x66,
+    0xce, 0xfc, 0x78, 0xcf, 0xfc, 0xa4, 0xc1, 0xfb, 0xe2, 0xf9, 0xbc, 0x2f, 0x80, 0xf7, 0xc9, 0x93,
+    0x59, 0xc7, 0x60, 0x2f, 0x12, 0x75, 0xfd, 0x41, 0xa4, 0xd7, 0xed, 0x2b, 0x14, 0xb2, 0x41, 0x23,
+    0xb3, 0xef, 0x5d, 0x67, 0xe1, 0x70, 0x77, 0xd5, 0xbf, 0x53, 0x47, 0x09, 0x98, 0x79, 0x04, 0x45,
+    0xe0, 0x7a, 0x23, 0x53, 0x5d, 0xb2, 0x29, 0xc2, 0x64, 0x98, 0x1f, 0x6e, 0xc0, 0xca, 0xea, 0x3d,
+    0xb6, 0xfd, 0xc2, 0xdc, 0xc7, 0xdc, 0x53, 0xf8, 0xfe, 0xd3, 0x49, 0x2e, 0x72, 0x92, 0x8b, 0x26,
+    0xc9, 0x05, 0x1a, 0x47, 0xd0, 0xcc, 0xcd, 0x54, 0x77, 0xdc, 0xe7, 0x46, 0x86, 0x24, 0x08, 0xda,
+    0xc2, 0xc8, 0xc0, 0xa6, 0xe0, 0xa9, 0x91, 0x30, 0x35, 0xcf, 0x2d, 0x88, 0x21, 0x31, 0x35, 0x28,
+    0x72, 0x64, 0xc0, 0x60, 0xa8, 0xba, 0x0b, 0x9a, 0x3c, 0xaf, 0xbe, 0x51, 0xa3, 0xcc, 0xbe, 0xc6,
+    0x99, 0x55, 0x89, 0x08, 0x63, 0xce, 0x92, 0xc0, 0x50, 0x27, 0x9c, 0x28, 0x24, 0xf1, 0x92, 0xaf,
+    0xa0, 0x80, 0x4d, 0x1a, 0xfd, 0xbc, 0x4c, 0xe6, 0xf2, 0x0d, 0x55, 0xe2, 0x63, 0xed, 0xc2, 0x4c,
+    0x13, 0x1c, 0x7e, 0xcb, 0x22, 0x08, 0xdd, 0xdf, 0x6d, 0x48, 0x37, 0x97, 0x23, 0xb9, 0xdf, 0x3c,
+    0x07, 0x12, 0x8a, 0x44, 0x08, 0x09, 0xfe, 0x6f, 0x34, 0x8d, 0x9c, 0xf0, 0x10, 0xe8, 0x39, 0xa0,
+    0x7a, 0xe3, 0x30, 0x7e, 0xe8, 0xdc, 0x34, 0x80, 0xdd, 0x7f, 0x40, 0x92, 0x55, 0xea, 0x50, 0x23,
+    0x89, 0xff, 0x68, 0x46, 0xcf, 0xd2, 0x83, 0x96, 0x41, 0xed, 0x8d, 0xd8, 0x8a, 0x6e, 0xae, 0x23,
+    0xb6, 0x04, 0x6f, 0x20, 0xb1, 0x4b, 0x3d, 0xf2, 0xf1, 0xf7, 0xb7, 0x37, 0x34, 0x4a, 0xa0, 0x43,
+    0x89, 0x79, 0x1f, 0xcb, 0x6f, 0x54, 0xa6, 0x6e, 0xa8, 0xbf, 0x2c, 0x21, 0xc4, 0xcb, 0xeb, 0x32,
+    0xab, 0xe6, 0x74, 0x61, 0xa6, 0xa6, 0x69, 0xab, 0x9f, 0xcc, 0x4d, 0x83, 0x84, 0x5f, 0xf9, 0x59,
+    0xec, 0x0a, 0xd9, 0xfe, 0xd2, 0x0f, 0xbc, 0xc1, 0x36, 0x25, 0x30, 0x8a, 0xc4, 0x4a, 0x59, 0x4b,
+    0x96, 0x84, 0xbf, 0x0e, 0x09, 0x7e, 0xfd, 0xf9, 0xf1, 0xad, 0x87, 0x20, 0xbb, 0x17, 0xe5, 0x95,
+    0xc4, 0xf1, 0xfa, 0x71, 0x79, 0xe7, 0x96, 0xa7, 0x30, 0xaf, 0xc3, 0x86, 0x0e, 0xfb, 0xb7, 0xdc,
+    0x49, 0x79, 0xdf, 0x1a, 0xaa, 0x86, 0x5a, 0xbd, 0x51, 0x15, 0x38, 0x1b, 0x6c, 0x5f, 0xf8, 0x04,
+    0xc3, 0x20, 0x83, 0x64, 0xb1, 0x22, 0x71, 0xbf, 0x00, 0xeb, 0xa7, 0x83, 0x6d, 0xe0, 0xf7, 0x7f,
+    0x48, 0x75, 0xfa, 0x79, 0x00, 0xdd, 0x07, 0xa3, 0x21, 0xd1, 0x49, 0x9a, 0x42, 0x35, 0xcb, 0x06,
+    0xbb, 0x81, 0xee, 0x8a, 0xe0, 0x29, 0xa1, 0xc9, 0x60, 0x5b, 0x07, 0x22, 0x00, 0x34, 0x7b, 0x51,
+    0x21, 0x2b, 0xa3, 0xcd, 0x8d, 0x3c, 0x56, 0xd2, 0x84, 0x12, 0x91, 0x04, 0x23, 0x71, 0xa0, 0x0e,
+    0xb7, 0xd0, 0xbb, 0xae, 0xa8, 0x67, 0xab, 0xef, 0x7f, 0xbb, 0xfd, 0xa0, 0x0e, 0xf1, 0xdd, 0xc3,
+    0x46, 0x68, 0xfd, 0x13, 0x0d, 0xe2, 0xbe, 0xfa, 0xaf, 0x58, 0x45, 0xb2, 0x2d, 0x1e, 0x5f, 0x1c,
+    0x60, 0x52, 0x10, 0x9a, 0xbd, 0xc8, 0xf5, 0x92, 0xea, 0x9f, 0x18, 0xc0, 0x23, 0x47, 0x4d, 0x1c,
+    0x9e, 0x90, 0xd3, 0xd3, 0xe5, 0xfb, 0xed, 0x20, 0x05, 0xed, 0x90, 0x14, 0x76, 0xff, 0x8c, 0x8c,
+    0x30, 0xd6, 0x47, 0xc0, 0x52, 0xdd, 0xa5, 0xe4, 0xc3, 0xc8, 0x48, 0x3d, 0x89, 0xea, 0xc0, 0x38,
+    0x79, 0x93, 0x70, 0x18, 0xc0, 0x85, 0xb5, 0x93, 0x2a, 0x9c, 0xcd, 0xbb, 0xbb, 0x87, 0x9f, 0xc2,
+    0xb0, 0xaf, 0xe2, 0x4f, 0xb4, 0x2a, 0xdc, 0x47, 0xc8, 0xe4, 0x38, 0x24, 0x76, 0xf5, 0x08, 0xea,
+    0x03, 0x87, 0x08, 0xfe, 0x69, 0x6e, 0xcc, 0x3e, 0x5d, 0x72, 0xa6, 0xcb, 0x48, 0x9f, 0x7d, 0x3a,
+    0x39, 0x19, 0x6c, 0x39, 0xbb, 0xfb, 0x74, 0xaf, 0x8b, 0xb0, 0xf8, 0x35, 0x60, 0x5c, 0x4f, 0x49,
+    0x44, 0xd7, 0xa4, 0xaf, 0x52, 0x50, 0xf3, 0x2c, 0x39, 0x72, 0xb8, 0x7b, 0x41, 0xc2, 0xca, 0x91,
+    0xe3, 0x79, 0xfb, 0x4b, 0xc1, 0x7d, 0xe7, 0x49, 0x55, 0x68, 0xe8, 0x09, 0xde, 0xc6, 0x3e, 0xed,
+    0xaf, 0xa5, 0xe5, 0xd6, 0x97, 0x73, 0xd3, 0x1a, 0x48, 0x23, 0xdd, 0xa9, 0xff, 0x47, 0xa9, 0xa7,
+    0x0e, 0xd5, 0xfc, 0xd9, 0x53, 0x1d, 0x1a, 0xf7, 0xb3, 0x1c, 0x68, 0x3c, 0x29, 0x81, 0xde, 0x41,
+    0x3c, 0xa6, 0xd8, 0xae, 0x00, 0xa0, 0x7c, 0x14, 0x55, 0x87, 0xd6, 0xa4, 0x84, 0x9c, 0xec, 0x21,
+    0xb1, 0xc9, 0x08, 0xd0, 0xa8, 0x08, 0xea, 0x1b, 0xd3, 0xe9, 0x18, 0xbe, 0x9d, 0xee, 0x41, 0xcd,
+    0x89, 0x51, 0xc2, 0x7e, 0x8c, 0x57, 0xc4, 0x09, 0xf9, 0xea, 0x51, 0xc0, 0x8a, 0xf7, 0x55, 0x75,
+    0x78, 0xb6, 0x67, 0xc0, 0xaa, 0xc0, 0xfe, 0x43, 0xaf, 0x41, 0xcb, 0x17, 0x58, 0x75, 0x38, 0x45,
+    0xe8, 0x02, 0xe6, 0xaf, 0xce, 0x57, 0x18, 0xe3, 0x68, 0xc6, 0x10, 0x42, 0xbe, 0xcb, 0xaa, 0xc3,
+    0x0b, 0xa4, 0x5d, 0x51, 0x46, 0xe9, 0x6b, 0xdb, 0x17, 0x58, 0x75, 0x02, 0x28, 0x07, 0xdd, 0x0a,
+    0x44, 0x33, 0x62, 0x52, 0x8a, 0xe7, 0x9e, 0x8e, 0x73, 0x12, 0xfb, 0xf6, 0xed, 0xae, 0xf0, 0x58,
+    0x40, 0x09, 0x97, 0xf1, 0xc9, 0xae, 0x51, 0xef, 0xc5, 0x85, 0x3c, 0x7a, 0x94, 0x6f, 0x8a, 0x3a,
+    0xf8, 0xf6, 0x4d, 0xd5, 0x34, 0x55, 0x62, 0x83, 0x4c, 0x78, 0xdc, 0x8b, 0xf0, 0xc1, 0xaa, 0xea,
+    0x45, 0x01, 0x78, 0x51, 0x70, 0x89, 0xd7, 0x0a, 0x3f, 0x0a, 0xd0, 0x8f, 0x5e, 0xe0, 0x4e, 0xdd,
+    0xf0, 0x9c, 0x2e, 0x97, 0xa1, 0xf4, 0x96, 0xa1, 0xe4, 0x21, 0x00, 0x31, 0x1f, 0x7e, 0xf3, 0xfb,
+    0x05, 0x6c, 0x85, 0x4b, 0x1d, 0x12, 0x56, 0xd4, 0x1f, 0x0c, 0xae, 0xe6, 0x86, 0x70, 0x14, 0x11,
+    0x8a, 0x62, 0xd4, 0x94, 0x4a, 0x71, 0xb5, 0xa6, 0x58, 0xf9, 0xb1, 0xce, 0x61, 0x66, 0x14, 0x12,
+    0xd9, 0x42, 0x28, 0x01, 0xeb, 0x1d, 0x80, 0xf5, 0xc0, 0x5f, 0x04, 0x2c, 0x42, 0xe6, 0x44, 0xf2,
+    0x19, 0x46, 0xfa, 0x61, 0xb9, 0xc4, 0x44, 0x22, 0x08, 0x6f, 0x3a, 0x08, 0x17, 0x30, 0x28, 0xe3,
+    0x9b, 0xe0, 0x81, 0x78, 0x7d, 0x13, 0xf2, 0xff, 0xbf, 0x32, 0xc3, 0xf8, 0xd9, 0x80, 0xde, 0xbf,
+    0x3c, 0xcf, 0x66, 0x12, 0xc3, 0xea, 0x20, 0x86, 0x55, 0x89, 0x01, 0xc5, 0x16, 0xc0, 0xc9, 0x41,
+    0xe0, 0xa4, 0x0d, 0xec, 0x1f, 0x04, 0xfe, 0x7a, 0x5d, 0x11, 0xc6, 0x4b, 0x40, 0xaf, 0xd7, 0xea,
+    0x89, 0x6a, 0xab, 0xea, 0xe0, 0xa4, 0xba, 0x5f, 0x93, 0x00, 0x9f, 0xa0, 0x46, 0xe3, 0x95, 0x22,
+    0x24, 0x39, 0x57, 0xaa, 0xa2, 0xf8, 0x2e, 0x5c, 0x05, 0x9d, 0x91, 0x90, 0x91, 0x6d, 0xa7, 0x5a,
+    0xd4, 0xbf, 0x8d, 0x7e, 0x52, 0x67, 0xbb, 0x42, 0xad, 0xfb, 0x87, 0xd5, 0x3c, 0xaf, 0x39, 0xf3,
+    0xea, 0xa6, 0x88, 0xa7, 0x1f, 0x1c, 0x9d, 0xc6, 0x3f, 0xfe, 0xe8, 0xe8, 0xd0, 0x86, 0xa0, 0xe1,
+    0x25, 0xe0, 0x97, 0x79, 0x91, 0x1c, 0x1c, 0x3d, 0x89, 0xac, 0x89, 0x94, 0xd5, 0xd1, 0x9a, 0x7d,
+    0xec, 0x97, 0x3b, 0x08, 0xb4, 0xf2, 0x44, 0x34, 0x24, 0xba, 0x78, 0x40, 0x87, 0x13, 0xf3, 0x3e,
+    0xbf, 0x64, 0x4d, 0x1a, 0xb7, 0x24, 0x4e, 0x79, 0xcf, 0x34, 0x3a, 0x0e, 0x4d, 0x23, 0xbf, 0xca,
+    0x78, 0xeb, 0x14, 0x7c, 0x9b, 0xa4, 0xd7, 0xea, 0xad, 0x13, 0x25, 0xa1, 0x7c, 0x0f, 0x07, 0x8d,
+    0x8a, 0x15, 0xf1, 0x40, 0x5d, 0x42, 0x90, 0x13, 0x95, 0x29, 0xce, 0x92, 0x0e, 0x95, 0x18, 0xae,
+    0x2a, 0x41, 0x2c, 0xf6, 0xf1, 0x3b, 0x1c, 0xa8, 0x39, 0x6a, 0x19, 0xe2, 0x92, 0x65, 0xd9, 0x32,
+    0xff, 0x4a, 0x7c, 0x94, 0xc8, 0xba, 0x3f, 0x51, 0x5f, 0x15, 0x7a, 0x56, 0x0a, 0x15, 0x49, 0x4f,
+    0x6c, 0x6b, 0x40, 0x15, 0x43, 0x94, 0xda, 0xad, 0x04, 0xb5, 0xfc, 0x7b, 0x1f, 0xea, 0x21, 0x81,
+    0xe4, 0x7d, 0x10, 0x44, 0xe1, 0x54, 0x81, 0x7d, 0x48, 0x43, 0x4a, 0x18, 0xf8, 0x04, 0x1b, 0xfd,
+    0x06, 0x13, 0x1b, 0x27, 0x8d, 0x0e, 0xb2, 0xf1, 0x07, 0x1c, 0x66, 0xdf, 0xe1, 0x03, 0x7f, 0x8b,
+    0x54, 0x0f, 0x6b, 0x16, 0xba, 0x5b, 0x54, 0x1c, 0x54, 0x18, 0x27, 0x80, 0xe9, 0x65, 0xa9, 0x0a,
+    0x07, 0x91, 0xc6, 0xba, 0x02, 0xcf, 0xf8, 0xf3, 0xc6, 0xdc, 0xe5, 0x4e, 0xfb, 0xff, 0xdb, 0xb7,
+    0xd4, 0xf7, 0xef, 0x4c, 0xdd, 0xb0, 0x85, 0xb3, 0x00, 0xdc, 0x93, 0xfd, 0xa4, 0x08, 0xb7, 0x62,
+    0x28, 0xce, 0x63, 0x28, 0x99, 0xef, 0xb7, 0x04, 0xae, 0xfd, 0xf4, 0x34, 0x4f, 0xf4, 0x4d, 0x34,
+    0xeb, 0x9c, 0x6a, 0xc5, 0xc9, 0x8b, 0xda, 0xe0, 0x03, 0x7b, 0x0b, 0x09, 0xbd, 0x68, 0x43, 0xc3,
+    0x09, 0x52, 0x4f, 0xf4, 0x34, 0xcb, 0x7d, 0x34, 0x69, 0xa5, 0x05, 0xec, 0x4b, 0x13, 0x1d, 0xe6,
+    0xc7, 0x01, 0x66, 0x9f, 0x13, 0xb9, 0x04, 0x6b, 0x4b, 0xcd, 0x27, 0x1a, 0x6b, 0xf3, 0x00, 0xd3,
+    0xdc, 0xb5, 0x8a, 0x33, 0x1d, 0xfa, 0x81, 0xad, 0x8a, 0x49, 0x4b, 0xad, 0x80, 0x57, 0xcd, 0x51,
+    0x80, 0x57, 0x9c, 0xcc, 0x56, 0xf7, 0xbf, 0x9b, 0x97, 0x29, 0xab, 0x9b, 0xb9, 0x6a, 0xd5, 0x68,
+    0xb3, 0xa2, 0xe6, 0xcf, 0xb4, 0xc2, 0xb1, 0xdb, 0xa4, 0xd5, 0x5c, 0xff, 0x95, 0x42, 0x4e, 0x7d,
+    0x1f, 0x7f, 0xc1, 0xed, 0x0b, 0x7f, 0x6d, 0xd6, 0xf1, 0x5a, 0x6b, 0xd5, 0x5d, 0xaa, 0xd5, 0xdf,
+    0x24, 0x02, 0x75, 0x27, 0xac, 0x48, 0xd6, 0xb7, 0xe4, 0xcb, 0xdc, 0x18, 0x92, 0x35, 0x22, 0x98,
+    0xdf, 0xdd, 0xcb, 0x9a, 0x7d, 0xfb, 0xfb, 0xcd, 0xfc, 0x4e, 0x85, 0x86, 0xe2, 0xe7, 0x77, 0xaf,
+    0xad, 0x29, 0xf4, 0x47, 0xe0, 0x3c, 0xb7, 0xf8, 0x59, 0xfc, 0x0e, 0x35, 0x54, 0xf1, 0x21, 0x35,
+    0x55, 0x01, 0xbe, 0x64, 0x8d, 0xac, 0x71, 0x4c, 0xc4, 0xde, 0x55, 0x76, 0x11, 0x73, 0xc0, 0x72,
+    0x47, 0x74, 0x96, 0xba, 0xf7, 0x50, 0x11, 0x65, 0xb8, 0x11, 0xa8, 0x06, 0x49, 0xe0, 0xce, 0xe7,
+    0x73, 0x95, 0x89, 0xa4, 0xa6, 0xe6, 0xbd, 0x8e, 0xc2, 0xa0, 0x38, 0xa8, 0x27, 0x00, 0x80, 0x4f,
+    0x57, 0x08, 0x8f, 0xd6, 0x94, 0x3b, 0x80, 0x01, 0x2e, 0x58, 0xd7, 0x44, 0x5f, 0x43, 0x68, 0x00,
+    0x1c, 0x56, 0x8f, 0xc5, 0x64, 0x39, 0x8a, 0xc4, 0x97, 0xb1, 0x6a, 0xe3, 0x89, 0x51, 0x9e, 0x18,
+    0x37, 0xea, 0xbe, 0x1f, 0xcf, 0x29, 0x82, 0x6e, 0xc4, 0x80, 0xda, 0x57, 0xff, 0x0d, 0xcc, 0x2b,
+    0x15, 0xec, 0x92, 0x1e, 0xab, 0x37, 0x8f, 0x44, 0xbc, 0x7a, 0x83, 0x96, 0x0b, 0x34, 0xd5, 0x31,
+    0x42, 0x1e, 0x5e, 0xb3, 0x20, 0x76, 0x09, 0x0e, 0x6e, 0xa8, 0xc3, 0x8e, 0x79, 0xa1, 0x31, 0x10,
+    0x74, 0x8d, 0x03, 0x42, 0x51, 0x7e, 0x4a, 0xd8, 0x0a, 0xa2, 0x49, 0xa2, 0xcd, 0x7b, 0x9e, 0x2b,
+    0xa3, 0xd9, 0x10, 0x35, 0x00, 0xf2, 0xa6, 0x48, 0x1a, 0x4e, 0xcf, 0x62, 0xb6, 0x0a, 0x7c, 0xde,
+    0x8f, 0xc9, 0x46, 0xf9, 0x05, 0x5a, 0x90, 0x3e, 0x10, 0xa3, 0xbf, 0x52, 0xfc, 0x7b, 0x21, 0x68,
+    0xa8, 0x7c, 0x58, 0x1b, 0x08, 0x1d, 0xe7, 0x76, 0x2a, 0xf0, 0x41, 0x9b, 0x34, 0x10, 0xc2, 0x23,
+    0xa9, 0x90, 0x82, 0x17, 0x08, 0x81, 0xae, 0x3d, 0x1d, 0x17, 0xb6, 0x21, 0xec, 0x86, 0x5f, 0x07,
+    0x0d, 0x5a, 0xb8, 0x07, 0x08, 0x25, 0x16, 0x25, 0x0a, 0x18, 0xc3, 0x77, 0xc6, 0x59, 0xce, 0xd2,
+    0x3c, 0x87, 0x66, 0x30, 0xfb, 0x92, 0xbe, 0x31, 0x3c, 0x1b, 0x08, 0x44, 0x42, 0xd8, 0x6f, 0xdf,
+    0x04, 0x3e, 0x29, 0xfe, 0x82, 0x3e, 0xcc, 0xc1, 0x57, 0x09, 0x04, 0x3f, 0xfe, 0xbc, 0x5f, 0xf7,
+    0x56, 0xb5, 0x39, 0x5c, 0xe4, 0x58, 0xab, 0x03, 0x86, 0xc0, 0x92, 0xd2, 0xcd, 0xbe, 0xc9, 0x74,
+    0x21, 0x9e, 0x39, 0xc9, 0x27, 0xd9, 0xbe, 0x0a, 0x03, 0x30, 0xe0, 0x06, 0x88, 0x1a, 0x6e, 0x89,
+    0x09, 0xc6, 0x0f, 0x41, 0xd5, 0x81, 0x30, 0x8c, 0xbd, 0x9b, 0x55, 0x10, 0x7a, 0x7d, 0x80, 0x1c,
+    0xc8, 0xc0, 0x93, 0xe1, 0xe1, 0x41, 0x36, 0xf9, 0x82, 0xf3, 0x5c, 0xa3, 0xa5, 0x16, 0xb2, 0xf4,
+    0x1b, 0x33, 0x26, 0x34, 0x80, 0x8e, 0xfa, 0x74, 0x6f, 0x90, 0x8d, 0x79, 0xbe, 0x90, 0xaa, 0x2c,
+    0xa6, 0xc1, 0x3c, 0xd4, 0x05, 0x55, 0x46, 0xf8, 0x5b, 0x7c, 0x52, 0x81, 0x8c, 0xd9, 0xcf, 0x09,
+    0x0f, 0x2d, 0xc3, 0x30, 0x84, 0x9f, 0xe7, 0x7c, 0xcc, 0x2e, 0x47, 0xf9, 0x94, 0x7f, 0x39, 0x92,
+    0xbf, 0xe5, 0x8f, 0xc4, 0xff, 0x1b, 0xf0, 0x1f, 0xcf, 0x8a, 0x0e, 0x23, 0x2b, 0x30, 0x00, 0x00,
+};
+constexpr size_t INDEX_HTML_GZ_LEN = sizeof(INDEX_HTML_GZ);
+
+#endif // WEB_ASSETS_H
@@ -0,0 +1,49 @@
+// EventBus throughput: publish plus dispatch per event, by how many
+// listeners each event reaches. Nothing may allocate.
+
+#include "EventLog.h"
+#include "host.h"
+
+struct Sink : EventListener {
+    float sum = 0;
+    void onEvent(const Event& event) override { sum += event.values[0]; }
+};
+
+int main() {
+    printf("%-28s %10s %8s\n", "eventbus", "ns/event", "allocs");
+    const uint8_t listenerCounts[] = { 1, 4, EVENT_MAX_LISTENERS };
+    for (uint8_t listeners : listenerCounts) {
+        EventBus bus;
+        Sink sinks[EVENT_MAX_LISTENERS];
+        for (uint8_t i = 0; i < listeners; i++) bus.subscribe(&sinks[i], EVENT_MASK(EVENT_SENSOR_SAMPLE));
+
+        // A loop pass's worth: a few events, then one dispatch
+        const int batch = 4;
+        host::Cost cost = host::measure(200000, [&] {
+            for (int i = 0; i < batch; i++) bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, "pm", i);
+            bus.dispatch();
+        });
+        char name[32];
+        snprintf(name, sizeof(name), "publish+dispatch x%u", listeners);
+        printf("%-28s %10.1f %8.2f\n", name, cost.ns / batch, cost.allocs / batch);
+    }
+
+    // Subscribed to nothing: what a publish costs a pass with no takers
+    EventBus idle;
+    host::Cost cost = host::measure(1000000, [&] {
+        idle.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, "pm", 1);
+        idle.dispatch();
+    });
+    printf("%-28s %10.1f %8.2f\n", "publish+dispatch x0", cost.ns, cost.allocs);
+
+    // With the /api/events log listening to everything
+    EventBus bus;
+    EventLog log;
+    log.begin(bus);
+    cost = host::measure(1000000, [&] {
+        bus.publish(EVENT_TIMER_EXPIRED, SOURCE_TIMER, "t", 1);
+        bus.dispatch();
+    });
+    printf("%-28s %10.1f %8.2f\n", "publish+dispatch to log", cost.ns, cost.allocs);
+    return 0;
+}
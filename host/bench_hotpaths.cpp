@@ -0,0 +1,159 @@
+// The hot paths /api/perf probes on the device, timed on the host with
+// their allocations: state and control page generation, routing, PMS
+// frame parsing and checksum, BME280 formatting, URL decoding and display
+// updates, and a batch of settings against one request per setting. Names match the device probes where there is one.
+//
+//     build/bench_hotpaths                        # table
+//     build/bench_hotpaths --json out.json        # also a snapshot for
+//                                                 # tools/perf_compare.py
+//
+// make bench-check compares a run against bench_baseline.json. Host
+// timings only compare with a baseline from a similar machine; allocation
+// counts compare anywhere.
+
+#include "PmsSensor.h"
+#include "BME280Module.h"
+#include "TextModule.h"
+#include "sketch.h"
+#include "host.h"
+#include <string>
+
+// Settings the page changes together; none switches the display
+static const char* const BATCH_BENCH[] = {
+    "/pomo/set?w=25&b=5",
+    "/weather/unit?u=C",
+    "/clock/config?tz=5.5&fmt=24",
+    "/weather/graph?on=1",
+};
+#define BATCH_BENCH_ACTIONS (sizeof(BATCH_BENCH) / sizeof(BATCH_BENCH[0]))
+
+// Swallows output, so only generating it is timed
+class NullPrint : public Print {
+public:
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t*, size_t size) override { return size; }
+    using Print::write;
+};
+
+template <typename T>
+static T* findModule(const char* name) {
+    for (Module* module : moduleManager.getModules()) {
+        if (strcmp(module->getName(), name) == 0) return static_cast<T*>(module);
+    }
+    return nullptr;
+}
+
+static void pmsFrame(uint8_t frame[PMS_FRAME_LEN], uint16_t pm25) {
+    memset(frame, 0, PMS_FRAME_LEN);
+    frame[0] = 0x42;
+    frame[1] = 0x4D;
+    frame[3] = 28;
+    frame[12] = pm25 >> 8;
+    frame[13] = pm25 & 0xFF;
+    uint16_t sum = 0;
+    for (int i = 0; i < PMS_FRAME_LEN - 2; i++) sum += frame[i];
+    frame[PMS_FRAME_LEN - 2] = sum >> 8;
+    frame[PMS_FRAME_LEN - 1] = sum & 0xFF;
+}
+
+int main(int argc, char** argv) {
+    const char* json = host::snapshotPath(argc, argv);
+
+    host::setLocalTime(9, 30, 0);
+    setup();
+    for (int i = 0; i < 100; i++) {
+        loop();
+        host::advance(10);
+    }
+
+    printf("%-28s %10s %8s %8s\n", "hot path", "ns/op", "allocs", "bytes");
+    NullPrint sink;
+
+    host::probe("web.data.json", 20000, [&] {
+        JsonWriter out(sink);
+        moduleManager.writeData(out);
+    });
+    host::probe("web.data.cbor", 20000, [&] {
+        CborWriter out(sink);
+        moduleManager.writeData(out);
+    });
+    host::probe("web.controls", 20000, [&] { moduleManager.writeWebControls(sink); });
+
+    // A path no module takes walks every one of them, changing nothing
+    RequestArena arena;
+    StrView unrouted("GET /bench/unrouted?x=1 HTTP/1.1");
+    host::probe("web.route", 200000, [&] {
+        arena.reset();
+        moduleManager.handleWebRequest(unrouted, arena);
+    });
+
+    // Whole requests through the server, parsing to the last byte sent;
+    // its allocations are the host socket model's
+    host::probe("http.request", 5000, [&] { sketchRequest("GET /api/data HTTP/1.1\r\nConnection: close\r\n\r\n"); });
+
+    // The same settings as one /api/batch POST, which answers with the new
+    // state, and as a request each plus the /api/data poll that shows it.
+    // Over WiFi every request is also a round trip, which is not counted
+    std::string batch = "POST /api/batch HTTP/1.1\r\nConnection: close\r\nContent-Length: ";
+    std::string body;
+    for (const char* action : BATCH_BENCH) body += std::string(action) + "\n";
+    batch += std::to_string(body.size()) + "\r\n\r\n" + body;
+    if (httpStatus(sketchRequest(batch)) != 200) fprintf(stderr, "http.batch: not applied\n");
+    for (const char* action : BATCH_BENCH) {
+        std::string raw = std::string("GET ") + action + " HTTP/1.1\r\nConnection: close\r\n\r\n";
+        if (httpStatus(sketchRequest(raw)) != 200) fprintf(stderr, "http.single: %s not applied\n", action);
+    }
+    host::Cost batched = host::probe("http.batch", 2000, [&] { sketchRequest(batch); });
+    host::Cost singles = host::probe("http.single", 2000, [&] {
+        for (const char* action : BATCH_BENCH) {
+            sketchRequest(std::string("GET ") + action + " HTTP/1.1\r\nConnection: close\r\n\r\n");
+        }
+        sketchRequest("GET /api/data HTTP/1.1\r\nConnection: close\r\n\r\n");
+    });
+    printf("%-28s %10.1f %10.1f  batch, single\n", "  ns per action", batched.ns / BATCH_BENCH_ACTIONS,
+           singles.ns / BATCH_BENCH_ACTIONS);
+
+    PmsFrameParser parser;
+    uint8_t good[PMS_FRAME_LEN];
+    uint8_t bad[PMS_FRAME_LEN];
+    pmsFrame(good, 12);
+    pmsFrame(bad, 12);
+    bad[20] ^= 0xFF;
+    host::probe("pms.frame", 200000, [&] {
+        for (uint8_t b : good) parser.receive(b);
+    });
+    host::probe("pms.resync", 200000, [&] {
+        for (uint8_t b : bad) parser.receive(b);
+    });
+
+    // The weather zone's update while it shows a reading: format and draw
+    BME280Module* weather = findModule<BME280Module>("Weather");
+    StrView showWeather("GET /module/Weather HTTP/1.1");
+    moduleManager.handleWebRequest(showWeather, arena);
+    host::probe("bme.format", 200000, [&] { weather->update(); });
+
+    StrView encoded("Perf%20run%20%C2%B0%20%21%20the%20quick%20brown%20fox%20jumps%20over%20the%20lazy%20dog");
+    host::probe("text.decode", 200000, [&] {
+        arena.reset();
+        arena.decode(encoded);
+    });
+
+    // One manager pass that scrolls the ticker a column
+    TextModule* text = findModule<TextModule>("TextScroll");
+    std::string message(TEXT_LENGTH_MAX, 'x');
+    text->show(message.c_str(), 1, TEXT_PRIORITY_ALERT, TEXT_MAX_REPEATS);
+    moduleManager.getEventBus().publish(EVENT_MODULE_REQUEST, SOURCE_NONE, "TextScroll");
+    moduleManager.update();
+    host::probe("display.update", 5000, [&] {
+        host::advance(1);
+        moduleManager.update();
+    });
+    if (!text->isActive()) fprintf(stderr, "display.update: the ticker stopped scrolling\n");
+
+    host::probe("loop.total", 5000, [&] {
+        host::advance(1);
+        loop();
+    });
+
+    return json && !host::writeSnapshot(json) ? 1 : 0;
+}
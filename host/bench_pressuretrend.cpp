@@ -0,0 +1,42 @@
+// PressureTrend: one sample kept plus the slope read back, by how full the
+// window is when it arrives. The cost should not grow with the fill and
+// nothing may allocate.
+
+#include "PressureTrend.h"
+#include "host.h"
+
+int main() {
+    // Samples that arrive while the window holds [from, to)
+    struct Stage { const char* name; uint32_t from, to; };
+    const Stage stages[] = {
+        { "filling, first half hour", 0, PRESSURE_MIN_SAMPLES },
+        { "filling, to 3 h", PRESSURE_MIN_SAMPLES, PRESSURE_WINDOW_SAMPLES },
+        { "full, oldest dropped", PRESSURE_WINDOW_SAMPLES, 4 * PRESSURE_WINDOW_SAMPLES },
+    };
+    const int rounds = 5000;
+    double ns[3] = {};
+    PressureTrend trend;
+    volatile float slope = 0;
+    host::Heap before = host::heap();
+    for (int round = 0; round < rounds; round++) {
+        trend.clear();
+        uint32_t sample = 0;
+        for (int s = 0; s < 3; s++) {
+            uint64_t start = host::nanos();
+            for (; sample < stages[s].to; sample++) {
+                trend.add(101300 + (sample * 7 + round) % 50);
+                slope = slope + trend.getTrend();
+            }
+            ns[s] += host::nanos() - start;
+        }
+    }
+    uint64_t allocs = host::heap().allocs - before.allocs;
+
+    printf("%-28s %10s\n", "pressuretrend", "ns/sample");
+    for (int s = 0; s < 3; s++) {
+        uint32_t samples = rounds * (stages[s].to - stages[s].from);
+        printf("%-28s %10.1f\n", stages[s].name, ns[s] / samples);
+    }
+    printf("%-28s %10llu\n", "allocations", (unsigned long long)allocs);
+    return allocs ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+// Loop latency by sensor count: one to SENSOR_BUS_MAX_DEVICES BME280s on
+// one bus under the weather module, five minutes of 1 ms passes each. A
+// register fetch holds the bus for BENCH_READ_US of simulated time, so the
+// slowest pass should stay at one fetch however many sensors share it,
+// while the CPU cost grows only by the per-device bookkeeping. Every
+// sensor should still read once per BME_READ_INTERVAL.
+
+#include "ModuleManager.h"
+#include "BME280Module.h"
+#include "host.h"
+#include <algorithm>
+
+#define BENCH_READ_US 400            // a few registers at 100 kHz
+#define BENCH_PASSES 60000           // a minute of 1 ms passes
+#define BENCH_MINUTES 5
+
+int main() {
+    printf("%-10s %10s %10s %10s %12s %8s\n",
+           "sensors", "cpu ns", "bus us", "worst us", "reads/min", "allocs");
+    hostBme.readMicros = BENCH_READ_US;
+    bool ok = true;
+    static const char* const LABELS[] = { "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8" };
+
+    for (uint8_t count = 1; count <= SENSOR_BUS_MAX_DEVICES; count++) {
+        MD_Parola parola(MD_MAX72XX::FC16_HW, 5, 4);
+        parola.begin(1);
+        ModuleManager manager;
+        manager.addZone(&parola, 0, 3);
+        SensorBus bus("bench");
+        BME280Module* weather = new BME280Module();
+        for (uint8_t i = 0; i < count; i++) {
+            BME280Sensor* sensor = new BME280Sensor({ 0, BME_SDA, BME_SCL, 0x76, LABELS[i] });
+            weather->addSensor(sensor);
+            bus.add(sensor);
+        }
+        manager.addSensorBus(&bus);
+        manager.addModule(weather, 0);
+        manager.getEventBus().publish(EVENT_MODULE_REQUEST, SOURCE_NONE, "Weather");
+
+        // Settle past the first reads, then count from a clean start
+        for (int i = 0; i < 5000; i++) {
+            manager.update();
+            host::advance(1);
+        }
+        uint32_t transactions = bus.getTransactions();
+        uint64_t cpuNs = UINT64_MAX;     // fastest minute, as bench_hotpaths does
+        uint64_t busUs = 0;
+        uint64_t worstUs = 0;
+        host::Heap before = host::heap();
+        for (int minute = 0; minute < BENCH_MINUTES; minute++) {
+            uint64_t minuteNs = 0;
+            for (int i = 0; i < BENCH_PASSES; i++) {
+                uint64_t simStart = host::nowMicros();
+                uint64_t start = host::nanos();
+                manager.update();
+                minuteNs += host::nanos() - start;
+                uint64_t held = host::nowMicros() - simStart;
+                busUs += held;
+                worstUs = std::max(worstUs, held);
+                host::advance(1);
+            }
+            cpuNs = std::min(cpuNs, minuteNs);
+        }
+        uint64_t passes = (uint64_t)BENCH_MINUTES * BENCH_PASSES;
+        uint64_t allocs = host::heap().allocs - before.allocs;
+
+        // Three transactions a read; the passes span their milliseconds
+        // plus the time the bus held
+        double minutes = (passes * 1000.0 + busUs) / 60e6;
+        double readsPerMinute = (bus.getTransactions() - transactions) / 3.0 / count / minutes;
+        printf("%-10u %10.1f %10.1f %10llu %12.1f %8.2f\n", count,
+               (double)cpuNs / BENCH_PASSES, (double)busUs / passes,
+               (unsigned long long)worstUs, readsPerMinute, (double)allocs / passes);
+        if (worstUs > BENCH_READ_US || readsPerMinute < 29 || allocs) {
+            fprintf(stderr, "%u sensors: a pass held the bus for more than one fetch, "
+                            "a sensor fell behind, or the loop allocated\n", count);
+            ok = false;
+        }
+    }
+    hostBme = HostBme();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// 24 h soak through the sketch: a request a second from the dashboard,
+// control and timer paths, PMS frames every second, a BME280 drifting
+// through a day's pressure swing, and loop() sleeping its idle budget in
+// between. Reports the heap hourly and at the end.
+//
+// The host allocator cannot fragment the way the ESP32's does, so the
+// report counts what causes fragmentation there instead: every block
+// allocated inside loop() after setup() (churn), and the live heap at the
+// end of each hour (growth). Churn should be zero, and the harness fails
+// if it is not, or if a request fails or runs out of arena. The live
+// column also moves with the harness's own UART and socket queues, by a
+// few kilobytes either way, so only a steady climb means a leak. The
+// socket model's buffers are allocated before loop() runs and not counted.
+//
+//     build/bench_soak              # the day, hourly lines
+//     build/bench_soak --hours 168  # a week
+
+#include "PmsSensor.h"
+#include "sketch.h"
+#include "host.h"
+#include <Adafruit_BME280.h>
+
+#define SOAK_RESPONSE_MAX 32768      // reserved per socket so its growth is not counted
+
+static const char* const WORKLOAD[] = {
+    "/api/data",
+    "/api/data.cbor",
+    "/api/controls",
+    "/text/show?msg=Soak%20run%20%C2%B0%20%21&speed=25",
+    "/api/events?since=0",
+    "/pomo/set?w=25&b=5",
+    "/clock/config?tz=5.5&fmt=24",
+    "/module/Clock",
+    "/api/timers/add?name=tea%20time&in=240",
+    "/api/timers",
+    "/weather/graph",
+    "/bench/unrouted?x=1",
+};
+
+struct Tally {
+    uint64_t requests = 0;
+    uint64_t failed = 0;             // status 400 or more
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+};
+
+static void pmsFrame(uint8_t frame[PMS_FRAME_LEN], uint16_t pm25) {
+    memset(frame, 0, PMS_FRAME_LEN);
+    frame[0] = 0x42;
+    frame[1] = 0x4D;
+    frame[3] = 28;
+    frame[12] = pm25 >> 8;
+    frame[13] = pm25 & 0xFF;
+    uint16_t sum = 0;
+    for (int i = 0; i < PMS_FRAME_LEN - 2; i++) sum += frame[i];
+    frame[PMS_FRAME_LEN - 2] = sum >> 8;
+    frame[PMS_FRAME_LEN - 1] = sum & 0xFF;
+}
+
+// Runs loop() until the time given, counting what it allocates
+static void runUntil(uint64_t untilMicros, Tally& tally) {
+    host::Heap before = host::heap();
+    while (host::nowMicros() < untilMicros) {
+        uint64_t passStart = host::nowMicros();
+        loop();
+        if (host::nowMicros() == passStart) host::advance(1);
+    }
+    host::Heap after = host::heap();
+    tally.allocs += after.allocs - before.allocs;
+    tally.bytes += after.bytes - before.bytes;
+}
+
+int main(int argc, char** argv) {
+    int hours = 24;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--hours") && i + 1 < argc) hours = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--hours N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    host::setLocalTime(0, 0, 0);
+    setup();
+    // One request first, so the socket model's queue has its block
+    sketchRequest("GET /api/data HTTP/1.1\r\nConnection: close\r\n\r\n");
+    Tally warmup;
+    runUntil(host::nowMicros() + 1000000, warmup);
+
+    printf("%-6s %10s %10s %10s %12s %12s %10s\n",
+           "hour", "requests", "failed", "allocs", "bytes", "live", "arena");
+    const host::Heap start = host::heap();
+    Tally day;
+    uint8_t frame[PMS_FRAME_LEN];
+    const size_t workloadSize = sizeof(WORKLOAD) / sizeof(WORKLOAD[0]);
+
+    for (int hour = 0; hour < hours; hour++) {
+        Tally tally;
+        for (int second = 0; second < 3600; second++) {
+            uint64_t secondStart = host::nowMicros();
+            int64_t t = (int64_t)hour * 3600 + second;
+
+            // 4 hPa swing over the day, and a reading from the PMS
+            hostBme.pressure = 101325.0f + 400.0f * sinf(t * 2 * (float)M_PI / 86400);
+            hostBme.temperature = 21.0f + 3.0f * sinf(t * 2 * (float)M_PI / 86400);
+            pmsFrame(frame, 10 + t % 40);
+            host::feedUart(2, frame, PMS_FRAME_LEN);
+
+            std::string raw = "GET ";
+            raw += WORKLOAD[t % workloadSize];
+            raw += " HTTP/1.1\r\nConnection: close\r\n\r\n";
+            std::shared_ptr<HostSocket> socket = server.connect();
+            socket->in = raw;
+            socket->out.reserve(SOAK_RESPONSE_MAX);
+            runUntil(secondStart + 1000000, tally);
+            tally.requests++;
+            if (httpStatus(socket->out) >= 400) tally.failed++;
+        }
+
+        // Every connection is closed by now and its socket freed
+        int64_t live = host::heap().live - start.live;
+        printf("%-6d %10llu %10llu %10llu %12llu %12lld %10u\n", hour + 1,
+               (unsigned long long)tally.requests, (unsigned long long)tally.failed,
+               (unsigned long long)tally.allocs, (unsigned long long)tally.bytes,
+               (long long)live, (unsigned)http.getArenaPeak());
+        day.requests += tally.requests;
+        day.failed += tally.failed;
+        day.allocs += tally.allocs;
+        day.bytes += tally.bytes;
+    }
+
+    host::Heap end = host::heap();
+    printf("\n%llu requests over %d h, %llu failed\n",
+           (unsigned long long)day.requests, hours, (unsigned long long)day.failed);
+    printf("churn:   %llu allocations, %llu bytes (%.2f per request)\n",
+           (unsigned long long)day.allocs, (unsigned long long)day.bytes,
+           (double)day.allocs / day.requests);
+    printf("growth:  %lld bytes live above the start\n", (long long)(end.live - start.live));
+    printf("arena:   %u bytes at most, %u allocations refused\n",
+           (unsigned)http.getArenaPeak(), (unsigned)http.getArenaFailures());
+    printf("free:    %u bytes, largest block %u\n", ESP.getFreeHeap(), ESP.getMaxAllocHeap());
+
+    bool ok = day.allocs == 0 && day.failed == 0 && http.getArenaFailures() == 0;
+    if (!ok) fprintf(stderr, "soak: the sketch allocated, a request failed, or the arena ran out\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+// Sparkline: one reading added to the ring and its column rendered, by
+// ring size, on a noisy drifting temperature. The cost per reading should
+// not grow with the ring; only the rare rescale re-renders it. Nothing may
+// allocate.
+
+#include "Sparkline.h"
+#include "host.h"
+#include <vector>
+
+static uint32_t nextRandom() {
+    static uint32_t state = 7;
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+template <uint16_t N>
+static void bench(const std::vector<int16_t>& readings) {
+    SampleRing<N> ring;
+    Sparkline<N> spark(2);
+    for (uint16_t i = 0; i < N; i++) {
+        ring.add(readings[i]);
+        spark.update(ring);
+    }
+    uint32_t rebuilds = spark.getRebuilds();
+    size_t i = 0;
+    host::Cost cost = host::measure(readings.size() - 1, [&] {
+        ring.add(readings[i++ % readings.size()]);
+        spark.update(ring);
+    });
+    char name[32];
+    snprintf(name, sizeof(name), "add+update ring %u", N);
+    printf("%-28s %10.1f %8.2f %10.1f\n", name, cost.ns, cost.allocs,
+           (spark.getRebuilds() - rebuilds) * 1e6 / readings.size());
+}
+
+int main() {
+    // 0.1 °C steps around 21.5 °C: a slow drift plus reading noise
+    std::vector<int16_t> readings;
+    int32_t drift = 215 * 16;
+    for (int i = 0; i < 2000000; i++) {
+        drift += (int)(nextRandom() % 7) - 3;
+        readings.push_back(drift / 16 + (int)(nextRandom() % 5) - 2);
+    }
+
+    printf("%-28s %10s %8s %10s\n", "sparkline", "ns/sample", "allocs", "rebuild/M");
+    bench<SENSOR_HISTORY_SIZE>(readings);
+    bench<4 * SENSOR_HISTORY_SIZE>(readings);
+    bench<16 * SENSOR_HISTORY_SIZE>(readings);
+    return 0;
+}
@@ -0,0 +1,140 @@
+// A scrolling message, drawn the old way and the new: before the queue,
+// TextModule handed its text to MD_Parola, which scrolled PA_SCROLL_LEFT
+// by shifting the zone one column each frame and fetching the next glyph
+// from the font as the text ran in, on every pass. Now the message is
+// rasterized once into a bitmap and each frame copies a window of it.
+//
+// The host stub does not animate, so the old path is modelled on
+// MD_PZone's horizontal scroll: the zone shifted left (a read and a write
+// per column), one new column at the right edge, getChar() when a glyph
+// runs out. The real library also keeps per-zone timing and effect state
+// each frame and reads the font from flash, so on the ESP32 the old frame
+// costs more than it does here; the bitmap path does no more than shown.
+//
+// CPU is per frame over a whole pass, on a 4-device zone; the first pass
+// of the new path includes its render. Memory is what holding the message
+// costs: the old module had one 255-byte buffer and a new message
+// replaced the one scrolling; now every queued message takes its length
+// plus one in the shared arena, and the bitmap is fixed.
+
+#include "TextModule.h"
+#include "host.h"
+#include <string>
+
+#define BENCH_DEVICES 4
+#define LEGACY_TEXT_SIZE 255        // the old textMessage[255]
+
+// MD_Parola's PA_SCROLL_LEFT, one displayAnimate() frame at a time
+class ParolaScroll {
+private:
+    MD_MAX72XX* mx;
+    uint16_t first;
+    uint16_t count;
+    const char* next = "";
+    uint8_t glyph[16];
+    uint8_t glyphWidth = 0;
+    uint8_t glyphPos = 0;
+    uint16_t trailing = 0;          // blank columns to scroll the text out
+
+public:
+    ParolaScroll(DisplayZone& zone)
+        : mx(zone.getGraphicObject()), first(zone.getFirstColumn()), count(zone.getColumnCount()) {}
+
+    void start(const char* text) {
+        next = text;
+        glyphWidth = glyphPos = 0;
+        trailing = count;
+    }
+
+    // False once the text has left the zone
+    bool frame() {
+        uint16_t left = first + count - 1;
+        for (uint16_t c = left; c > first; c--) mx->setColumn(c, mx->getColumn(c - 1));
+        mx->setColumn(first, nextColumn());
+        if (glyphPos < glyphWidth || *next) return true;
+        return trailing-- > 0;
+    }
+
+private:
+    uint8_t nextColumn() {
+        if (glyphPos < glyphWidth) return glyph[glyphPos++];
+        if (glyphPos == glyphWidth && glyphWidth > 0) {
+            glyphPos++;
+            return 0;                       // gap between characters
+        }
+        if (!*next) return 0;
+        glyphWidth = mx->getChar((uint8_t)*next++, sizeof(glyph), glyph);
+        glyphPos = 0;
+        return glyph[glyphPos++];
+    }
+};
+
+struct Pass {
+    double ns;                      // per frame
+    uint32_t frames;
+    uint32_t charReads;
+};
+
+static Pass legacyPass(DisplayZone& zone, const char* text) {
+    MD_MAX72XX* mx = zone.getGraphicObject();
+    ParolaScroll scroll(zone);
+    Pass pass = { 0, 0, 0 };
+    host::Cost cost = host::bestOf(200, [&] {
+        uint32_t reads = mx->charReads;
+        scroll.start(text);
+        pass.frames = 0;
+        while (scroll.frame()) pass.frames++;
+        pass.charReads = mx->charReads - reads;
+    });
+    pass.ns = cost.ns / pass.frames;
+    return pass;
+}
+
+// As TextModule: render when the message reaches the head, then a window
+// per frame from -zone width to the end of the bitmap
+static Pass bitmapPass(DisplayZone& zone, const char* text, bool render) {
+    static uint8_t columns[TEXT_COLUMNS_MAX];
+    MD_MAX72XX* mx = zone.getGraphicObject();
+    uint16_t width = zone.renderText(text, columns, TEXT_COLUMNS_MAX);
+    Pass pass = { 0, 0, 0 };
+    host::Cost cost = host::bestOf(200, [&] {
+        uint32_t reads = mx->charReads;
+        if (render) width = zone.renderText(text, columns, TEXT_COLUMNS_MAX);
+        pass.frames = 0;
+        for (int16_t pos = -(int16_t)zone.getColumnCount(); pos <= (int16_t)width; pos++) {
+            zone.drawColumns(columns, width, pos);
+            pass.frames++;
+        }
+        pass.charReads = mx->charReads - reads;
+    });
+    pass.ns = cost.ns / pass.frames;
+    return pass;
+}
+
+static void report(const char* path, size_t length, const Pass& pass, unsigned heldBytes) {
+    printf("%-22s %6zu %10.1f %8u %8u %8u\n", path, length, pass.ns, pass.frames, pass.charReads, heldBytes);
+}
+
+int main() {
+    MD_Parola parola(MD_MAX72XX::FC16_HW, 5, BENCH_DEVICES);
+    parola.begin(1);
+    DisplayZone zone(&parola, 0, 0, BENCH_DEVICES - 1);
+
+    printf("%-22s %6s %10s %8s %8s %8s\n", "text scroll", "chars", "ns/frame", "frames", "getChar", "held B");
+    const size_t lengths[] = { 8, 40, 250, TEXT_LENGTH_MAX };
+    for (size_t length : lengths) {
+        std::string text;
+        for (size_t i = 0; i < length; i++) text += (char)('A' + i % 26);
+        // The old buffer held up to 254 characters, the whole buffer each time
+        if (length < LEGACY_TEXT_SIZE) {
+            report("Parola, every pass", length, legacyPass(zone, text.c_str()), LEGACY_TEXT_SIZE);
+        }
+        report("bitmap, first pass", length, bitmapPass(zone, text.c_str(), true), length + 1);
+        report("bitmap, repeat", length, bitmapPass(zone, text.c_str(), false), length + 1);
+    }
+
+    printf("\nfixed: old %u B of text, one message; now %u B arena for %u messages"
+           " plus a %u B bitmap (TextModule is %zu B)\n",
+           LEGACY_TEXT_SIZE, TEXT_ARENA_SIZE, TEXT_QUEUE_SIZE, TEXT_COLUMNS_MAX, sizeof(TextModule));
+    return 0;
+}
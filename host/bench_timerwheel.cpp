@@ -0,0 +1,49 @@
+// TimerWheel with 10,000 timers: start+cancel, the per-tick step, and the
+// idle budget the loop asks for every pass. Built without the sketch so the
+// pool can be this large.
+
+#define TIMER_MAX 10000
+#include "TimerWheel.h"
+#include "host.h"
+
+static uint32_t seed = 12345;
+static uint32_t nextRandom() {
+    seed = seed * 1664525 + 1013904223;
+    return seed >> 8;
+}
+
+int main() {
+    printf("%-28s %10s %8s\n", "timerwheel (10k timers)", "ns/op", "allocs");
+    host::setMillis(1000);
+    EventBus bus;
+    static TimerWheel wheel(bus);
+
+    // Repeating, so the wheel stays full while it steps; periods from 10 ms
+    // to 12 h cover every level
+    for (uint16_t i = 0; i < TIMER_MAX - 1; i++) {
+        unsigned long period = 10 + nextRandom() % (12UL * 3600 * 1000);
+        wheel.start("bench", period, period);
+        bus.dispatch();
+    }
+    printf("%-28s %10u\n", "active", wheel.getActiveCount());
+
+    host::Cost cost = host::measure(1000000, [&] {
+        TimerId id = wheel.start("bench", 1000 + nextRandom() % 100000);
+        wheel.cancel(id);
+        bus.dispatch();
+    });
+    printf("%-28s %10.1f %8.2f\n", "start+cancel", cost.ns, cost.allocs);
+
+    cost = host::measure(100000, [&] {
+        host::advance(TIMER_TICK_MS);
+        wheel.update();
+        bus.dispatch();
+    });
+    printf("%-28s %10.1f %8.2f\n", "update, one tick", cost.ns, cost.allocs);
+    printf("%-28s %10lu\n", "fired", (unsigned long)wheel.getFired());
+
+    volatile unsigned long sink = 0;
+    cost = host::measure(100000, [&] { sink = sink + wheel.getIdleBudget(); });
+    printf("%-28s %10.1f %8.2f\n", "getIdleBudget", cost.ns, cost.allocs);
+    return 0;
+}
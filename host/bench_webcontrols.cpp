@@ -0,0 +1,465 @@
+// The control panels (/api/controls) and the state (/api/data), built the
+// old way and the new: before HtmlTemplate and FieldWriter, Pomodoro,
+// Weather and AirQuality grew a static String with += on every call,
+// generateWebControls() concatenated every panel into one more String,
+// and generateJsonData() did the same with each module's getJsonData().
+// Now both stream straight to the client.
+//
+// The sketch no longer has String, so the old path runs on a model of the
+// ESP32 core's WString: strings of up to 11 characters live inline, longer
+// ones on the heap, and every += that outgrows the buffer reallocates it
+// to the exact new length. A literal added to a String is first copied
+// into a temporary, as "a" + String(x) does through StringSumHelper. The
+// old functions are copied from the tree before the change, with the
+// readings the sketch has here. The panels have gained a few controls
+// since, so the new output is a little longer, and /api/data now carries
+// histories and forecasts; the last row writes only the old fields
+// through JsonWriter, byte for byte what the String path built.
+//
+// Peak heap is the most the render held at once above what was live
+// before it; the ESP32's largest free block has to fit the biggest of
+// those allocations.
+
+#include "sketch.h"
+#include "PmsSensor.h"
+#include "host.h"
+#include <Adafruit_BME280.h>
+
+// Counts what it is sent, so only generating the output is timed
+class CountingPrint : public Print {
+public:
+    size_t count = 0;
+    size_t write(uint8_t) override { count++; return 1; }
+    size_t write(const uint8_t*, size_t size) override { count += size; return size; }
+    using Print::write;
+};
+
+// Collects what it is sent
+class StringPrint : public Print {
+public:
+    std::string& text;
+    StringPrint(std::string& into) : text(into) {}
+    size_t write(uint8_t c) override { text += (char)c; return 1; }
+    using Print::write;
+};
+
+namespace legacy {
+
+#define WSTRING_SSO 11              // inline characters, as in the ESP32 core
+
+class String {
+private:
+    char inline_[WSTRING_SSO + 1] = "";
+    char* buffer = inline_;
+    unsigned capacity = WSTRING_SSO;
+    unsigned len = 0;
+
+public:
+    String(const char* text = "") { *this = text; }
+    String(const String& other) { *this = other.c_str(); }
+    explicit String(int value) { number("%d", value); }
+    explicit String(unsigned value) { number("%u", value); }
+    explicit String(long value) { number("%ld", value); }
+    explicit String(unsigned long value) { number("%lu", value); }
+    explicit String(float value, unsigned decimals = 2) {
+        char text[32];
+        snprintf(text, sizeof(text), "%.*f", decimals, value);
+        *this = text;
+    }
+    ~String() {
+        if (buffer != inline_) delete[] buffer;
+    }
+
+    String& operator=(const char* text) {
+        len = 0;
+        return concat(text, strlen(text));
+    }
+    String& operator=(const String& other) { return *this = other.c_str(); }
+    String& operator+=(const char* text) { return concat(text, strlen(text)); }
+    String& operator+=(const String& other) { return concat(other.c_str(), other.len); }
+
+    String& concat(const char* text, unsigned length) {
+        reserve(len + length);
+        memcpy(buffer + len, text, length);
+        len += length;
+        buffer[len] = '\0';
+        return *this;
+    }
+
+    // Grows to exactly size, as changeBuffer()'s realloc does
+    void reserve(unsigned size) {
+        if (size <= capacity) return;
+        char* grown = new char[size + 1];
+        memcpy(grown, buffer, len + 1);
+        if (buffer != inline_) delete[] buffer;
+        buffer = grown;
+        capacity = size;
+    }
+
+    const char* c_str() const { return buffer; }
+    unsigned length() const { return len; }
+
+private:
+    template <typename T>
+    void number(const char* spec, T value) {
+        char text[24];
+        snprintf(text, sizeof(text), spec, value);
+        *this = text;
+    }
+};
+
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const char* text) : String(text) {}
+    StringSumHelper(const String& other) : String(other) {}
+};
+
+inline StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs) {
+    StringSumHelper& sum = const_cast<StringSumHelper&>(lhs);
+    sum += rhs;
+    return sum;
+}
+
+inline StringSumHelper& operator+(const StringSumHelper& lhs, const char* rhs) {
+    StringSumHelper& sum = const_cast<StringSumHelper&>(lhs);
+    sum += rhs;
+    return sum;
+}
+
+// What the old panels and JSON showed
+struct State {
+    int workMin = 25, breakMin = 5;
+    bool weatherReady = true, useCelsius = true;
+    float temperature, humidity, pressure;
+    bool pmsReady = true, warmedUp = true, hasLastValues = true;
+    uint16_t pm1_0 = 0, pm2_5, pm10 = 0;
+    unsigned long laserOnTotalMs = 600000;
+};
+
+static State state;
+
+static String getAQILabel(uint16_t pm25) {
+    if (pm25 <= 12) return "Good";
+    if (pm25 <= 35) return "Moderate";
+    if (pm25 <= 55) return "Unhealthy (Sensitive)";
+    if (pm25 <= 150) return "Unhealthy";
+    if (pm25 <= 250) return "Very Unhealthy";
+    return "Hazardous";
+}
+
+static String getAQIColor(uint16_t pm25) {
+    if (pm25 <= 12) return "#4CAF50";
+    if (pm25 <= 35) return "#FFEB3B";
+    if (pm25 <= 55) return "#FF9800";
+    if (pm25 <= 150) return "#F44336";
+    if (pm25 <= 250) return "#9C27B0";
+    return "#880E4F";
+}
+
+static const char* pomodoroControls() {
+    static String html;
+    html = "<div style=\"border-left: 5px solid #FF9800;\">";
+    html += "<h3>🍅 Pomodoro</h3>";
+    html += "<p style=\"margin:5px 0;\"><label>Work: <span id=\"wv\">" + String(state.workMin) + "</span> min</label><br>";
+    html += "<input type=\"range\" id=\"ws\" min=\"5\" max=\"60\" value=\"" + String(state.workMin) + "\" ";
+    html += "oninput=\"document.getElementById('wv').textContent=this.value\" ";
+    html += "onchange=\"sendRequest('/pomo/set?w='+this.value)\"></p>";
+    html += "<p style=\"margin:5px 0;\"><label>Break: <span id=\"bv\">" + String(state.breakMin) + "</span> min</label><br>";
+    html += "<input type=\"range\" id=\"bs\" min=\"1\" max=\"30\" value=\"" + String(state.breakMin) + "\" ";
+    html += "oninput=\"document.getElementById('bv').textContent=this.value\" ";
+    html += "onchange=\"sendRequest('/pomo/set?b='+this.value)\"></p>";
+    html += "<button class=\"pomo\" onclick=\"sendRequest('/pomo/work')\">Start Work</button>";
+    html += "<button class=\"pomo\" style=\"background:#8BC34A;\" onclick=\"sendRequest('/pomo/break')\">Start Break</button>";
+    html += "<button class=\"stop\" onclick=\"sendRequest('/pomo/stop')\">Stop</button>";
+    html += "</div>";
+    return html.c_str();
+}
+
+static const char* weatherControls() {
+    static String html;
+    html = "<div style=\"border-left: 5px solid #00BCD4;\">";
+    html += "<h3>🌡️ Weather Station</h3>";
+
+    if (!state.weatherReady) {
+        html += "<p style=\"color:#f44336;\">Sensor not detected. Check wiring.</p>";
+    } else {
+        html += "<p>Temp: <strong>" + String(state.temperature, 1);
+        html += state.useCelsius ? " °C" : " °F";
+        html += "</strong></p>";
+        html += "<p>Humidity: <strong>" + String(state.humidity, 1) + " %</strong></p>";
+        html += "<p>Pressure: <strong>" + String(state.pressure, 1) + " hPa</strong></p>";
+    }
+
+    html += "<label><input type=\"radio\" name=\"unit\" value=\"C\"";
+    if (state.useCelsius) html += " checked";
+    html += "> °C</label> ";
+    html += "<label><input type=\"radio\" name=\"unit\" value=\"F\"";
+    if (!state.useCelsius) html += " checked";
+    html += "> °F</label>";
+    html += "<button class=\"alt\" onclick=\"sendRequest('/weather/unit?u=' + document.querySelector('input[name=\\\"unit\\\"]:checked').value)\">Set Unit</button>";
+    html += "<button onclick=\"sendRequest('/weather/activate')\">Show Weather</button>";
+    html += "</div>";
+    return html.c_str();
+}
+
+static const char* airQualityControls() {
+    static String html;
+    html = "<div style=\"border-left: 5px solid #8BC34A;\">";
+    html += "<h3>🌬️ Air Quality (PMSA003)</h3>";
+
+    if (!state.pmsReady && !state.hasLastValues) {
+        html += "<p>Sensor is sleeping to extend lifespan.</p>";
+    } else if (state.pmsReady && !state.warmedUp && !state.hasLastValues) {
+        html += "<p>Warming up... please wait.</p>";
+    } else {
+        String aqiLabel = getAQILabel(state.pm2_5);
+        String aqiColor = getAQIColor(state.pm2_5);
+        html += "<p style=\"color:" + aqiColor + "; font-size:1.2em;\"><strong>" + aqiLabel + "</strong></p>";
+        html += "<p>PM1.0: <strong>" + String(state.pm1_0) + " µg/m³</strong></p>";
+        html += "<p>PM2.5: <strong>" + String(state.pm2_5) + " µg/m³</strong></p>";
+        html += "<p>PM10: <strong>" + String(state.pm10) + " µg/m³</strong></p>";
+    }
+
+    html += "<button onclick=\"sendRequest('/aqi/activate')\">Wake &amp; Show</button>";
+    html += "<button class=\"stop\" onclick=\"sendRequest('/aqi/sleep')\">Sleep Sensor</button>";
+    html += "</div>";
+    return html.c_str();
+}
+
+static const char* webControls(Module* module) {
+    const char* name = module->getName();
+    if (!strcmp(name, "Pomodoro")) return pomodoroControls();
+    if (!strcmp(name, "Weather")) return weatherControls();
+    if (!strcmp(name, "AirQuality")) return airQualityControls();
+    return module->getWebControls();
+}
+
+static String generateWebControls() {
+    String controls = "";
+
+    // Add module selector
+    controls += "<div style=\"border-left: 5px solid #4CAF50;\">";
+    controls += "<h3>📱 Modules</h3>";
+
+    for (Module* module : moduleManager.getModules()) {
+        String moduleName = module->getName();
+        controls += "<button onclick=\"sendRequest('/module/" + moduleName + "')\">";
+        if (!strcmp(module->getName(), "Clock")) {
+            controls += "✓ " + moduleName;
+        } else {
+            controls += moduleName;
+        }
+        controls += "</button>";
+    }
+    controls += "</div>";
+
+    // Add each module's controls
+    for (Module* module : moduleManager.getModules()) {
+        controls += webControls(module);
+    }
+
+    return controls;
+}
+
+static String jsonData(Module* module) {
+    const char* name = module->getName();
+    if (!strcmp(name, "Clock")) {
+        String json = "{\"time\":\"";
+        json += "9:30";
+        json += "\",\"date\":\"";
+        json += "Mon 05";
+        json += "\"}";
+        return json;
+    }
+    if (!strcmp(name, "Pomodoro")) {
+        int mins = 0, secs = 0;
+        String json = "{\"run\":" + String(0) + ",\"work\":" + String(1) +
+                      ",\"min\":" + String(mins) + ",\"sec\":" + String(secs) +
+                      ",\"wm\":" + String(state.workMin) + ",\"bm\":" + String(state.breakMin) + "}";
+        return json;
+    }
+    if (!strcmp(name, "Weather")) {
+        float t = state.useCelsius ? state.temperature : (state.temperature * 9.0 / 5.0 + 32.0);
+        String json = "{\"t\":" + String(t, 1) + ",\"h\":" + String(state.humidity, 1) +
+                      ",\"p\":" + String(state.pressure, 1) + ",\"u\":\"" + String(state.useCelsius ? "C" : "F") +
+                      "\",\"ok\":" + String(state.weatherReady ? 1 : 0) + "}";
+        return json;
+    }
+    if (!strcmp(name, "AirQuality")) {
+        int secs = 0;
+        long age = 4, next = 0;
+        String json = "{\"pm1\":" + String(state.pm1_0) + ",\"pm25\":" + String(state.pm2_5) +
+                      ",\"pm10\":" + String(state.pm10) + ",\"on\":" + String(1) +
+                      ",\"warm\":" + String(state.warmedUp ? 1 : 0) + ",\"sec\":" + String(secs) +
+                      ",\"age\":" + String(age) + ",\"next\":" + String(next) +
+                      ",\"laser\":" + String(state.pmsReady ? 1 : 0) +
+                      ",\"duty\":" + String(state.laserOnTotalMs / 1000) + "}";
+        return json;
+    }
+    return "";
+}
+
+static String generateJsonData() {
+    String json = "{\"active\":\"";
+    json += "Clock";
+    json += "\"";
+
+    for (Module* module : moduleManager.getModules()) {
+        String data = jsonData(module);
+        if (data.length() > 0) {
+            json += ",\"";
+            json += module->getName();
+            json += "\":";
+            json += data;
+        }
+    }
+
+    json += "}";
+    return json;
+}
+
+// generateJsonData()'s output, written through FieldWriter
+static void writeData(FieldWriter& out) {
+    out.beginObject();
+    out.writeString("active", "Clock");
+    for (Module* module : moduleManager.getModules()) {
+        const char* name = module->getName();
+        if (!strcmp(name, "Clock")) {
+            out.beginObject(name);
+            out.writeString("time", "9:30");
+            out.writeString("date", "Mon 05");
+            out.endObject();
+        } else if (!strcmp(name, "Pomodoro")) {
+            out.beginObject(name);
+            out.writeInt("run", 0);
+            out.writeInt("work", 1);
+            out.writeInt("min", 0);
+            out.writeInt("sec", 0);
+            out.writeInt("wm", state.workMin);
+            out.writeInt("bm", state.breakMin);
+            out.endObject();
+        } else if (!strcmp(name, "Weather")) {
+            out.beginObject(name);
+            out.writeFloat("t", state.temperature, 1);
+            out.writeFloat("h", state.humidity, 1);
+            out.writeFloat("p", state.pressure, 1);
+            out.writeString("u", state.useCelsius ? "C" : "F");
+            out.writeInt("ok", state.weatherReady ? 1 : 0);
+            out.endObject();
+        } else if (!strcmp(name, "AirQuality")) {
+            out.beginObject(name);
+            out.writeInt("pm1", state.pm1_0);
+            out.writeInt("pm25", state.pm2_5);
+            out.writeInt("pm10", state.pm10);
+            out.writeInt("on", 1);
+            out.writeInt("warm", state.warmedUp ? 1 : 0);
+            out.writeInt("sec", 0);
+            out.writeInt("age", 4);
+            out.writeInt("next", 0);
+            out.writeInt("laser", state.pmsReady ? 1 : 0);
+            out.writeInt("duty", state.laserOnTotalMs / 1000);
+            out.endObject();
+        }
+    }
+    out.endObject();
+}
+
+} // namespace legacy
+
+struct Render {
+    host::Cost cost;
+    int64_t peakHeap;
+    size_t bytes;
+};
+
+template <typename F>
+static Render render(CountingPrint& sink, F fn) {
+    Render r;
+    sink.count = 0;
+    fn();
+    r.bytes = sink.count;
+    host::resetHeapPeak();
+    host::Heap before = host::heap();
+    fn();
+    r.peakHeap = host::heap().peak - before.live;
+    r.cost = host::bestOf(20000, fn);
+    return r;
+}
+
+static void report(const char* name, const Render& r) {
+    printf("%-24s %10.1f %8.2f %10.1f %10lld %8zu\n", name, r.cost.ns, r.cost.allocs, r.cost.bytes,
+           (long long)r.peakHeap, r.bytes);
+}
+
+static void pmsFrame(uint8_t frame[PMS_FRAME_LEN], uint16_t pm25) {
+    memset(frame, 0, PMS_FRAME_LEN);
+    frame[0] = 0x42;
+    frame[1] = 0x4D;
+    frame[3] = 28;
+    frame[12] = pm25 >> 8;
+    frame[13] = pm25 & 0xFF;
+    uint16_t sum = 0;
+    for (int i = 0; i < PMS_FRAME_LEN - 2; i++) sum += frame[i];
+    frame[PMS_FRAME_LEN - 2] = sum >> 8;
+    frame[PMS_FRAME_LEN - 1] = sum & 0xFF;
+}
+
+int main() {
+    // The same readings for both: a BME280 and a PMS frame a second for
+    // long enough to warm up and sample
+    hostBme.temperature = 21.4f;
+    hostBme.humidity = 45.2f;
+    hostBme.pressure = 101320.0f;
+    legacy::state.temperature = 21.4f;
+    legacy::state.humidity = 45.2f;
+    legacy::state.pressure = 1013.2f;
+    legacy::state.pm2_5 = 12;
+
+    host::setLocalTime(9, 30, 0);
+    setup();
+    uint8_t frame[PMS_FRAME_LEN];
+    pmsFrame(frame, legacy::state.pm2_5);
+    for (int second = 0; second < 120; second++) {
+        host::feedUart(2, frame, PMS_FRAME_LEN);
+        for (int i = 0; i < 100; i++) {
+            loop();
+            host::advance(10);
+        }
+    }
+
+    CountingPrint sink;
+    printf("%-24s %10s %8s %10s %10s %8s\n", "render", "ns", "allocs", "alloc B", "peak heap", "out B");
+    report("controls, String +=", render(sink, [&] {
+        legacy::String controls = legacy::generateWebControls();
+        sink.print(controls.c_str());
+    }));
+    report("controls, streamed", render(sink, [&] { moduleManager.writeWebControls(sink); }));
+    report("data, String +=", render(sink, [&] {
+        legacy::String json = legacy::generateJsonData();
+        sink.print(json.c_str());
+    }));
+    report("data, JsonWriter", render(sink, [&] {
+        JsonWriter json(sink);
+        moduleManager.writeData(json);
+    }));
+    // The old JSON's fields through FieldWriter, the same bytes as the
+    // String path; the sketch's /api/data now reports more
+    std::string fromString, fromWriter;
+    {
+        legacy::String json = legacy::generateJsonData();
+        fromString = json.c_str();
+        StringPrint out(fromWriter);
+        JsonWriter writer(out);
+        legacy::writeData(writer);
+    }
+    report("  old fields, JsonWriter", render(sink, [&] {
+        JsonWriter json(sink);
+        legacy::writeData(json);
+    }));
+    if (fromString != fromWriter) {
+        fprintf(stderr, "bench_webcontrols: the two old-field renders differ\n%s\n%s\n",
+                fromString.c_str(), fromWriter.c_str());
+        return 1;
+    }
+    return 0;
+}
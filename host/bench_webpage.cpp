@@ -0,0 +1,115 @@
+// The dashboard page, served the old way and the new: the old
+// generateWebPage() copied the raw page into a String on every request
+// and sent it uncompressed; now the gzip bytes in WebAssets.h go out
+// straight from flash. Both run through HttpServer on the host sockets.
+//
+// Time to first byte is host CPU time from the request arriving to the
+// first byte written. Transfer is counted in TCP segments and in round
+// trips, since the ESP32's lwIP sends at most TCP_SND_BUF (4 segments of
+// 1436 bytes) before it waits for an ACK; over WiFi those round trips,
+// not the CPU, set how long the page takes.
+//
+// The old page is rebuilt from web/ unminified, the same text the raw
+// string held, so run this from host/ (make bench does).
+
+#include "HttpServer.h"
+#include "WebAssets.h"
+#include "host.h"
+#include <fstream>
+#include <sstream>
+
+#define BENCH_MSS 1436
+#define BENCH_SEND_WINDOW (4 * BENCH_MSS)
+
+static WiFiServer listener(80);
+static HttpServer http(listener);
+static std::string rawPage;
+static bool legacy = false;
+
+static std::string readWeb(const char* name) {
+    std::ifstream file(std::string("../web/") + name);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+// web/index.html with its stylesheet and script inlined, unminified
+static std::string buildRawPage() {
+    std::string page = readWeb("index.html");
+    const char* const links[][2] = {
+        { "<link rel=\"stylesheet\" href=\"style.css\">", "style.css" },
+        { "<script src=\"app.js\"></script>", "app.js" },
+    };
+    for (auto& link : links) {
+        size_t at = page.find(link[0]);
+        if (at == std::string::npos) return "";
+        bool style = strstr(link[1], ".css") != nullptr;
+        std::string inlined = (style ? "<style>\n" : "<script>\n") + readWeb(link[1]) +
+                              (style ? "</style>" : "</script>");
+        page.replace(at, strlen(link[0]), inlined);
+    }
+    return page;
+}
+
+static void handle(HttpRequest& request, HttpResponse& response) {
+    if (legacy) {
+        // As generateWebPage() did: a heap copy of the page per request
+        std::string page = rawPage;
+        response.send(200, "text/html; charset=UTF-8", page.c_str());
+        return;
+    }
+    response.send(200, INDEX_HTML_TYPE, INDEX_HTML_GZ, INDEX_HTML_GZ_LEN, "Content-Encoding: gzip\r\n");
+}
+
+struct Served {
+    double ttfbNs;
+    double totalNs;
+    double allocs;
+    int64_t peakHeap;
+    size_t wireBytes;
+};
+
+static Served serve(int requests) {
+    Served best = { 1e18, 1e18, 0, 0, 0 };
+    for (int i = 0; i < requests; i++) {
+        std::shared_ptr<HostSocket> socket = listener.connect();
+        socket->in = "GET / HTTP/1.1\r\nConnection: close\r\n\r\n";
+        socket->out.reserve(32768);
+        host::resetHeapPeak();
+        host::Heap before = host::heap();
+        uint64_t start = host::nanos();
+        http.update();
+        uint64_t end = host::nanos();
+        host::Heap after = host::heap();
+        best.ttfbNs = std::min(best.ttfbNs, (double)(socket->firstWriteNanos - start));
+        best.totalNs = std::min(best.totalNs, (double)(end - start));
+        best.allocs = after.allocs - before.allocs;
+        best.peakHeap = after.peak - before.live;
+        best.wireBytes = socket->out.size();
+    }
+    return best;
+}
+
+static void report(const char* name, const Served& s) {
+    size_t segments = (s.wireBytes + BENCH_MSS - 1) / BENCH_MSS;
+    size_t roundTrips = (s.wireBytes + BENCH_SEND_WINDOW - 1) / BENCH_SEND_WINDOW;
+    printf("%-16s %10.0f %10.0f %8.0f %10lld %8zu %6zu %6zu\n", name, s.ttfbNs, s.totalNs,
+           s.allocs, (long long)s.peakHeap, s.wireBytes, segments, roundTrips);
+}
+
+int main() {
+    rawPage = buildRawPage();
+    if (rawPage.empty()) {
+        fprintf(stderr, "bench_webpage: cannot read ../web/, run from host/\n");
+        return 1;
+    }
+    http.begin(handle);
+
+    printf("%-16s %10s %10s %8s %10s %8s %6s %6s\n",
+           "dashboard", "ttfb ns", "total ns", "allocs", "peak heap", "bytes", "segs", "rtts");
+    legacy = true;
+    report("String, raw", serve(2000));
+    legacy = false;
+    report("flash, gzip", serve(2000));
+    return 0;
+}
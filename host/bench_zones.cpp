@@ -0,0 +1,59 @@
+// One display frame, ModuleManager::update(), as the chain grows from 4
+// to 16 cascaded devices split into 1 to 4 zones. Every zone shows a
+// clock; with more than one, the last also scrolls a ticker message over
+// it a column every BENCH_SCROLL_MS. Probes are named
+// zones.<zones>x<devices> and compared by make bench-check.
+//
+//     build/bench_zones                   # table
+//     build/bench_zones --json out.json   # also a snapshot
+
+#include "ModuleManager.h"
+#include "ClockModule.h"
+#include "TextModule.h"
+#include "host.h"
+#include <string>
+
+#define BENCH_FRAMES 50000
+#define BENCH_SCROLL_MS 10
+
+static void frames(uint8_t zoneCount, uint8_t devices) {
+    MD_Parola parola(MD_MAX72XX::FC16_HW, 5, devices);
+    parola.begin(zoneCount);
+    ModuleManager manager;
+    uint8_t perZone = devices / zoneCount;
+    for (uint8_t z = 0; z < zoneCount; z++) {
+        manager.addZone(&parola, z * perZone, (z + 1) * perZone - 1);
+        manager.addModule(new ClockModule(), z);
+    }
+    // A column every BENCH_SCROLL_MS keeps it scrolling through every run
+    TextModule* text = nullptr;
+    if (zoneCount > 1) {
+        text = new TextModule();
+        manager.addModule(text, zoneCount - 1);
+        std::string message(TEXT_LENGTH_MAX, 'x');
+        text->show(message.c_str(), BENCH_SCROLL_MS, TEXT_PRIORITY_ALERT, TEXT_MAX_REPEATS);
+        manager.getEventBus().publish(EVENT_MODULE_REQUEST, SOURCE_NONE, "TextScroll");
+    }
+    manager.update();
+
+    char name[32];
+    snprintf(name, sizeof(name), "zones.%ux%u", zoneCount, devices);
+    host::probe(name, BENCH_FRAMES, [&] {
+        host::advance(1);
+        manager.update();
+    });
+    if (text && !text->isActive()) fprintf(stderr, "%s: the ticker stopped scrolling\n", name);
+}
+
+int main(int argc, char** argv) {
+    const char* json = host::snapshotPath(argc, argv);
+    host::setLocalTime(9, 30, 0);
+
+    printf("%-28s %10s %8s %8s\n", "display frame", "ns/frame", "allocs", "bytes");
+    const uint8_t deviceCounts[] = { 4, 8, 12, 16 };
+    const uint8_t zoneCounts[] = { 1, 2, 4 };
+    for (uint8_t devices : deviceCounts) {
+        for (uint8_t zones : zoneCounts) frames(zones, devices);
+    }
+    return json && !host::writeSnapshot(json) ? 1 : 0;
+}
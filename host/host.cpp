@@ -0,0 +1,182 @@
+// Definitions behind the stubs in host/stubs and the harness in host.h
+
+#include "host.h"
+#include <WiFi.h>
+#include <Adafruit_BME280.h>
+#include <cstdarg>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+HardwareSerial Serial(0);
+EspClass ESP;
+TwoWire Wire(0);
+TwoWire Wire1(1);
+WiFiClass WiFi;
+HostBme hostBme;
+
+namespace host {
+
+bool verbose = getenv("HOST_VERBOSE") != nullptr;
+
+static uint64_t clockMicros = 0;
+static bool wallClockSet = false;
+static uint64_t wallClockBase = 0;   // seconds into the day at clockMicros 0
+
+static Heap counters = {};
+static int failures = 0;
+static int checks = 0;
+
+void setMillis(uint64_t ms) { clockMicros = ms * 1000; }
+void advance(unsigned long ms) { clockMicros += (uint64_t)ms * 1000; }
+void advanceMicros(unsigned long us) { clockMicros += us; }
+uint64_t nowMicros() { return clockMicros; }
+
+void setLocalTime(int hour, int minute, int second) {
+    wallClockSet = true;
+    wallClockBase = hour * 3600 + minute * 60 + second - clockMicros / 1000000;
+}
+
+static std::deque<uint8_t> uarts[3];
+
+std::deque<uint8_t>& uartInput(int port) { return uarts[port < 0 || port > 2 ? 0 : port]; }
+
+void feedUart(int port, const uint8_t* data, size_t len) {
+    std::deque<uint8_t>& rx = uartInput(port);
+    rx.insert(rx.end(), data, data + len);
+}
+
+Heap heap() { return counters; }
+void resetHeapPeak() { counters.peak = counters.live; }
+
+bool check(bool ok, const char* expr, const char* file, int line) {
+    checks++;
+    if (!ok) {
+        failures++;
+        fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+    return ok;
+}
+
+int finish(const char* name) {
+    printf("%s: %d checks, %d failed\n", name, checks, failures);
+    return failures ? 1 : 0;
+}
+
+struct Probe {
+    std::string name;
+    uint32_t iterations;
+    Cost cost;
+};
+
+static std::vector<Probe> probes;
+
+const char* snapshotPath(int argc, char** argv) {
+    if (argc == 1) return nullptr;
+    if (argc == 3 && !strcmp(argv[1], "--json")) return argv[2];
+    fprintf(stderr, "usage: %s [--json out.json]\n", argv[0]);
+    exit(2);
+}
+
+void probe(const char* name, uint32_t iterations, const Cost& cost) {
+    probes.push_back({ name, iterations, cost });
+    printf("%-28s %10.1f %8.2f %8.1f\n", name, cost.ns, cost.allocs, cost.bytes);
+}
+
+bool writeSnapshot(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "%s: cannot write\n", path);
+        return false;
+    }
+    fprintf(f, "{\n  \"host\": 1,\n  \"probes\": {\n");
+    for (size_t i = 0; i < probes.size(); i++) {
+        const Probe& p = probes[i];
+        fprintf(f, "    \"%s\": {\"n\": %u, \"ns\": %.0f, \"allocs\": %.2f, \"bytes\": %.0f}%s\n",
+                p.name.c_str(), p.iterations, p.cost.ns, p.cost.allocs, p.cost.bytes,
+                i + 1 < probes.size() ? "," : "");
+    }
+    fprintf(f, "  }\n}\n");
+    fclose(f);
+    return true;
+}
+
+} // namespace host
+
+// Heap counters. The size is kept in front of each block so delete can
+// subtract it from the live total.
+static const size_t HEADER = alignof(std::max_align_t);
+
+void* operator new(size_t size) {
+    char* block = (char*)malloc(size + HEADER);
+    if (!block) throw std::bad_alloc();
+    *(size_t*)block = size;
+    host::counters.allocs++;
+    host::counters.bytes += size;
+    host::counters.live += size;
+    if (host::counters.live > host::counters.peak) host::counters.peak = host::counters.live;
+    return block + HEADER;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    char* block = (char*)p - HEADER;
+    host::counters.live -= *(size_t*)block;
+    free(block);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+unsigned long millis() { return (uint32_t)(host::clockMicros / 1000); }
+unsigned long micros() { return (uint32_t)host::clockMicros; }
+void delay(unsigned long ms) { host::advance(ms); }
+void yield() {}
+
+static uint8_t pins[64];
+void pinMode(int pin, int mode) {}
+void digitalWrite(int pin, int value) { if (pin >= 0 && pin < 64) pins[pin] = value; }
+int digitalRead(int pin) { return pin >= 0 && pin < 64 ? pins[pin] : 0; }
+
+size_t Print::printf(const char* format, ...) {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (n < 0) return 0;
+    if ((size_t)n >= sizeof(buffer)) n = sizeof(buffer) - 1;
+    return write((const uint8_t*)buffer, n);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (port == 0 && host::verbose) fputc(c, stderr);
+    return 1;
+}
+
+static const uint32_t HOST_HEAP_SIZE = 320 * 1024;
+uint32_t EspClass::getFreeHeap() { return HOST_HEAP_SIZE - host::counters.live; }
+uint32_t EspClass::getMaxAllocHeap() { return getFreeHeap(); }
+uint32_t EspClass::getMinFreeHeap() { return HOST_HEAP_SIZE - host::counters.peak; }
+uint32_t EspClass::getCycleCount() { return (uint32_t)(host::nanos() * 240 / 1000); }
+
+static uint32_t cpuMhz = 240;
+bool setCpuFrequencyMhz(uint32_t mhz) { cpuMhz = mhz; return true; }
+uint32_t getCpuFrequencyMhz() { return cpuMhz; }
+
+void configTime(long gmtOffset, int daylightOffset, const char* server1,
+                const char* server2, const char* server3) {}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+    if (!host::wallClockSet) return false;
+    uint64_t seconds = host::wallClockBase + host::clockMicros / 1000000;
+    memset(info, 0, sizeof(*info));
+    info->tm_hour = seconds / 3600 % 24;
+    info->tm_min = seconds / 60 % 60;
+    info->tm_sec = seconds % 60;
+    info->tm_mday = 1 + seconds / 86400 % 28;
+    info->tm_year = 126;
+    return true;
+}
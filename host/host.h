@@ -0,0 +1,113 @@
+#ifndef HOST_H
+#define HOST_H
+
+// Harness for the host build (host/Makefile): the fake clock behind
+// millis(), process-wide heap counters, test checks and a benchmark timer.
+// Tests, benchmarks and the host tools include this after the sketch
+// headers and link host.cpp.
+
+#include <Arduino.h>
+#include <chrono>
+
+namespace host {
+
+// Fake clock, in microseconds since boot. It only moves when told to, or
+// by delay(); millis() wraps at 2^32 like the ESP32's.
+void setMillis(uint64_t ms);
+void advance(unsigned long ms);
+void advanceMicros(unsigned long us);
+uint64_t nowMicros();
+
+// Wall clock for getLocalTime(): unset (false) until given, then moves
+// with the fake clock
+void setLocalTime(int hour, int minute, int second);
+
+// Bytes arriving on a UART, read by every HardwareSerial on that port
+void feedUart(int port, const uint8_t* data, size_t len);
+
+// Every operator new and delete in the process
+struct Heap {
+    uint64_t allocs;
+    uint64_t bytes;
+    int64_t live;
+    int64_t peak;
+};
+Heap heap();
+void resetHeapPeak();
+
+// Serial console output goes to stderr when set (HOST_VERBOSE=1)
+extern bool verbose;
+
+// Failed checks are printed and counted; finish() reports and returns the
+// process exit code
+bool check(bool ok, const char* expr, const char* file, int line);
+int finish(const char* name);
+
+#define CHECK(cond) host::check((cond), #cond, __FILE__, __LINE__)
+
+// Collects everything printed to it
+class Capture : public Print {
+public:
+    std::string text;
+    size_t write(uint8_t c) override { text += (char)c; return 1; }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        text.append((const char*)buffer, size);
+        return size;
+    }
+    using Print::write;
+};
+
+// Real time, for benchmarks
+inline uint64_t nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Cost {
+    double ns;                   // per call
+    double allocs;
+    double bytes;
+};
+
+// Runs fn iterations times after one warm-up call
+template <typename F>
+Cost measure(uint32_t iterations, F fn) {
+    fn();
+    Heap before = heap();
+    uint64_t start = nanos();
+    for (uint32_t i = 0; i < iterations; i++) fn();
+    uint64_t elapsed = nanos() - start;
+    Heap after = heap();
+    return { (double)elapsed / iterations,
+             (double)(after.allocs - before.allocs) / iterations,
+             (double)(after.bytes - before.bytes) / iterations };
+}
+
+// Fastest of a few runs, which shrugs off the scheduler better than a mean
+template <typename F>
+Cost bestOf(uint32_t iterations, F fn) {
+    Cost cost = measure(iterations, fn);
+    for (int run = 1; run < 5; run++) {
+        Cost again = measure(iterations, fn);
+        if (again.ns < cost.ns) cost = again;
+    }
+    return cost;
+}
+
+// Snapshot benchmarks (make bench-check): each probe is printed as a table
+// row and kept for a tools/perf_compare.py snapshot. snapshotPath() reads
+// the command line ([--json out.json]) and exits on anything else.
+const char* snapshotPath(int argc, char** argv);
+void probe(const char* name, uint32_t iterations, const Cost& cost);
+bool writeSnapshot(const char* path);
+
+template <typename F>
+Cost probe(const char* name, uint32_t iterations, F fn) {
+    Cost cost = bestOf(iterations, fn);
+    probe(name, iterations, cost);
+    return cost;
+}
+
+} // namespace host
+
+#endif // HOST_H
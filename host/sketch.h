@@ -0,0 +1,55 @@
+#ifndef HOST_SKETCH_H
+#define HOST_SKETCH_H
+
+// The globals and entry points of SmartClock.ino, which the host build
+// compiles into build/sketch.o and links into whatever includes this.
+// Call setup() once, then loop() with the fake clock advanced in between;
+// requests go through server.connect().
+
+#include <WiFi.h>
+#include <MD_Parola.h>
+#include "ModuleManager.h"
+#include "HttpServer.h"
+#include "PowerGovernor.h"
+
+extern MD_Parola P;
+extern WiFiServer server;
+extern HttpServer http;
+extern ModuleManager moduleManager;
+extern SensorBus uartBus;
+extern PowerGovernor power;
+
+void setup();
+void loop();
+
+// Sends raw on a new connection and runs loop() until the device answers;
+// returns everything it wrote back
+inline std::string sketchRequest(const std::string& raw) {
+    std::shared_ptr<HostSocket> socket = server.connect();
+    socket->in = raw;
+    for (int pass = 0; pass < 10 && socket->out.empty(); pass++) loop();
+    return socket->out;
+}
+
+inline int httpStatus(const std::string& response) {
+    return response.compare(0, 9, "HTTP/1.1 ") == 0 ? atoi(response.c_str() + 9) : 0;
+}
+
+// The body, with chunked framing removed
+inline std::string httpBody(const std::string& response) {
+    size_t start = response.find("\r\n\r\n");
+    if (start == std::string::npos) return "";
+    start += 4;
+    if (response.find("Transfer-Encoding: chunked") >= start) return response.substr(start);
+    std::string body;
+    while (start < response.size()) {
+        size_t size = strtoul(response.c_str() + start, nullptr, 16);
+        start = response.find("\r\n", start);
+        if (size == 0 || start == std::string::npos) break;
+        body.append(response, start + 2, size);
+        start += 2 + size + 2;
+    }
+    return body;
+}
+
+#endif // HOST_SKETCH_H
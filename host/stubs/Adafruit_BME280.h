@@ -0,0 +1,43 @@
+#ifndef HOST_ADAFRUIT_BME280_H
+#define HOST_ADAFRUIT_BME280_H
+
+#include <Wire.h>
+
+namespace host { void advanceMicros(unsigned long us); }
+
+// Host only: what every stub BME280 reads, and how long one register
+// read holds the bus in simulated time
+struct HostBme {
+    float temperature = 21.5f;
+    float humidity = 45.0f;
+    float pressure = 101325.0f;      // Pa, as the library returns it
+    bool present = true;
+    unsigned long readMicros = 0;
+};
+
+extern HostBme hostBme;
+
+class Adafruit_BME280 {
+public:
+    enum sensor_mode { MODE_SLEEP, MODE_FORCED, MODE_NORMAL };
+    enum sensor_sampling { SAMPLING_NONE, SAMPLING_X1, SAMPLING_X2, SAMPLING_X4, SAMPLING_X8, SAMPLING_X16 };
+    enum sensor_filter { FILTER_OFF, FILTER_X2, FILTER_X4, FILTER_X8, FILTER_X16 };
+    enum standby_duration { STANDBY_MS_0_5, STANDBY_MS_62_5, STANDBY_MS_125, STANDBY_MS_250,
+                            STANDBY_MS_500, STANDBY_MS_1000, STANDBY_MS_10, STANDBY_MS_20 };
+
+    bool begin(uint8_t address, TwoWire* wire) { return hostBme.present; }
+    void setSampling(sensor_mode mode, sensor_sampling t, sensor_sampling p, sensor_sampling h,
+                     sensor_filter filter, standby_duration standby) {}
+
+    float readTemperature() { return read(hostBme.temperature); }
+    float readHumidity() { return read(hostBme.humidity); }
+    float readPressure() { return read(hostBme.pressure); }
+
+private:
+    static float read(float value) {
+        host::advanceMicros(hostBme.readMicros);
+        return value;
+    }
+};
+
+#endif // HOST_ADAFRUIT_BME280_H
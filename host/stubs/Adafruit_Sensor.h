@@ -0,0 +1,4 @@
+#ifndef HOST_ADAFRUIT_SENSOR_H
+#define HOST_ADAFRUIT_SENSOR_H
+
+#endif // HOST_ADAFRUIT_SENSOR_H
@@ -0,0 +1,162 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Just enough of the ESP32 Arduino core to compile the sketch headers on a
+// desktop. Time, UART input, sockets and the LED matrix are fakes driven
+// from host.h; see host/README for what each one models.
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cctype>
+#include <strings.h>
+#include <string>
+#include <deque>
+#include <algorithm>
+#include <time.h>
+
+using std::isnan;
+using std::isinf;
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+
+#define PROGMEM
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define SERIAL_8N1 0
+#define DEC 10
+#define HEX 16
+
+// The fake clock wraps at 2^32 ms like the ESP32's, but unsigned long is
+// 64-bit here, so only code that keeps stamps as uint32_t survives it
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+
+template <typename T>
+T constrain(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t write(const char* s, size_t n) { return write((const uint8_t*)s, n); }
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v, int base = DEC) { return printNumber(base == HEX ? "%x" : "%d", v); }
+    size_t print(unsigned int v, int base = DEC) { return printNumber(base == HEX ? "%x" : "%u", v); }
+    size_t print(long v, int base = DEC) { return printNumber(base == HEX ? "%lx" : "%ld", v); }
+    size_t print(unsigned long v, int base = DEC) { return printNumber(base == HEX ? "%lx" : "%lu", v); }
+    // Arduino's printFloat: half away from zero at the last digit shown
+    size_t print(double v, int digits = 2) {
+        if (std::isnan(v)) return write("nan");
+        if (std::isinf(v)) return write("inf");
+        if (v > 4294967040.0 || v < -4294967040.0) return write("ovf");
+        size_t n = 0;
+        if (v < 0) {
+            n += print('-');
+            v = -v;
+        }
+        double rounding = 0.5;
+        for (int i = 0; i < digits; i++) rounding /= 10.0;
+        v += rounding;
+        unsigned long whole = (uint32_t)v;
+        double rest = v - (double)whole;
+        n += print(whole);
+        if (digits > 0) n += print('.');
+        while (digits-- > 0) {
+            rest *= 10.0;
+            unsigned int digit = (unsigned int)rest;
+            n += print(digit);
+            rest -= digit;
+        }
+        return n;
+    }
+    size_t println() { return print("\r\n"); }
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(T v, int f) { size_t n = print(v, f); return n + println(); }
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    virtual void flush() {}
+
+private:
+    template <typename T> size_t printNumber(const char* format, T v) {
+        char b[24];
+        snprintf(b, sizeof(b), format, v);
+        return write(b);
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long ms) {}
+};
+
+namespace host { std::deque<uint8_t>& uartInput(int port); }
+
+// UART. Port 0 is the console; every port reads the bytes a test queued
+// with host::feedUart()
+class HardwareSerial : public Stream {
+private:
+    int port;
+    std::deque<uint8_t>& rx;
+
+public:
+    explicit HardwareSerial(int uart) : port(uart), rx(host::uartInput(uart)) {}
+    void begin(unsigned long baud, int config = 0, int rxPin = -1, int txPin = -1) {}
+    void end() {}
+    size_t write(uint8_t c) override;
+    using Print::write;
+    int available() override { return rx.size(); }
+    int read() override {
+        if (rx.empty()) return -1;
+        uint8_t b = rx.front();
+        rx.pop_front();
+        return b;
+    }
+    int peek() override { return rx.empty() ? -1 : rx.front(); }
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// Heap figures come from the host allocation counters in host.h
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount();
+};
+
+extern EspClass ESP;
+
+bool setCpuFrequencyMhz(uint32_t mhz);
+uint32_t getCpuFrequencyMhz();
+
+void configTime(long gmtOffset, int daylightOffset, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+#endif // HOST_ARDUINO_H
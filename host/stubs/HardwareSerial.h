@@ -0,0 +1,6 @@
+#ifndef HOST_HARDWARE_SERIAL_H
+#define HOST_HARDWARE_SERIAL_H
+
+#include <Arduino.h>
+
+#endif // HOST_HARDWARE_SERIAL_H
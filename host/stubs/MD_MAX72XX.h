@@ -0,0 +1,42 @@
+#ifndef HOST_MD_MAX72XX_H
+#define HOST_MD_MAX72XX_H
+
+#include <Arduino.h>
+
+// LED matrix as a column buffer; column 0 is the right edge, as on the
+// real chain. Glyphs are 5 columns (3 for a space) of the character code.
+class MD_MAX72XX {
+public:
+    enum moduleType_t { GENERIC_HW, FC16_HW, PAROLA_HW, ICSTATION_HW };
+    enum controlRequest_t { SHUTDOWN, SCANLIMIT, INTENSITY, TEST, DECODE, UPDATE, WRAPAROUND };
+    enum controlValue_t { OFF = 0, ON = 1 };
+
+    static const uint16_t MAX_COLUMNS = 16 * 8;
+
+    MD_MAX72XX(moduleType_t type, uint8_t csPin, uint8_t devices) {}
+
+    bool setColumn(uint16_t c, uint8_t value) {
+        columnWrites++;
+        if (c < MAX_COLUMNS) columns[c] = value;
+        return true;
+    }
+    uint8_t getColumn(uint16_t c) { return c < MAX_COLUMNS ? columns[c] : 0; }
+
+    uint8_t getChar(uint16_t c, uint8_t size, uint8_t* buffer) {
+        charReads++;
+        uint8_t width = c == ' ' ? 3 : 5;
+        for (uint8_t i = 0; i < width && i < size; i++) buffer[i] = (uint8_t)(c + i);
+        return width;
+    }
+
+    bool control(controlRequest_t request, int value) { return true; }
+    bool control(uint8_t first, uint8_t last, controlRequest_t request, int value) { return true; }
+    void clear() { memset(columns, 0, sizeof(columns)); }
+
+    // Host only
+    uint8_t columns[MAX_COLUMNS] = {};
+    uint32_t columnWrites = 0;
+    uint32_t charReads = 0;
+};
+
+#endif // HOST_MD_MAX72XX_H
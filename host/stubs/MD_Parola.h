@@ -0,0 +1,61 @@
+#ifndef HOST_MD_PAROLA_H
+#define HOST_MD_PAROLA_H
+
+#include <MD_MAX72XX.h>
+
+enum textPosition_t { PA_LEFT, PA_CENTER, PA_RIGHT };
+enum textEffect_t { PA_NO_EFFECT, PA_PRINT, PA_SCROLL_UP, PA_SCROLL_DOWN, PA_SCROLL_LEFT, PA_SCROLL_RIGHT };
+
+// Zones animate for a number of displayAnimate() frames: one to print,
+// one per column to scroll the text through. Like the library, one
+// displayAnimate() advances every zone.
+class MD_Parola {
+public:
+    static const uint8_t MAX_ZONES = 16;
+
+    MD_Parola(MD_MAX72XX::moduleType_t type, uint8_t csPin, uint8_t devices)
+        : mx(type, csPin, devices) {}
+
+    bool begin(uint8_t zones = 1) { zoneCount = zones; return true; }
+    bool setZone(uint8_t z, uint8_t first, uint8_t last) { return z < MAX_ZONES; }
+    void setIntensity(uint8_t level) {}
+    void setIntensity(uint8_t z, uint8_t level) {}
+    void displayClear() { mx.clear(); }
+    void displayClear(uint8_t z) {}
+    void displayReset(uint8_t z) {}
+    void print(const char* text) {}
+
+    void displayText(const char* text, textPosition_t align, uint16_t speed, uint16_t pause,
+                     textEffect_t effectIn, textEffect_t effectOut = PA_NO_EFFECT) {
+        displayZoneText(0, text, align, speed, pause, effectIn, effectOut);
+    }
+
+    void displayZoneText(uint8_t z, const char* text, textPosition_t align, uint16_t speed,
+                         uint16_t pause, textEffect_t effectIn, textEffect_t effectOut = PA_NO_EFFECT) {
+        if (z >= MAX_ZONES) return;
+        bool scroll = effectIn == PA_SCROLL_LEFT || effectIn == PA_SCROLL_RIGHT;
+        frames[z] = scroll ? strlen(text) * 6 + 32 : (effectIn == PA_NO_EFFECT ? 0 : 1);
+    }
+
+    // True once every zone has finished
+    bool displayAnimate() {
+        animateCalls++;
+        bool done = true;
+        for (uint8_t z = 0; z < zoneCount; z++) {
+            if (frames[z] > 0) frames[z]--;
+            if (frames[z] > 0) done = false;
+        }
+        return done;
+    }
+
+    bool getZoneStatus(uint8_t z) { return z >= MAX_ZONES || frames[z] == 0; }
+    MD_MAX72XX* getGraphicObject() { return &mx; }
+
+    // Host only
+    MD_MAX72XX mx;
+    uint8_t zoneCount = 1;
+    uint32_t frames[MAX_ZONES] = {};
+    uint32_t animateCalls = 0;
+};
+
+#endif // HOST_MD_PAROLA_H
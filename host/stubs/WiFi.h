@@ -0,0 +1,41 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <WiFiClient.h>
+
+#define WL_CONNECTED 3
+
+class WiFiServer {
+public:
+    explicit WiFiServer(int port) {}
+    void begin() {}
+    void setNoDelay(bool on) {}
+    bool hasClient() { return !pending.empty(); }
+    WiFiClient available() {
+        if (pending.empty()) return WiFiClient();
+        std::shared_ptr<HostSocket> socket = pending.front();
+        pending.pop_front();
+        return WiFiClient(socket);
+    }
+
+    // Host only: a client connecting; keep the socket to talk to the device
+    std::shared_ptr<HostSocket> connect() {
+        pending.push_back(std::make_shared<HostSocket>());
+        return pending.back();
+    }
+
+private:
+    std::deque<std::shared_ptr<HostSocket>> pending;
+};
+
+class WiFiClass {
+public:
+    void begin(const char* ssid, const char* password) {}
+    int status() { return WL_CONNECTED; }
+    IPAddress localIP() { return IPAddress(); }
+    bool setSleep(bool on) { return true; }
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
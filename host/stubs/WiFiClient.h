@@ -0,0 +1,71 @@
+#ifndef HOST_WIFI_CLIENT_H
+#define HOST_WIFI_CLIENT_H
+
+#include <Arduino.h>
+#include <memory>
+#include <chrono>
+
+class IPAddress {
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {}
+    bool fromString(const char* address) { return true; }
+    operator uint32_t() const { return 0; }
+};
+
+// Host only: one TCP connection. The test writes what the peer sends into
+// in and reads the device's replies from out.
+struct HostSocket {
+    std::string in;
+    std::string out;
+    bool connected = true;       // peer side still open
+    bool closed = false;         // device called stop()
+    uint64_t firstWriteNanos = 0;    // real time of the device's first write
+};
+
+class WiFiClient : public Stream {
+private:
+    std::shared_ptr<HostSocket> socket;
+
+public:
+    WiFiClient() {}
+    explicit WiFiClient(std::shared_ptr<HostSocket> s) : socket(s) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t len) override {
+        if (!socket || socket->closed) return 0;
+        if (socket->out.empty()) {
+            socket->firstWriteNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+        socket->out.append((const char*)data, len);
+        return len;
+    }
+    using Print::write;
+
+    int available() override { return socket ? socket->in.size() : 0; }
+    int read() override {
+        uint8_t b;
+        return read(&b, 1) == 1 ? b : -1;
+    }
+    int read(uint8_t* buffer, size_t size) {
+        if (!socket) return 0;
+        size_t n = std::min(size, socket->in.size());
+        memcpy(buffer, socket->in.data(), n);
+        socket->in.erase(0, n);
+        return n;
+    }
+    int peek() override { return socket && !socket->in.empty() ? (uint8_t)socket->in[0] : -1; }
+
+    // Lets go of the socket, as the ESP32's does
+    void stop() {
+        if (socket) socket->closed = true;
+        socket.reset();
+    }
+    uint8_t connected() { return socket && socket->connected && !socket->closed; }
+    operator bool() { return (bool)socket; }
+    void setNoDelay(bool on) {}
+    IPAddress remoteIP() { return IPAddress(); }
+};
+
+#endif // HOST_WIFI_CLIENT_H
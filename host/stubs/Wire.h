@@ -0,0 +1,16 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+    explicit TwoWire(int bus) {}
+    bool begin(int sda, int scl, uint32_t frequency = 0) { return true; }
+    void setClock(uint32_t frequency) {}
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // HOST_WIRE_H
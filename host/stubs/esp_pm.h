@@ -0,0 +1,17 @@
+#ifndef HOST_ESP_PM_H
+#define HOST_ESP_PM_H
+
+typedef int esp_err_t;
+typedef void* esp_pm_lock_handle_t;
+#define ESP_OK 0
+
+typedef enum { ESP_PM_CPU_FREQ_MAX, ESP_PM_APB_FREQ_MAX, ESP_PM_NO_LIGHT_SLEEP } esp_pm_lock_type_t;
+typedef struct { int max_freq_mhz; int min_freq_mhz; bool light_sleep_enable; } esp_pm_config_esp32_t;
+
+inline esp_err_t esp_pm_configure(const void* config) { return ESP_OK; }
+inline esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char* name,
+                                    esp_pm_lock_handle_t* handle) { return ESP_OK; }
+inline esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle) { return ESP_OK; }
+inline esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle) { return ESP_OK; }
+
+#endif // HOST_ESP_PM_H
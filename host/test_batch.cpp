@@ -0,0 +1,66 @@
+// /api/batch: POST only, and nothing applied unless every command is
+// accepted
+
+#include "sketch.h"
+#include "TextModule.h"
+#include "host.h"
+
+static std::string post(const char* body) {
+    char head[128];
+    snprintf(head, sizeof(head), "POST /api/batch HTTP/1.1\r\nContent-Length: %u\r\n\r\n",
+             (unsigned)strlen(body));
+    return sketchRequest(std::string(head) + body);
+}
+
+static std::string data() {
+    return httpBody(sketchRequest("GET /api/data HTTP/1.1\r\n\r\n"));
+}
+
+int main() {
+    setup();
+
+    // A link or prefetch must not apply commands
+    std::string get = sketchRequest("GET /api/batch HTTP/1.1\r\n\r\n");
+    CHECK(httpStatus(get) == 405);
+    CHECK(get.find("Allow: POST") != std::string::npos);
+
+    std::string r = post("/pomo/set?w=40&b=10\n/weather/unit?u=F");
+    CHECK(httpStatus(r) == 200);
+    CHECK(httpBody(r).find("\"wm\":40") != std::string::npos);
+    CHECK(httpBody(r).find("\"u\":\"F\"") != std::string::npos);
+
+    // An unknown command anywhere rejects the whole batch before any runs
+    r = post("/pomo/set?w=25\n/weather/unit?u=C\n/nope");
+    CHECK(httpStatus(r) == 400);
+    CHECK(httpBody(r).find("\"index\":2") != std::string::npos);
+    CHECK(httpBody(r).find("\"applied\":0") != std::string::npos);
+    CHECK(data().find("\"wm\":40") != std::string::npos);
+    CHECK(data().find("\"u\":\"F\"") != std::string::npos);
+
+    // Not a path, or too long: also checked up front
+    r = post("/pomo/set?w=25\nweather/unit?u=C");
+    CHECK(httpStatus(r) == 400);
+    CHECK(data().find("\"wm\":40") != std::string::npos);
+    std::string longCommand = "/text/show?msg=" + std::string(BATCH_MAX_COMMAND, 'x');
+    r = post(("/pomo/set?w=25\n" + longCommand).c_str());
+    CHECK(httpStatus(r) == 400);
+    CHECK(data().find("\"wm\":40") != std::string::npos);
+
+    // /module/<name> switches are accepted without running
+    r = post("/module/Pomodoro\n/pomo/set?w=30");
+    CHECK(httpStatus(r) == 200);
+    CHECK(httpBody(r).find("\"wm\":30") != std::string::npos);
+
+    // A text queue full of urgent messages is only found out when applied:
+    // the commands before it stay applied and the reply says so
+    std::string fill;
+    for (int i = 0; i < TEXT_QUEUE_SIZE; i++) fill += "/text/show?msg=urgent&pri=9\n";
+    post(fill.c_str());
+    r = post("/pomo/set?w=20\n/text/show?msg=late");
+    CHECK(httpStatus(r) == 409);
+    CHECK(httpBody(r).find("\"index\":1") != std::string::npos);
+    CHECK(httpBody(r).find("\"applied\":1") != std::string::npos);
+    CHECK(data().find("\"wm\":20") != std::string::npos);
+
+    return host::finish("test_batch");
+}
@@ -0,0 +1,110 @@
+// EventBus ordering, overflow and re-entrancy, and the /api/events feed
+// built on it
+
+#include "EventLog.h"
+#include "host.h"
+#include <vector>
+
+struct Recorder : EventListener {
+    std::vector<std::pair<int, int>> seen;   // listener id, values[0]
+    int id;
+    EventBus* republish = nullptr;
+    explicit Recorder(int i) : id(i) {}
+    void onEvent(const Event& event) override {
+        seen.push_back({ id, (int)event.values[0] });
+        if (republish && event.topic == EVENT_SENSOR_SAMPLE) {
+            republish->publish(EVENT_TIMER_EXPIRED, SOURCE_TIMER, "from listener", event.values[0]);
+        }
+    }
+};
+
+static std::string feed(EventLog& log, uint32_t since) {
+    host::Capture out;
+    JsonWriter json(out);
+    json.beginObject();
+    log.writeFields(json, since);
+    json.endObject();
+    return out.text;
+}
+
+int main() {
+    // FIFO across topics; each event goes to its subscribers in the order
+    // they subscribed
+    {
+        EventBus bus;
+        std::vector<std::pair<int, int>> order;
+        Recorder a(1), b(2);
+        bus.subscribe(&a, EVENT_MASK(EVENT_SENSOR_SAMPLE) | EVENT_MASK(EVENT_TIMER_EXPIRED));
+        bus.subscribe(&b, EVENT_MASK(EVENT_TIMER_EXPIRED));
+        bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, "pm", 1);
+        bus.publish(EVENT_TIMER_EXPIRED, SOURCE_TIMER, "t", 2);
+        bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_BME280, "t", 3);
+        CHECK(bus.dispatch() == 3);
+        CHECK((a.seen == std::vector<std::pair<int, int>>{ { 1, 1 }, { 1, 2 }, { 1, 3 } }));
+        CHECK((b.seen == std::vector<std::pair<int, int>>{ { 2, 2 } }));
+        CHECK(bus.getDelivered() == 4);
+        CHECK(bus.getPending() == 0);
+    }
+
+    // Full queue: the oldest go, the newest are delivered in order
+    {
+        EventBus bus;
+        Recorder a(1);
+        bus.subscribe(&a, EVENT_MASK(EVENT_SENSOR_SAMPLE));
+        for (int i = 0; i < EVENT_QUEUE_SIZE + 5; i++) bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, "x", i);
+        CHECK(bus.getDropped() == 5);
+        CHECK(bus.getPending() == EVENT_QUEUE_SIZE);
+        bus.dispatch();
+        CHECK(a.seen.size() == EVENT_QUEUE_SIZE);
+        CHECK(a.seen.front().second == 5);
+        CHECK(a.seen.back().second == EVENT_QUEUE_SIZE + 4);
+        CHECK(bus.getPublished() == EVENT_QUEUE_SIZE + 5);
+    }
+
+    // Published during dispatch: queued for the next pass, not delivered
+    // in this one
+    {
+        EventBus bus;
+        Recorder a(1);
+        a.republish = &bus;
+        bus.subscribe(&a, EVENT_MASK(EVENT_SENSOR_SAMPLE) | EVENT_MASK(EVENT_TIMER_EXPIRED));
+        bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, "x", 7);
+        CHECK(bus.dispatch() == 1);
+        CHECK(a.seen.size() == 1);
+        CHECK(bus.getPending() == 1);
+        bus.dispatch();
+        CHECK(a.seen.size() == 2 && a.seen[1].second == 7);
+    }
+
+    // The feed: every event after since once, and a count of those lost
+    {
+        EventBus bus;
+        EventLog log;
+        log.begin(bus);
+        CHECK(feed(log, 0) == "{\"seq\":0,\"lost\":0,\"events\":[]}");
+
+        bus.publish(EVENT_TIMER_EXPIRED, SOURCE_TIMER, "tea", 1);
+        bus.publish(EVENT_MODULE_ACTIVATED, SOURCE_NONE, "Clock");
+        bus.dispatch();
+        std::string first = feed(log, 0);
+        CHECK(first.find("{\"seq\":2,\"lost\":0,") == 0);
+        CHECK(first.find("\"topic\":\"timer_expired\",\"src\":4,\"name\":\"tea\"") != std::string::npos);
+        CHECK(first.find("\"name\":\"Clock\"") != std::string::npos);
+        CHECK(feed(log, 1).find("tea") == std::string::npos);
+        CHECK(feed(log, 2).find("\"events\":[]") != std::string::npos);
+
+        for (int i = 0; i < EVENT_LOG_SIZE + 3; i++) {
+            bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, "pm", i);
+            bus.dispatch();
+        }
+        std::string late = feed(log, 2);
+        CHECK(late.find("\"lost\":3") != std::string::npos);
+        CHECK(late.find("\"seq\":6,") != std::string::npos);     // oldest kept
+        CHECK(late.find("\"seq\":5,") == std::string::npos);
+
+        // A cursor from before a restart starts over
+        CHECK(feed(log, 1000).find("\"lost\":5") != std::string::npos);
+    }
+
+    return host::finish("test_eventbus");
+}
@@ -0,0 +1,274 @@
+// JsonWriter and CborWriter: /api/data and /api/data.cbor decode to the
+// same document. Both are parsed back into one tree and compared, for
+// hand-picked edge cases and for the sketch's own writeData().
+
+#include "sketch.h"
+#include "host.h"
+#include <vector>
+
+struct Value {
+    enum Kind { NUL, NUM, STR, ARR, OBJ } kind = NUL;
+    double num = 0;
+    std::string str;
+    std::vector<std::pair<std::string, Value>> items;   // keys empty in arrays
+};
+
+// --------------------------------------------------------------------------------
+//  JSON, as much as JsonWriter emits
+// --------------------------------------------------------------------------------
+struct JsonParser {
+    const char* p;
+    bool ok = true;
+
+    void skipSpace() { while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') p++; }
+
+    bool expect(char c) {
+        skipSpace();
+        if (*p != c) return ok = false;
+        p++;
+        return true;
+    }
+
+    std::string parseString() {
+        std::string s;
+        if (!expect('"')) return s;
+        while (*p && *p != '"') {
+            if (*p == '\\') {
+                p++;
+                if (*p == 'u') {
+                    s += (char)strtol(std::string(p + 1, 4).c_str(), nullptr, 16);
+                    p += 5;
+                    continue;
+                }
+            }
+            s += *p++;
+        }
+        expect('"');
+        return s;
+    }
+
+    Value parse() {
+        Value v;
+        skipSpace();
+        if (*p == '{' || *p == '[') {
+            bool object = *p == '{';
+            char close = object ? '}' : ']';
+            v.kind = object ? Value::OBJ : Value::ARR;
+            p++;
+            skipSpace();
+            if (*p == close) {
+                p++;
+                return v;
+            }
+            do {
+                std::string key;
+                if (object) {
+                    key = parseString();
+                    expect(':');
+                }
+                v.items.push_back({ key, parse() });
+                skipSpace();
+            } while (ok && *p == ',' && p++);
+            expect(close);
+        } else if (*p == '"') {
+            v.kind = Value::STR;
+            v.str = parseString();
+        } else if (!strncmp(p, "null", 4)) {
+            p += 4;
+        } else {
+            char* end;
+            v.kind = Value::NUM;
+            v.num = strtod(p, &end);
+            if (end == p) ok = false;
+            p = end;
+        }
+        return v;
+    }
+};
+
+// --------------------------------------------------------------------------------
+//  CBOR, as much as CborWriter emits
+// --------------------------------------------------------------------------------
+struct CborParser {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    uint8_t next() {
+        if (p >= end) {
+            ok = false;
+            return 0xFF;
+        }
+        return *p++;
+    }
+
+    uint64_t argument(uint8_t info) {
+        if (info < 24) return info;
+        int bytes = info == 24 ? 1 : info == 25 ? 2 : info == 26 ? 4 : info == 27 ? 8 : 0;
+        if (!bytes) ok = false;
+        uint64_t value = 0;
+        while (bytes--) value = (value << 8) | next();
+        return value;
+    }
+
+    std::string text() {
+        uint8_t head = next();
+        if (head >> 5 != 3) ok = false;
+        uint64_t len = argument(head & 31);
+        if (!ok || len > (uint64_t)(end - p)) {
+            ok = false;
+            return "";
+        }
+        std::string s((const char*)p, len);
+        p += len;
+        return s;
+    }
+
+    Value parse() {
+        Value v;
+        uint8_t head = next();
+        uint8_t major = head >> 5;
+        uint8_t info = head & 31;
+        switch (major) {
+            case 0:
+                v.kind = Value::NUM;
+                v.num = (double)argument(info);
+                break;
+            case 1:
+                v.kind = Value::NUM;
+                v.num = -1.0 - (double)argument(info);
+                break;
+            case 3:
+                p--;
+                v.kind = Value::STR;
+                v.str = text();
+                break;
+            case 4:
+            case 5:
+                // CborWriter streams, so only indefinite lengths
+                if (info != 31) ok = false;
+                v.kind = major == 5 ? Value::OBJ : Value::ARR;
+                while (ok && p < end && *p != 0xFF) {
+                    std::string key = major == 5 ? text() : "";
+                    v.items.push_back({ key, parse() });
+                }
+                next();
+                break;
+            case 7:
+                if (info == 26) {
+                    uint32_t bits = (uint32_t)argument(info);
+                    float f;
+                    memcpy(&f, &bits, sizeof(f));
+                    // JSON has no NaN or Infinity; JsonWriter writes null
+                    if (!std::isnan(f) && !std::isinf(f)) {
+                        v.kind = Value::NUM;
+                        v.num = f;
+                    }
+                } else if (info != 22) {
+                    ok = false;
+                }
+                break;
+            default:
+                ok = false;
+        }
+        return v;
+    }
+};
+
+static bool same(const Value& a, const Value& b, const std::string& path) {
+    bool equal = a.kind == b.kind;
+    if (equal && a.kind == Value::NUM) {
+        // CBOR floats are single precision; JSON prints the rounded value
+        equal = fabs(a.num - b.num) <= 1e-6 * std::max(1.0, fabs(a.num));
+    } else if (equal && a.kind == Value::STR) {
+        equal = a.str == b.str;
+    } else if (equal && (a.kind == Value::ARR || a.kind == Value::OBJ)) {
+        equal = a.items.size() == b.items.size();
+        for (size_t i = 0; equal && i < a.items.size(); i++) {
+            std::string at = path + "/" + (a.items[i].first.empty() ? std::to_string(i) : a.items[i].first);
+            equal = a.items[i].first == b.items[i].first && same(a.items[i].second, b.items[i].second, at);
+            if (!equal) return false;
+        }
+    }
+    if (!equal) fprintf(stderr, "JSON and CBOR differ at %s\n", path.empty() ? "/" : path.c_str());
+    return equal;
+}
+
+static bool roundTrip(void (*write)(FieldWriter&), std::string* jsonText = nullptr) {
+    host::Capture json, cbor;
+    JsonWriter jw(json);
+    CborWriter cw(cbor);
+    write(jw);
+    write(cw);
+
+    JsonParser jp = { json.text.c_str() };
+    Value fromJson = jp.parse();
+    jp.skipSpace();
+    CborParser cp = { (const uint8_t*)cbor.text.data(), (const uint8_t*)cbor.text.data() + cbor.text.size() };
+    Value fromCbor = cp.parse();
+
+    if (jsonText) *jsonText = json.text;
+    return CHECK(jp.ok && *jp.p == 0) && CHECK(cp.ok && cp.p == cp.end) &&
+           CHECK(same(fromJson, fromCbor, ""));
+}
+
+static void edgeCases(FieldWriter& out) {
+    out.beginObject();
+    // Every CBOR head width, both signs
+    const long ints[] = { 0, 1, 23, 24, 255, 256, 65535, 65536, 2147483647L,
+                          -1, -24, -25, -256, -257, -65537, -2147483647L - 1 };
+    out.beginArray("ints");
+    for (long v : ints) out.writeInt(nullptr, v);
+    out.endArray();
+
+    // Exact binary halves, where print() and roundf() must agree
+    out.writeFloat("half", 0.25f, 1);
+    out.writeFloat("negHalf", -0.25f, 1);
+    out.writeFloat("eighth", 2.125f, 2);
+    out.writeFloat("pressure", 1012.74f, 1);
+    out.writeFloat("whole", 7.0f, 0);
+    out.writeFloat("nan", NAN, 1);
+    out.writeFloat("inf", INFINITY, 1);
+
+    out.writeString("quote", "He said \"hi\" \\ bye");
+    out.writeString("control", "tab\there\nline");
+    out.writeString("utf8", "25 \xC2\xB5g/m\xC2\xB3");
+    out.writeString("empty", "");
+
+    out.beginObject("nested");
+    out.beginArray("none");
+    out.endArray();
+    out.beginObject("nothing");
+    out.endObject();
+    out.endObject();
+    out.endObject();
+}
+
+// A module that adds no fields
+class QuietModule : public Module {
+public:
+    void init() override {}
+    void update() override {}
+    void activate() override { active = true; }
+    void deactivate() override { active = false; }
+    const char* getName() override { return "Quiet"; }
+};
+
+int main() {
+    CHECK(roundTrip(edgeCases));
+
+    // The sketch's own document after half an hour of readings
+    host::setLocalTime(10, 42, 0);
+    setup();
+    moduleManager.addModule(new QuietModule());
+    for (int i = 0; i < 18000; i++) {
+        loop();
+        host::advance(100);
+    }
+    std::string json;
+    CHECK(roundTrip([](FieldWriter& out) { moduleManager.writeData(out); }, &json));
+    CHECK(json.find("\"Quiet\":{}") != std::string::npos);
+    CHECK(json.find("\"hist\":[") != std::string::npos);
+
+    return host::finish("test_fieldwriter");
+}
@@ -0,0 +1,32 @@
+// HtmlTemplate: compile-time part counts and rendering every slot
+
+#include "HtmlTemplate.h"
+#include "host.h"
+
+static_assert(htmlTemplateParts("") == 0, "empty");
+static_assert(htmlTemplateParts("plain") == 1, "literal only");
+static_assert(htmlTemplateParts("{{0}}") == 1, "slot only");
+static_assert(htmlTemplateParts("a{{0}}b{{1}}c") == 3, "trailing literal");
+static_assert(htmlTemplateParts("{{x}} {{12}}") == 1, "not slots");
+
+static std::string render12() {
+    // More parts than the old default of 8 the panels were sized with
+    HTML_TEMPLATE(tpl, "<p>{{0}}{{1}}{{2}}{{3}}{{4}}{{5}}{{6}}{{7}}{{8}}{{9}}{{0}}{{1}}</p>");
+    host::Capture out;
+    tpl.render(out, [](Print& o, uint8_t slot) { o.print((int)slot); });
+    return out.text;
+}
+
+int main() {
+    CHECK(render12() == "<p>012345678901</p>");
+    CHECK(render12() == "<p>012345678901</p>");   // compiled once, rendered again
+
+    // A hand-sized template that is too small says so instead of rendering
+    // part of the panel
+    HtmlTemplate<2> small("a{{0}}b{{1}}c");
+    host::Capture out;
+    small.render(out, [](Print& o, uint8_t) { o.print("x"); });
+    CHECK(out.text == "<p>[HtmlTemplate] too many parts</p>");
+
+    return host::finish("test_htmltemplate");
+}
@@ -0,0 +1,109 @@
+// HttpServer: response framing per protocol version, pipelining, and which
+// connection is evicted when every slot is taken
+
+#include "HttpServer.h"
+#include "host.h"
+
+static WiFiServer listener(80);
+static HttpServer http(listener);
+
+static void handle(HttpRequest& request, HttpResponse& response) {
+    if (strstr(request.line, "/stream")) {
+        response.begin(200, "text/plain");
+        for (int i = 0; i < 100; i++) response.printf("line %d\n", i);
+        return;
+    }
+    response.send(200, "text/plain", "fixed");
+}
+
+static std::string expectedStream() {
+    std::string text;
+    for (int i = 0; i < 100; i++) text += "line " + std::to_string(i) + "\n";
+    return text;
+}
+
+static std::shared_ptr<HostSocket> open(const char* raw) {
+    std::shared_ptr<HostSocket> socket = listener.connect();
+    socket->in = raw;
+    http.update();
+    return socket;
+}
+
+static bool has(const std::string& s, const char* part) {
+    return s.find(part) != std::string::npos;
+}
+
+static std::string body(const std::string& response) {
+    size_t start = response.find("\r\n\r\n");
+    return start == std::string::npos ? "" : response.substr(start + 4);
+}
+
+int main() {
+    http.begin(handle);
+
+    // HTTP/1.1: chunked, and the socket stays open for the next request
+    std::shared_ptr<HostSocket> s = open("GET /stream HTTP/1.1\r\n\r\n");
+    CHECK(has(s->out, "Transfer-Encoding: chunked"));
+    CHECK(has(s->out, "Connection: keep-alive"));
+    CHECK(has(s->out, "\r\n0\r\n\r\n"));
+    CHECK(!s->closed);
+    s->connected = false;
+    http.update();
+
+    // HTTP/1.0 cannot parse chunks: the body is sent as is and ends with
+    // the connection
+    s = open("GET /stream HTTP/1.0\r\n\r\n");
+    CHECK(!has(s->out, "Transfer-Encoding"));
+    CHECK(has(s->out, "Connection: close"));
+    CHECK(body(s->out) == expectedStream());
+    CHECK(s->closed);
+
+    // ...even when the 1.0 client asked to keep it open
+    s = open("GET /stream HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+    CHECK(!has(s->out, "Transfer-Encoding"));
+    CHECK(has(s->out, "Connection: close"));
+    CHECK(s->closed);
+
+    // A Content-Length response can keep a 1.0 connection open
+    s = open("GET /fixed HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+    CHECK(has(s->out, "Content-Length: 5"));
+    CHECK(has(s->out, "Connection: keep-alive"));
+    CHECK(!s->closed);
+    s->connected = false;
+    http.update();
+
+    // Pipelined requests in one read are answered in order
+    s = open("GET /fixed HTTP/1.1\r\n\r\nGET /stream HTTP/1.1\r\n\r\n");
+    CHECK(s->out.find("fixed") < s->out.find("line 0"));
+    s->connected = false;
+    http.update();
+
+    // All slots taken: the oldest holds half a request, so the next oldest
+    // idle one is evicted instead
+    std::shared_ptr<HostSocket> slots[HTTP_MAX_CLIENTS];
+    slots[0] = open("GET /fixed HTTP/1.1\r\n");
+    for (int i = 1; i < HTTP_MAX_CLIENTS; i++) {
+        host::advance(100);
+        slots[i] = open("");
+    }
+    host::advance(100);
+    std::shared_ptr<HostSocket> late = open("GET /fixed HTTP/1.1\r\n\r\n");
+    CHECK(!slots[0]->closed);
+    CHECK(slots[1]->closed);
+    CHECK(has(late->out, "200 OK"));
+    CHECK(http.getEvicted() == 1);
+
+    slots[0]->in = "\r\n";
+    http.update();
+    CHECK(has(slots[0]->out, "200 OK"));
+
+    // Every slot mid-request: nothing to evict, so the newcomer gets 503
+    for (std::shared_ptr<HostSocket>& socket : slots) socket->in = "GET /fixed HTTP/1.1\r\n";
+    late->in = "GET /fixed HTTP/1.1\r\n";
+    http.update();
+    std::shared_ptr<HostSocket> refused = open("GET /fixed HTTP/1.1\r\n\r\n");
+    CHECK(has(refused->out, "503"));
+    CHECK(refused->closed);
+
+    return host::finish("test_httpserver");
+}
@@ -0,0 +1,41 @@
+// PerfCounters: probes past PERF_MAX_PROBES are reported, not lost silently
+
+#include "PerfCounters.h"
+#include "host.h"
+#include <string>
+
+static const char* const NAMES[] = {
+    "p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7", "p8", "p9", "p10", "p11", "p12", "p13",
+    "p14", "p15", "p16", "p17", "p18", "p19", "p20", "p21", "p22", "p23", "p24", "p25",
+};
+
+static std::string snapshot() {
+    host::Capture out;
+    JsonWriter json(out);
+    json.beginObject();
+    PerfCounters::instance().writeFields(json);
+    json.endObject();
+    return out.text;
+}
+
+int main() {
+    static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == PERF_MAX_PROBES + 2, "two probes too many");
+    PerfCounters& perf = PerfCounters::instance();
+    CHECK(snapshot().find("\"dropped\":0") != std::string::npos);
+
+    uint8_t ids[PERF_MAX_PROBES + 2];
+    for (int i = 0; i < PERF_MAX_PROBES + 2; i++) ids[i] = perf.probe("test", NAMES[i]);
+    CHECK(ids[PERF_MAX_PROBES - 1] == PERF_MAX_PROBES - 1);
+    CHECK(ids[PERF_MAX_PROBES] == PerfCounters::NONE);
+    CHECK(ids[PERF_MAX_PROBES + 1] == PerfCounters::NONE);
+
+    // Registered probes still count; the dropped ones record nothing
+    perf.record(ids[0], 240, 0);
+    perf.record(ids[PERF_MAX_PROBES], 240, 0);
+    std::string json = snapshot();
+    CHECK(json.find("\"dropped\":2") != std::string::npos);
+    CHECK(json.find("\"test.p0\":{\"n\":1") != std::string::npos);
+    CHECK(json.find("test.p24") == std::string::npos);
+
+    return host::finish("test_perfcounters");
+}
@@ -0,0 +1,125 @@
+// PressureTrend: the running-sum slope matches a plain least-squares fit
+// over the same window on synthetic traces, the tendency and forecast
+// follow it, and a BME280 read that fails (NaN) never reaches the window
+
+#include "BME280Sensor.h"
+#include "host.h"
+#include <vector>
+
+// Least squares over the last window of samples, in hPa per 3 hours
+static double fitTrend(const std::vector<uint32_t>& samples) {
+    size_t n = std::min<size_t>(samples.size(), PRESSURE_WINDOW_SAMPLES);
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < n; i++) {
+        double y = samples[samples.size() - n + i];
+        sx += i;
+        sy += y;
+        sxx += (double)i * i;
+        sxy += i * y;
+    }
+    return (n * sxy - sx * sy) / (n * sxx - sx * sx) * PRESSURE_WINDOW_SAMPLES / 100.0;
+}
+
+// Feeds a trace one sample per minute; returns the worst disagreement
+// with the plain fit and leaves the trend on the last sample
+template <typename F>
+static double feed(PressureTrend& trend, int samples, F paAt) {
+    std::vector<uint32_t> kept;
+    double worst = 0;
+    for (int i = 0; i < samples; i++) {
+        uint32_t pa = lround(paAt(i));
+        trend.add(pa);
+        kept.push_back(pa);
+        host::advance(PRESSURE_SAMPLE_MS);
+        if (kept.size() >= 2) worst = std::max(worst, fabs(fitTrend(kept) - trend.getTrend()));
+    }
+    return worst;
+}
+
+static uint32_t nextRandom() {
+    static uint32_t state = 3;
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+static double noise(int amplitude) {
+    return (int)(nextRandom() % (2 * amplitude + 1)) - amplitude;
+}
+
+int main() {
+    // Falling 2 hPa in 3 h with sensor noise, well past a full window
+    {
+        PressureTrend trend;
+        double worst = feed(trend, 2000, [](int i) { return 101500 - 200.0 * i / 180 + noise(10); });
+        CHECK(worst < 0.01);
+        CHECK(trend.getCount() == PRESSURE_WINDOW_SAMPLES);
+        CHECK(fabs(trend.getTrend() + 2.0f) < 0.3f);
+        CHECK(trend.getTendency() == PRESSURE_FALLING);
+        uint8_t z = trend.getForecast(1013);
+        CHECK(z >= 1 && z <= 9);
+    }
+
+    // Rising 3 hPa in 3 h
+    {
+        PressureTrend trend;
+        double worst = feed(trend, 2000, [](int i) { return 99000 + 300.0 * i / 180 + noise(10); });
+        CHECK(worst < 0.01);
+        CHECK(fabs(trend.getTrend() - 3.0f) < 0.3f);
+        CHECK(trend.getTendency() == PRESSURE_RISING);
+        uint8_t z = trend.getForecast(1013);
+        CHECK(z >= 20 && z <= 32);
+    }
+
+    // A slow swing: the slope follows the derivative through every turn
+    {
+        PressureTrend trend;
+        double worst = feed(trend, 2000, [](int i) { return 101300 + 250 * sin(i / 300.0); });
+        CHECK(worst < 0.01);
+    }
+
+    // Noise alone is steady
+    {
+        PressureTrend trend;
+        double worst = feed(trend, 2000, [](int) { return 101325 + noise(20); });
+        CHECK(worst < 0.01);
+        CHECK(trend.getTendency() == PRESSURE_STEADY);
+        uint8_t z = trend.getForecast(1013);
+        CHECK(z >= 10 && z <= 19);
+    }
+
+    // Not ready before half an hour; readings outside the uint16 range clamp
+    {
+        PressureTrend trend;
+        feed(trend, PRESSURE_MIN_SAMPLES - 1, [](int) { return 101325; });
+        CHECK(!trend.isReady());
+        trend.add(101325);
+        CHECK(trend.isReady());
+        CHECK(trend.getTrend() == 0);
+        trend.clear();
+        trend.add(0);
+        trend.add(200000);
+        CHECK(trend.getTrend() > 0);
+    }
+
+    // Failed reads through the sensor: the window keeps only good ones
+    {
+        BME280Sensor sensor({ 0, 21, 22, 0x76, "test" });
+        CHECK(sensor.begin());
+        const PressureTrend& trend = sensor.getTrend();
+        for (int minute = 0; minute < 4; minute++) {
+            hostBme.pressure = minute % 2 ? NAN : 101325.0f;
+            hostBme.temperature = minute % 2 ? NAN : 21.5f;
+            host::advance(PRESSURE_SAMPLE_MS);
+            while (!sensor.takeSample()) {
+                sensor.transact();
+                host::advance(1);
+            }
+        }
+        CHECK(trend.getCount() == 2);
+        CHECK(trend.getTrend() == 0);
+        CHECK(sensor.getHistory().size() == 2);
+        hostBme = HostBme();
+    }
+
+    return host::finish("test_pressuretrend");
+}
@@ -0,0 +1,210 @@
+// Sparkline and SampleRing: bars scale to the band, the ring wraps one
+// column at a time, out-of-band readings and missed ones rebuild, every
+// column matches a fresh render, draw() puts the newest reading at the
+// zone's right edge, and a PMS sensor adds one column a minute whether it
+// is held on or sampling in the background
+
+#include "Sparkline.h"
+#include "PmsSensor.h"
+#include "host.h"
+
+// Every column against one rendered from scratch in the current band
+template <uint16_t N>
+static bool matchesRing(const Sparkline<N>& spark, const SampleRing<N>& ring) {
+    if (spark.getCount() != ring.size()) return false;
+    for (uint16_t i = 0; i < ring.size(); i++) {
+        if (spark.getColumns()[i] != spark.columnFor(ring[i])) return false;
+    }
+    return true;
+}
+
+static uint32_t nextRandom() {
+    static uint32_t state = 3;
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+static void pmsFrame(uint8_t frame[PMS_FRAME_LEN], uint16_t pm25) {
+    memset(frame, 0, PMS_FRAME_LEN);
+    frame[0] = 0x42;
+    frame[1] = 0x4D;
+    frame[3] = 28;
+    frame[12] = pm25 >> 8;
+    frame[13] = pm25 & 0xFF;
+    uint16_t sum = 0;
+    for (int i = 0; i < PMS_FRAME_LEN - 2; i++) sum += frame[i];
+    frame[PMS_FRAME_LEN - 2] = sum >> 8;
+    frame[PMS_FRAME_LEN - 1] = sum & 0xFF;
+}
+
+// Runs the sensor as its bus would, with a frame a second while the fan
+// is on, and keeps the graph current; returns the history entries added
+template <uint16_t N>
+static uint32_t runPms(PmsSensor& sensor, Sparkline<N>& spark, unsigned long ms) {
+    const SampleRing<N>& history = sensor.getHistory();
+    uint32_t before = history.getTotal();
+    uint8_t frame[PMS_FRAME_LEN];
+    pmsFrame(frame, 12);
+    for (unsigned long t = 0; t < ms; t += 10) {
+        if (sensor.isOn() && millis() % 1000 == 0) host::feedUart(2, frame, PMS_FRAME_LEN);
+        sensor.update();
+        while (sensor.transact()) {}
+        spark.update(history);
+        host::advance(10);
+    }
+    return history.getTotal() - before;
+}
+
+int main() {
+    // The ring keeps the newest N, oldest first
+    {
+        SampleRing<4> ring;
+        CHECK(ring.size() == 0 && ring.newest() == 0);
+        for (int v = 1; v <= 6; v++) ring.add(v * 10);
+        CHECK(ring.size() == 4);
+        CHECK(ring.getTotal() == 6);
+        CHECK(ring[0] == 30 && ring[3] == 60 && ring.newest() == 60);
+        ring.clear();
+        CHECK(ring.size() == 0 && ring.getTotal() == 6);
+    }
+
+    // Bars: the lowest reading lights the bottom row, the highest all eight
+    {
+        SampleRing<8> ring;
+        Sparkline<8> spark(1);
+        for (int v = 0; v < 8; v++) {
+            ring.add(v);
+            spark.update(ring);
+        }
+        const uint8_t bars[8] = { 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE, 0xFF };
+        CHECK(spark.getCount() == 8);
+        CHECK(memcmp(spark.getColumns(), bars, 8) == 0);
+
+        // Full: the oldest drops off and one column is added, no rebuild
+        uint32_t rebuilds = spark.getRebuilds();
+        ring.add(3);
+        CHECK(spark.update(ring));
+        CHECK(spark.getRebuilds() == rebuilds);
+        CHECK(spark.getColumns()[0] == 0xC0 && spark.getColumns()[7] == 0xF0);
+        CHECK(!spark.update(ring));
+    }
+
+    // Out of band: rescaled and re-rendered once, centred on the range
+    {
+        SampleRing<16> ring;
+        Sparkline<16> spark(1);
+        for (int v = 100; v < 104; v++) {
+            ring.add(v);
+            spark.update(ring);
+        }
+        uint32_t rebuilds = spark.getRebuilds();
+        ring.add(140);
+        spark.update(ring);
+        CHECK(spark.getRebuilds() == rebuilds + 1);
+        CHECK(spark.getColumns()[0] == 0x80 && spark.getColumns()[4] == 0xFF);
+        CHECK(matchesRing(spark, ring));
+    }
+
+    // Flat readings draw a level line at the minimum step, negatives too
+    {
+        SampleRing<10> ring;
+        Sparkline<10> spark(5);
+        for (int i = 0; i < 25; i++) {
+            ring.add(-37);
+            spark.update(ring);
+        }
+        bool level = true;
+        for (int i = 0; i < 10; i++) level = level && spark.getColumns()[i] == spark.getColumns()[0];
+        CHECK(level);
+        CHECK(matchesRing(spark, ring));
+    }
+
+    // Missed readings and a cleared ring catch up by rebuilding
+    {
+        SampleRing<12> ring;
+        Sparkline<12> spark(1);
+        for (int i = 0; i < 30; i++) ring.add(i % 7);
+        CHECK(spark.update(ring));
+        CHECK(matchesRing(spark, ring));
+        ring.clear();
+        ring.add(5);
+        spark.update(ring);
+        CHECK(spark.getCount() == 1);
+        CHECK(matchesRing(spark, ring));
+    }
+
+    // A random walk, every step against a full re-render
+    {
+        SampleRing<SENSOR_HISTORY_SIZE> ring;
+        Sparkline<SENSOR_HISTORY_SIZE> spark(2);
+        int v = 200;
+        bool matched = true;
+        for (int i = 0; i < 20000; i++) {
+            v += (int)(nextRandom() % 13) - 6;
+            ring.add(v);
+            spark.update(ring);
+            matched = matched && matchesRing(spark, ring);
+        }
+        CHECK(matched);
+        CHECK(spark.getRebuilds() < 20000 / 4);
+    }
+
+    // Drawn into a 32-column zone: newest at the right edge (column 0 of
+    // the zone's first device), blank where there is no reading yet
+    {
+        MD_Parola parola(MD_MAX72XX::FC16_HW, 5, 8);
+        parola.begin(2);
+        DisplayZone zone(&parola, 1, 4, 7);
+        MD_MAX72XX* mx = parola.getGraphicObject();
+        uint16_t right = zone.getFirstColumn();
+        SampleRing<SENSOR_HISTORY_SIZE> ring;
+        Sparkline<SENSOR_HISTORY_SIZE> spark(1);
+        for (int v = 0; v < 8; v++) {
+            ring.add(v);
+            spark.update(ring);
+        }
+        spark.draw(&zone);
+        CHECK(mx->getColumn(right) == 0xFF);
+        CHECK(mx->getColumn(right + 7) == 0x80);
+        CHECK(mx->getColumn(right + 8) == 0);
+        CHECK(mx->getColumn(right + 31) == 0);
+        CHECK(mx->getColumn(right - 1) == 0);
+
+        // A full ring shows its newest 32
+        for (int v = 8; v < SENSOR_HISTORY_SIZE; v++) {
+            ring.add(v % 8);
+            spark.update(ring);
+        }
+        spark.draw(&zone);
+        bool drawn = true;
+        for (uint16_t i = 0; i < zone.getColumnCount(); i++) {
+            drawn = drawn && mx->getColumn(right + i) == spark.columnFor(ring[ring.size() - 1 - i]);
+        }
+        CHECK(drawn);
+    }
+
+    // PMS history: a column per SENSOR_HISTORY_MS, held on (a sample every
+    // PMS_READ_INTERVAL) or in the background (one every few minutes)
+    {
+        host::setMillis(0);
+        PmsSensor sensor({ 2, 16, 17, 4, "test" });
+        sensor.begin();
+        Sparkline<SENSOR_HISTORY_SIZE> spark(1);
+        sensor.hold(true);
+        runPms(sensor, spark, 60000);
+        CHECK(sensor.hasReading());
+        CHECK(sensor.getHistory().size() >= 1);
+
+        uint32_t added = runPms(sensor, spark, 10 * SENSOR_HISTORY_MS);
+        CHECK(added == 10);
+
+        sensor.hold(false);
+        added = runPms(sensor, spark, 30 * SENSOR_HISTORY_MS);
+        CHECK(added == 30);
+        CHECK(!sensor.isOn());
+        CHECK(spark.getCount() == sensor.getHistory().size());
+        CHECK(matchesRing(spark, sensor.getHistory()));
+    }
+
+    return host::finish("test_sparkline");
+}
@@ -0,0 +1,54 @@
+// TextModule: the longest message the page allows renders whole, longer
+// ones are rejected, and repeats scroll the bitmap without rendering again
+
+#include "ModuleManager.h"
+#include "TextModule.h"
+#include "host.h"
+#include <string>
+
+// Runs the zone until the text stops, at its own speed
+static void scrollOut(ModuleManager& manager, TextModule* text) {
+    for (int i = 0; i < 100000 && text->isActive(); i++) {
+        manager.update();
+        host::advance(1);
+    }
+}
+
+int main() {
+    MD_Parola parola(MD_MAX72XX::FC16_HW, 5, 4);
+    parola.begin(1);
+    ModuleManager manager;
+    manager.addZone(&parola, 0, 3);
+    TextModule* text = new TextModule();
+    manager.addModule(text, 0);
+    MD_MAX72XX* mx = parola.getGraphicObject();
+
+    // Every character of the longest message is rasterized
+    std::string longest(TEXT_LENGTH_MAX, 'W');
+    CHECK(text->show(longest.c_str(), 1));
+    CHECK(!text->show((longest + "W").c_str(), 1));
+    text->activate();
+    scrollOut(manager, text);
+    uint32_t reads = mx->charReads;
+    CHECK(reads >= TEXT_LENGTH_MAX);
+
+    // Three passes, one render; a replay of the finished head needs none
+    reads = mx->charReads;
+    CHECK(text->show("again", 1, TEXT_PRIORITY_NORMAL, 3));
+    text->activate();
+    unsigned long started = millis();
+    scrollOut(manager, text);
+    CHECK(mx->charReads - reads == 5);
+    CHECK(millis() - started >= 3 * (5 * 6));
+    text->activate();
+    scrollOut(manager, text);
+    CHECK(mx->charReads - reads == 5);
+
+    // A new head is rendered when it takes over
+    CHECK(text->show("next", 1));
+    text->activate();
+    scrollOut(manager, text);
+    CHECK(mx->charReads - reads == 9);
+
+    return host::finish("test_textmodule");
+}
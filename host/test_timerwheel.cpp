@@ -0,0 +1,165 @@
+// TimerWheel across the 2^32 millis() wrap, the names its events carry
+// when a pool slot is reused before the bus dispatches, and an idle budget
+// that never sleeps through a deadline
+
+#include "TimerWheel.h"
+#include "host.h"
+#include <string>
+#include <vector>
+
+struct Names : EventListener {
+    std::vector<std::pair<EventTopic, std::string>> seen;
+    void onEvent(const Event& event) override { seen.push_back({ event.topic, event.name }); }
+};
+
+// Advances the clock in loop-sized steps, updating the wheel each time
+static void run(TimerWheel& wheel, unsigned long ms, unsigned long step = 7) {
+    while (ms) {
+        unsigned long n = ms < step ? ms : step;
+        host::advance(n);
+        wheel.update();
+        ms -= n;
+    }
+}
+
+static const uint64_t WRAP = 1ull << 32;
+
+// Records when each timer fired, by id
+struct Firings : EventListener {
+    std::vector<std::pair<TimerId, uint32_t>> seen;
+    void onEvent(const Event& event) override { seen.push_back({ (TimerId)event.values[1], millis() }); }
+};
+
+static uint32_t seed = 7;
+static uint32_t nextRandom() {
+    seed = seed * 1664525 + 1013904223;
+    return seed >> 8;
+}
+
+int main() {
+    // A one-shot started 5 s before the wrap fires 10 s later, not early
+    // and not 49.7 days late
+    {
+        host::setMillis(WRAP - 5000);
+        EventBus bus;
+        TimerWheel wheel(bus);
+        TimerId id = wheel.start("tea", 10000);
+        CHECK(wheel.remaining(id) == 10000);
+        run(wheel, 4000);
+        CHECK(wheel.remaining(id) == 6000);
+        run(wheel, 2000);                        // now past the wrap
+        CHECK(millis() < 5000);
+        CHECK(wheel.remaining(id) == 4000);
+        CHECK(wheel.getIdleBudget() > 0 && wheel.getIdleBudget() <= 4000);
+        run(wheel, 3990);
+        CHECK(wheel.getFired() == 0);
+        run(wheel, 10);
+        CHECK(wheel.getFired() == 1);
+        CHECK(!wheel.isRunning(id));
+    }
+
+    // A repeating timer keeps its period through the wrap
+    {
+        host::setMillis(WRAP - 3500);
+        EventBus bus;
+        TimerWheel wheel(bus);
+        wheel.start("tick", 1000, 1000);
+        run(wheel, 10000);
+        CHECK(wheel.getFired() == 10);
+        CHECK(wheel.getIdleBudget() > 0 && wheel.getIdleBudget() <= 1000);
+    }
+
+    // A loop that stalls across the wrap catches up on every tick
+    {
+        host::setMillis(WRAP - 100);
+        EventBus bus;
+        TimerWheel wheel(bus);
+        wheel.start("a", 50);
+        wheel.start("b", 250);
+        host::advance(300);
+        wheel.update();
+        CHECK(wheel.getFired() == 2);
+    }
+
+    // Cancel then start in one pass reuses the slot before dispatch; each
+    // event still names its own timer
+    {
+        host::setMillis(1000);
+        EventBus bus;
+        TimerWheel wheel(bus);
+        Names names;
+        bus.subscribe(&names, EVENT_MASK(EVENT_TIMER_STARTED) | EVENT_MASK(EVENT_TIMER_STOPPED) |
+                              EVENT_MASK(EVENT_TIMER_EXPIRED));
+        TimerId work = wheel.start("work", 60000);
+        wheel.cancel(work);
+        TimerId rest = wheel.start("break", 100);
+        CHECK((rest & 0xFFFF) == (work & 0xFFFF));
+        run(wheel, 100);
+        bus.dispatch();
+        std::vector<std::pair<EventTopic, std::string>> expected = {
+            { EVENT_TIMER_STARTED, "work" },
+            { EVENT_TIMER_STOPPED, "work" },
+            { EVENT_TIMER_STARTED, "break" },
+            { EVENT_TIMER_EXPIRED, "break" },
+        };
+        CHECK(names.seen == expected);
+    }
+
+    // Names longer than an event holds are cut, not overrun
+    {
+        EventBus bus;
+        Names names;
+        bus.subscribe(&names, EVENT_MASK(EVENT_SENSOR_SAMPLE));
+        bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, "a-very-long-sensor-label");
+        bus.publish(EVENT_SENSOR_SAMPLE, SOURCE_PMS, nullptr);
+        bus.dispatch();
+        CHECK(names.seen.size() == 2);
+        CHECK(names.seen[0].second == std::string("a-very-long-sensor-label").substr(0, EVENT_NAME_LEN - 1));
+        CHECK(names.seen[1].second.empty());
+    }
+
+    // A loop that sleeps exactly the idle budget between passes wakes for
+    // every timer on its tick, from seconds to a day out, across the wrap
+    {
+        host::setMillis(WRAP - 600000);
+        EventBus bus;
+        TimerWheel wheel(bus);
+        Firings firings;
+        bus.subscribe(&firings, EVENT_MASK(EVENT_TIMER_EXPIRED));
+        std::vector<std::pair<TimerId, uint64_t>> due;     // fake-clock ms
+        const unsigned long delays[] = { 10, 630, 640, 650, 40950, 40960, 41000, 2621440, 2700000, 86400000 };
+        for (unsigned long delay : delays) due.push_back({ wheel.start("d", delay), host::nowMicros() / 1000 + delay });
+        for (int i = 0; i < TIMER_MAX - 10; i++) {
+            unsigned long delay = 10 * (1 + nextRandom() % 360000);
+            due.push_back({ wheel.start("r", delay), host::nowMicros() / 1000 + delay });
+        }
+
+        uint32_t passes = 0;
+        bool overslept = false;
+        while (wheel.getActiveCount() > 0 && passes < 100000) {
+            unsigned long budget = wheel.getIdleBudget();
+            uint64_t now = host::nowMicros() / 1000;
+            for (auto& d : due) {
+                if (wheel.isRunning(d.first) && d.second < now + budget) overslept = true;
+            }
+            host::advance(budget);
+            wheel.update();
+            bus.dispatch();
+            passes++;
+        }
+        CHECK(wheel.getActiveCount() == 0);
+        CHECK(!overslept);
+        CHECK(firings.seen.size() == due.size());
+        bool onTime = firings.seen.size() == due.size();
+        for (auto& f : firings.seen) {
+            for (auto& d : due) {
+                if (d.first == f.first) onTime = onTime && f.second == (uint32_t)d.second;
+            }
+        }
+        CHECK(onTime);
+        // A wake per occupied slot and level, not one per millisecond
+        CHECK(passes < 200);
+    }
+
+    return host::finish("test_timerwheel");
+}
@@ -0,0 +1,63 @@
+// Display zones: one MD_Parola frame per ModuleManager::update() however
+// many zones animate, and every zone's module reported in /api/data
+
+#include "ModuleManager.h"
+#include "ClockModule.h"
+#include "TextModule.h"
+#include "PomodoroModule.h"
+#include "host.h"
+
+int main() {
+    MD_Parola parola(MD_MAX72XX::FC16_HW, 5, 12);
+    parola.begin(3);
+    ModuleManager manager;
+    manager.addZone(&parola, 8, 11);
+    manager.addZone(&parola, 4, 7);
+    manager.addZone(&parola, 0, 3);
+
+    host::setLocalTime(9, 30, 0);
+    ClockModule* clock = new ClockModule();
+    TextModule* text = new TextModule();
+    manager.addModule(clock, 0);
+    manager.addModule(new PomodoroModule(), 1);
+    manager.addModule(text, 2);
+    text->show("three zones", 10);
+    manager.getEventBus().publish(EVENT_MODULE_REQUEST, SOURCE_NONE, "TextScroll");
+
+    // Every zone busy: the clock scrolls its date, the ticker scrolls text
+    const uint32_t passes = 500;
+    uint32_t before = parola.animateCalls;
+    for (uint32_t i = 0; i < passes; i++) {
+        manager.update();
+        host::advance(10);
+    }
+    CHECK(parola.animateCalls - before == passes);
+
+    CHECK(manager.getActiveModule(0) == clock);
+    CHECK(manager.getActiveModule(1) == nullptr);
+    CHECK(manager.getActiveModule(2) == text);
+    CHECK(manager.isShown(text));
+
+    host::Capture json;
+    JsonWriter writer(json);
+    manager.writeData(writer);
+    CHECK(json.text.find("\"active\":\"Clock\"") != std::string::npos);
+    CHECK(json.text.find("\"zones\":[\"Clock\",\"None\",\"TextScroll\"]") != std::string::npos);
+
+    // Showing a module in one zone leaves the others alone
+    StrView request("GET /module/Pomodoro HTTP/1.1");
+    RequestArena arena;
+    CHECK(manager.handleWebRequest(request, arena));
+    CHECK(manager.getActiveModule(1) != nullptr);
+    CHECK(strcmp(manager.getActiveModule(1)->getName(), "Pomodoro") == 0);
+    CHECK(manager.getActiveModule(2) == text);
+
+    // The name is the whole path segment
+    CHECK(!manager.acceptsWebRequest("GET /module/Clockwork HTTP/1.1"));
+    CHECK(!manager.acceptsWebRequest("GET /module/Pomo HTTP/1.1"));
+    CHECK(manager.acceptsWebRequest("GET /module/Clock?from=page HTTP/1.1"));
+    CHECK(manager.acceptsWebRequest("GET /module/Clock/ HTTP/1.1"));
+    CHECK(manager.acceptsWebRequest("/module/Clock"));
+
+    return host::finish("test_zones");
+}
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""Build the dashboard into WebAssets.h.
+
+Reads web/index.html, inlines the stylesheet and scripts it references,
+minifies the result, gzips it and writes a header of constexpr byte arrays
+that the sketch serves straight from flash with Content-Encoding: gzip.
+Each bundled script must pass node --check, or nothing is written.
+
+Run after editing anything in web/:
+
+    python3 tools/build_web_assets.py
+"""
+
+import argparse
+import gzip
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+WEB_DIR = os.path.join(ROOT, "web")
+OUTPUT = os.path.join(ROOT, "WebAssets.h")
+
+# (source page, C identifier, content type)
+ASSETS = [
+    ("index.html", "INDEX_HTML", "text/html; charset=UTF-8"),
+]
+
+
+def read(name):
+    with open(os.path.join(WEB_DIR, name), encoding="utf-8") as f:
+        return f.read()
+
+
+def minify_css(css):
+    css = re.sub(r"/\*.*?\*/", "", css, flags=re.S)
+    css = re.sub(r"\s*\n\s*", "", css)
+    css = re.sub(r"\s*([{};,])\s*", r"\1", css)
+    return css.replace(";}", "}")
+
+
+# After one of these (or at the start) a '/' opens a regex literal;
+# anywhere else it divides
+REGEX_AFTER = set("(,=:[!&|?{};+-*%<>~^")
+REGEX_KEYWORDS = ("return", "typeof", "case", "do", "else", "in", "of", "void", "throw", "new", "delete")
+
+
+def strip_js_comments(js):
+    """Removes // and /* */ comments, stepping over strings, template
+    literals and regex literals so a '//' inside one survives."""
+    out = []
+    i, n = 0, len(js)
+    while i < n:
+        c = js[i]
+        if c in "'\"`":
+            j = i + 1
+            while j < n and js[j] != c:
+                j += 2 if js[j] == "\\" else 1
+            out.append(js[i:j + 1])
+            i = j + 1
+        elif js.startswith("//", i):
+            while i < n and js[i] != "\n":
+                i += 1
+        elif js.startswith("/*", i):
+            end = js.find("*/", i + 2)
+            if end < 0:
+                raise ValueError("unterminated /* comment")
+            # A comment spanning lines still separates statements
+            out.append("\n" if "\n" in js[i:end] else " ")
+            i = end + 2
+        elif c == "/" and regex_allowed("".join(out)):
+            j, in_class = i + 1, False
+            while j < n and (in_class or js[j] != "/"):
+                if js[j] == "\n":
+                    raise ValueError("unterminated regex literal")
+                if js[j] == "\\":
+                    j += 1
+                elif js[j] == "[":
+                    in_class = True
+                elif js[j] == "]":
+                    in_class = False
+                j += 1
+            out.append(js[i:j + 1])
+            i = j + 1
+        else:
+            out.append(c)
+            i += 1
+    return "".join(out)
+
+
+def regex_allowed(before):
+    before = before.rstrip()
+    if not before or before[-1] in REGEX_AFTER:
+        return True
+    word = re.search(r"[A-Za-z_$]+$", before)
+    return bool(word) and word.group(0) in REGEX_KEYWORDS
+
+
+def minify_js(js):
+    # Conservative: drop comments, indentation and blank lines but keep
+    # line breaks, so automatic semicolon insertion behaves exactly as in
+    # the source.
+    lines = (line.strip() for line in strip_js_comments(js).splitlines())
+    return "\n".join(line for line in lines if line)
+
+
+# Script and style bodies are minified on their own terms; the HTML
+# whitespace rules must not touch them
+RAW_TEXT = re.compile(r"(<(script|style)\b[^>]*>.*?</\2>)", re.S)
+
+
+def minify_html(html):
+    parts = RAW_TEXT.split(html)
+    # split() yields text, element, tag name, text, ...
+    for k in range(0, len(parts), 3):
+        text = re.sub(r"<!--.*?-->", "", parts[k], flags=re.S)
+        # Only whitespace that spans a line break is layout; same-line
+        # spaces between inline elements are kept.
+        text = re.sub(r">\s*\n\s*<", "><", text)
+        if k > 0:
+            text = re.sub(r"^\s*\n\s*", "", text)
+        if k + 1 < len(parts):
+            text = re.sub(r"\s*\n\s*$", "", text)
+        parts[k] = re.sub(r"\s*\n\s*", " ", text)
+    return "".join(parts[k] for k in range(len(parts)) if k % 3 != 2).strip()
+
+
+def check_scripts(html, source):
+    """Fails the build when an inlined script does not parse."""
+    node = shutil.which("node")
+    if not node:
+        sys.exit("node not found: it checks the bundled scripts (or pass --no-check)")
+    for m in re.finditer(r"<script>(.*?)</script>", html, flags=re.S):
+        with tempfile.NamedTemporaryFile("w", suffix=".js", delete=False, encoding="utf-8") as f:
+            f.write(m.group(1))
+        try:
+            result = subprocess.run([node, "--check", f.name], capture_output=True, text=True)
+        finally:
+            os.unlink(f.name)
+        if result.returncode != 0:
+            sys.exit("%s: bundled script does not parse, WebAssets.h not written\n%s"
+                     % (source, result.stderr.strip()))
+
+
+def inline_assets(html):
+    def style(m):
+        return "<style>" + minify_css(read(m.group(1))) + "</style>"
+
+    def script(m):
+        return "<script>" + minify_js(read(m.group(1))) + "</script>"
+
+    html = re.sub(r'<link rel="stylesheet" href="([^"]+)">', style, html)
+    return re.sub(r'<script src="([^"]+)"></script>', script, html)
+
+
+def c_array(data):
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(rows)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--no-check", action="store_true", help="skip the node --check of the bundled scripts")
+    args = ap.parse_args()
+
+    out = [
+        "// Generated by tools/build_web_assets.py from web/ - do not edit.",
+        "#ifndef WEB_ASSETS_H",
+        "#define WEB_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+
+    for source, name, content_type in ASSETS:
+        raw = read(source)
+        raw_size = len(raw.encode("utf-8"))
+        for m in re.finditer(r'(?:href|src)="([^"]+\.(?:css|js))"', raw):
+            raw_size += len(read(m.group(1)).encode("utf-8"))
+
+        html = minify_html(inline_assets(raw))
+        if not args.no_check:
+            check_scripts(html, source)
+        minified = html.encode("utf-8")
+        packed = gzip.compress(minified, compresslevel=9, mtime=0)
+
+        print("%-12s %6d raw  %6d minified  %6d gzip" % (source, raw_size, len(minified), len(packed)))
+
+        out += [
+            "// %s: %d bytes raw, %d minified, %d gzipped" % (source, raw_size, len(minified), len(packed)),
+            'constexpr const char %s_TYPE[] = "%s";' % (name, content_type),
+            "constexpr uint8_t %s_GZ[] PROGMEM = {" % name,
+            c_array(packed),
+            "};",
+            "constexpr size_t %s_GZ_LEN = sizeof(%s_GZ);" % (name, name),
+            "",
+        ]
+
+    out.append("#endif // WEB_ASSETS_H")
+
+    with open(OUTPUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(out) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
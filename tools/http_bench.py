@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Load-test a SmartClock's HTTP server from the host.
+
+Runs a fixed number of client threads against one endpoint for a fixed
+time, first opening a new connection per request (the old behaviour) and
+then reusing persistent keep-alive connections, and reports
+connections/sec and requests/sec for each.
+
+    python3 tools/http_bench.py 192.168.1.50
+    python3 tools/http_bench.py 192.168.1.50 --clients 4 --seconds 10 --path /api/data.cbor
+"""
+
+import argparse
+import http.client
+import threading
+import time
+
+
+def worker(host, port, path, keep_alive, deadline, stats, lock):
+    requests = connections = errors = 0
+    latency = 0.0
+    conn = None
+    while time.monotonic() < deadline:
+        try:
+            if conn is None:
+                conn = http.client.HTTPConnection(host, port, timeout=5)
+                connections += 1
+            start = time.monotonic()
+            headers = {} if keep_alive else {"Connection": "close"}
+            conn.request("GET", path, headers=headers)
+            resp = conn.getresponse()
+            resp.read()
+            latency += time.monotonic() - start
+            requests += 1
+            if not keep_alive or resp.will_close:
+                conn.close()
+                conn = None
+        except (OSError, http.client.HTTPException):
+            errors += 1
+            if conn is not None:
+                conn.close()
+            conn = None
+            time.sleep(0.05)
+    if conn is not None:
+        conn.close()
+    with lock:
+        stats["requests"] += requests
+        stats["connections"] += connections
+        stats["errors"] += errors
+        stats["latency"] += latency
+
+
+def run(host, port, path, clients, seconds, keep_alive):
+    stats = {"requests": 0, "connections": 0, "errors": 0, "latency": 0.0}
+    lock = threading.Lock()
+    deadline = time.monotonic() + seconds
+    threads = [threading.Thread(target=worker, args=(host, port, path, keep_alive, deadline, stats, lock))
+               for _ in range(clients)]
+    start = time.monotonic()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.monotonic() - start
+
+    mean_ms = 1000 * stats["latency"] / stats["requests"] if stats["requests"] else 0
+    print("%-11s %8.1f conn/s %8.1f req/s %7.1f ms/req %5d errors" % (
+        "keep-alive" if keep_alive else "close",
+        stats["connections"] / elapsed, stats["requests"] / elapsed, mean_ms, stats["errors"]))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("host")
+    ap.add_argument("--port", type=int, default=80)
+    ap.add_argument("--path", default="/api/data")
+    ap.add_argument("--clients", type=int, default=4)
+    ap.add_argument("--seconds", type=float, default=10)
+    args = ap.parse_args()
+
+    print("%s:%d%s, %d clients, %.0fs each" % (args.host, args.port, args.path, args.clients, args.seconds))
+    run(args.host, args.port, args.path, args.clients, args.seconds, keep_alive=False)
+    run(args.host, args.port, args.path, args.clients, args.seconds, keep_alive=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Benchmark a SmartClock's hot paths and gate on regressions.
+
+Resets the on-device counters (/api/perf/reset), drives a fixed request
+workload, waits for the sensor and display paths to run, then reads
+/api/perf (see PerfCounters.h). The snapshot can be saved as a baseline
+or compared against one; comparison exits non-zero when any probe's mean
+time regresses past the threshold or it starts keeping heap.
+
+    python3 tools/perf_compare.py 192.168.1.50 --save perf/esp32-240mhz.json
+    python3 tools/perf_compare.py 192.168.1.50 --baseline perf/esp32-240mhz.json
+    python3 tools/perf_compare.py --compare old.json new.json --threshold 15
+    python3 tools/perf_compare.py --compare base.json hot.json zones.json
+    python3 tools/perf_compare.py --merge base.json hot.json zones.json
+
+Several NEW snapshots (host benchmarks each write one) are merged into
+one before comparing; --merge writes such a merge, to record a baseline.
+
+Device probes see heap only as the free-heap difference across a scope,
+which the WiFi and lwIP tasks also move. A probe counts as keeping heap
+when its largest hold grows by more than --held-tolerance bytes and it
+held heap after at least half its calls; a leak does both, a stray task
+allocation neither. Snapshots from the host benchmarks
+(host/bench_hotpaths --json) carry exact allocation counts instead, and
+any increase there is a regression.
+
+Baselines are only meaningful for the board, clock and firmware config
+they were recorded on, so record them from real hardware and keep them
+under perf/ next to the change that set them. The host baseline is
+host/bench_baseline.json (make -C host bench-check).
+"""
+
+import argparse
+import http.client
+import json
+import sys
+import time
+
+# Exercised on every run, read-only so a run leaves the clock as it found
+# it: state readers, the control page, and a path no module handles so
+# routing walks every module. Text decoding is covered by the host
+# benchmark instead, since /text/show queues a message.
+WORKLOAD = [
+    "/api/data",
+    "/api/data.cbor",
+    "/api/controls",
+    "/api/timers",
+    "/api/events?since=0",
+    "/bench/unrouted?x=1",
+]
+
+
+def get(conn, path):
+    conn.request("GET", path)
+    resp = conn.getresponse()
+    body = resp.read()
+    if resp.will_close:
+        conn.close()
+    return resp.status, body
+
+
+def run(host, port, rounds, settle):
+    conn = http.client.HTTPConnection(host, port, timeout=10)
+    get(conn, "/api/perf/reset")
+    for _ in range(rounds):
+        for path in WORKLOAD:
+            status, _ = get(conn, path)
+            if status >= 400:
+                print("warning: %s returned %d" % (path, status), file=sys.stderr)
+    time.sleep(settle)
+    status, body = get(conn, "/api/perf")
+    if status != 200:
+        sys.exit("/api/perf returned %d" % status)
+    snapshot = json.loads(body)
+    snapshot["meta"] = {"host": host, "rounds": rounds, "settle": settle, "time": int(time.time())}
+    return snapshot
+
+
+def heap_change(b, n, held_tolerance):
+    """Heap column and whether it regressed: allocations per call for host
+    snapshots, growth of the largest hold for device ones."""
+    if "allocs" in b and "allocs" in n:
+        change = n["allocs"] - b["allocs"]
+        return "%+.2f" % change, change > 0.005
+    change = n["held"] - b["held"]
+    keeps = n.get("grew", 0) * 2 >= n["n"]
+    return "%+d" % change, change > held_tolerance and keeps
+
+
+def compare(base, new, threshold, min_count, held_tolerance):
+    """Prints a table; returns the names of regressed probes."""
+    regressed = []
+    base_probes, new_probes = base.get("probes", {}), new.get("probes", {})
+    if base.get("mhz") != new.get("mhz"):
+        print("note: CPU clock differs (%s vs %s MHz)" % (base.get("mhz"), new.get("mhz")))
+    if new.get("dropped"):
+        print("note: %d probe(s) not counted, PERF_MAX_PROBES is too small" % new["dropped"])
+
+    heap = "allocs" if new.get("host") else "held"
+    print("%-22s %10s %10s %8s %8s %8s" % ("probe", "base ns", "new ns", "change", heap, "n"))
+    for name in sorted(set(base_probes) | set(new_probes)):
+        b, n = base_probes.get(name), new_probes.get(name)
+        if not b or not n:
+            print("%-22s %10s %10s %8s" % (name, b and b["ns"] or "-", n and n["ns"] or "-", "new" if n else "gone"))
+            continue
+        change = 100.0 * (n["ns"] - b["ns"]) / b["ns"] if b["ns"] else 0.0
+        held, held_regressed = heap_change(b, n, held_tolerance)
+        flag = ""
+        if min(b["n"], n["n"]) >= min_count and (change > threshold or held_regressed):
+            flag = "  REGRESSED"
+            regressed.append(name)
+        print("%-22s %10d %10d %+7.1f%% %8s %8d%s" % (name, b["ns"], n["ns"], change, held, n["n"], flag))
+    return regressed
+
+
+def load_merged(paths):
+    """One snapshot with the probes of all of them; later files win."""
+    merged = {}
+    for path in paths:
+        with open(path) as f:
+            snapshot = json.load(f)
+        probes = merged.get("probes", {})
+        probes.update(snapshot.get("probes", {}))
+        merged.update(snapshot)
+        merged["probes"] = probes
+    return merged
+
+
+def save(snapshot, path):
+    with open(path, "w") as f:
+        if snapshot.get("host"):
+            # As host::writeSnapshot() writes them: a line per probe, in bench order
+            rows = ['    %s: {"n": %d, "ns": %.0f, "allocs": %.2f, "bytes": %.0f}'
+                    % (json.dumps(name), p["n"], p["ns"], p["allocs"], p["bytes"])
+                    for name, p in snapshot["probes"].items()]
+            f.write('{\n  "host": 1,\n  "probes": {\n%s\n  }\n}\n' % ",\n".join(rows))
+        else:
+            json.dump(snapshot, f, indent=2, sort_keys=True)
+            f.write("\n")
+    print("saved %d probes to %s" % (len(snapshot.get("probes", {})), path))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("host", nargs="?")
+    ap.add_argument("--port", type=int, default=80)
+    ap.add_argument("--rounds", type=int, default=50, help="workload repetitions")
+    ap.add_argument("--settle", type=float, default=5, help="seconds to let sensor and display probes run")
+    ap.add_argument("--save", metavar="FILE", help="write the snapshot as a baseline")
+    ap.add_argument("--baseline", metavar="FILE", help="compare the snapshot against a baseline")
+    ap.add_argument("--compare", nargs="+", metavar="FILE",
+                    help="compare saved snapshots: BASE, then one or more NEW merged")
+    ap.add_argument("--merge", nargs="+", metavar="FILE", help="write OUT as the merge of the snapshots after it")
+    ap.add_argument("--threshold", type=float, default=10, help="allowed slowdown in percent")
+    ap.add_argument("--min-count", type=int, default=5, help="ignore probes with fewer samples")
+    ap.add_argument("--held-tolerance", type=int, default=256,
+                    help="bytes a device probe's largest hold may grow by")
+    args = ap.parse_args()
+
+    if args.merge:
+        if len(args.merge) < 2:
+            ap.error("--merge needs OUT and at least one snapshot")
+        save(load_merged(args.merge[1:]), args.merge[0])
+        return
+    if args.compare:
+        if len(args.compare) < 2:
+            ap.error("--compare needs BASE and at least one NEW snapshot")
+        with open(args.compare[0]) as f:
+            base = json.load(f)
+        new = load_merged(args.compare[1:])
+    else:
+        if not args.host:
+            ap.error("host required unless --compare is given")
+        new = run(args.host, args.port, args.rounds, args.settle)
+        if args.save:
+            save(new, args.save)
+        if not args.baseline:
+            compare(new, new, args.threshold, args.min_count, args.held_tolerance)
+            return
+        with open(args.baseline) as f:
+            base = json.load(f)
+
+    regressed = compare(base, new, args.threshold, args.min_count, args.held_tolerance)
+    if regressed:
+        sys.exit("%d probe(s) regressed: %s" % (len(regressed), ", ".join(regressed)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,265 @@
+// Replays PM2.5 traces through the PMSA003 sampling policy on the host.
+//
+// The real PmsSensor and SensorBus run against a fake clock and UART: a
+// modelled sensor sends a frame a second while its SET pin is high, noisy
+// and low for the first seconds of warm-up and then tracking the trace.
+// Reports how long the laser ran (in total and per wake, which is mostly
+// warm-up) and how fresh and accurate the published reading stayed, for
+// built-in day profiles or a CSV trace.
+//
+//     make -C host tools
+//     host/build/pms_sim                     # every built-in profile, 24 h
+//     host/build/pms_sim --profile cooking --hours 72
+//     host/build/pms_sim --trace pm.csv      # "seconds,pm25" lines
+//
+// Freshness is sampled once a simulated minute: age is the time since the
+// published reading was taken, error its distance from the trace. Alert
+// lag is how long after the trace first reaches PMS_ALERT_PM25 the
+// published reading does. Pass is the longest simulated time one loop
+// pass spent in the sensor code; delay() advances the fake clock, so any
+// blocking wait on the UART shows up there.
+
+#include "PmsSensor.h"
+#include "host.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+static const PmsConfig SIM_PMS = { 2, 16, 17, 4, "sim" };
+static const unsigned long FRAME_MS = 1000;
+static const unsigned long SETTLE_MS = 10000;   // modelled warm-up
+
+struct Trace {
+    const char* name;
+    std::vector<std::pair<double, double>> points;   // seconds, ug/m3
+    double (*profile)(double seconds);
+
+    double at(double seconds) const {
+        if (profile) return profile(seconds);
+        if (points.empty()) return 0;
+        if (seconds <= points.front().first) return points.front().second;
+        for (size_t i = 1; i < points.size(); i++) {
+            if (seconds <= points[i].first) {
+                const auto& a = points[i - 1];
+                const auto& b = points[i];
+                return a.second + (b.second - a.second) * (seconds - a.first) / (b.first - a.first);
+            }
+        }
+        return points.back().second;
+    }
+};
+
+static double hourOfDay(double seconds) { return fmod(seconds / 3600, 24); }
+
+// Quiet room with a small day/night swing
+static double clean(double s) {
+    return 6 + 2 * sin(2 * M_PI * hourOfDay(s) / 24);
+}
+
+// Three meals: a fast rise to 60-140 ug/m3, decaying over 20 minutes
+static double cooking(double s) {
+    static const double meals[][2] = { { 7.5, 60 }, { 12.5, 90 }, { 19.0, 140 } };
+    double h = hourOfDay(s);
+    double pm = 8;
+    for (const auto& meal : meals) {
+        double since = (h - meal[0]) * 60;
+        if (since >= 0 && since < 5) pm += meal[1] * since / 5;
+        else if (since >= 5) pm += meal[1] * exp(-(since - 5) / 20);
+    }
+    return pm;
+}
+
+// Smoke days: high and swinging with the wind
+static double wildfire(double s) {
+    return 90 + 60 * sin(2 * M_PI * s / (6 * 3600)) + 20 * sin(2 * M_PI * s / 1800);
+}
+
+static void sendFrame(uint16_t pm25) {
+    uint16_t pm1 = pm25 * 2 / 3;
+    uint16_t pm10 = pm25 + pm25 / 4;
+    uint8_t frame[PMS_FRAME_LEN] = { 0x42, 0x4D, 0x00, 0x1C };
+    uint16_t values[6] = { pm1, pm25, pm10, pm1, pm25, pm10 };
+    for (int i = 0; i < 6; i++) {
+        frame[4 + 2 * i] = values[i] >> 8;
+        frame[5 + 2 * i] = values[i] & 0xFF;
+    }
+    uint16_t sum = 0;
+    for (int i = 0; i < PMS_FRAME_LEN - 2; i++) sum += frame[i];
+    frame[PMS_FRAME_LEN - 2] = sum >> 8;
+    frame[PMS_FRAME_LEN - 1] = sum & 0xFF;
+    host::feedUart(SIM_PMS.uart, frame, sizeof(frame));
+}
+
+struct Result {
+    double hours = 0;
+    double laserMs = 0;
+    uint32_t wakes = 0;
+    uint32_t samples = 0;
+    double ageSum = 0;
+    double ageMax = 0;
+    double errorSum = 0;
+    uint32_t minutes = 0;
+    double alertLagMax = 0;
+    uint32_t alerts = 0;
+    uint64_t passMaxUs = 0;
+};
+
+static Result run(const Trace& trace, double hours, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0, 1);
+
+    host::setMillis(0);
+    SensorBus bus("uart");
+    PmsSensor sensor(SIM_PMS);
+    bus.add(&sensor);
+    sensor.begin();
+
+    Result r;
+    r.hours = hours;
+    const uint64_t endMs = (uint64_t)(hours * 3600000);
+    uint64_t now = 0;
+    uint64_t nextFrame = 0;
+    uint64_t nextMinute = 60000;
+    uint64_t onSince = 0;
+    bool wasOn = false;
+    double alertSince = -1;
+
+    while (now < endMs) {
+        bool on = digitalRead(SIM_PMS.set) == HIGH;
+        if (on && !wasOn) {
+            r.wakes++;
+            onSince = now;
+            nextFrame = now + FRAME_MS;
+        }
+        if (!on && wasOn) r.laserMs += now - onSince;
+        wasOn = on;
+
+        if (on && now >= nextFrame) {
+            double truth = trace.at(now / 1000.0);
+            double settled = std::min(1.0, (now - onSince) / (double)SETTLE_MS);
+            double spread = 0.3 * (1 - settled) + 0.03;
+            double reading = truth * (0.3 + 0.7 * settled) * (1 + spread * noise(rng));
+            sendFrame((uint16_t)std::max(0.0, std::min(999.0, reading)));
+            nextFrame += FRAME_MS;
+        }
+
+        // Loop passes until the bus has nothing left to read
+        do {
+            uint64_t started = host::nowMicros();
+            bus.update();
+            r.passMaxUs = std::max(r.passMaxUs, host::nowMicros() - started);
+        } while (host::uartInput(SIM_PMS.uart).size() > 0);
+
+        if (sensor.takeSample()) {
+            r.samples++;
+            if (alertSince >= 0 && sensor.getPM2_5() >= PMS_ALERT_PM25) {
+                r.alertLagMax = std::max(r.alertLagMax, now / 1000.0 - alertSince);
+                alertSince = -1;
+            }
+        }
+
+        if (now >= nextMinute) {
+            double truth = trace.at(now / 1000.0);
+            if (truth >= PMS_ALERT_PM25 && alertSince < 0 &&
+                (!sensor.hasReading() || sensor.getPM2_5() < PMS_ALERT_PM25)) {
+                alertSince = now / 1000.0;
+                r.alerts++;
+            } else if (truth < PMS_ALERT_PM25 && alertSince >= 0) {
+                alertSince = -1;   // gone again before a sample saw it
+            }
+            if (sensor.hasReading()) {
+                double age = sensor.getSampleAge() / 1000.0;
+                r.ageSum += age;
+                r.ageMax = std::max(r.ageMax, age);
+                r.errorSum += fabs(sensor.getPM2_5() - truth);
+                r.minutes++;
+            }
+            nextMinute += 60000;
+        }
+
+        // Idle as the power governor would: until the bus, the next frame
+        // or the next measurement needs us
+        uint64_t step = bus.getIdleBudget();
+        if (on) step = std::min<uint64_t>(step, nextFrame - now);
+        step = std::min<uint64_t>(step, nextMinute - now);
+        step = std::max<uint64_t>(step, 1);
+        host::advance(step);
+        now += step;
+    }
+    if (wasOn) r.laserMs += now - onSince;
+    return r;
+}
+
+static bool loadCsv(const char* path, Trace& trace) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        double seconds, pm;
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%lf,%lf", &seconds, &pm) == 2) trace.points.push_back({ seconds, pm });
+    }
+    fclose(f);
+    return !trace.points.empty();
+}
+
+static void report(const Trace& trace, const Result& r) {
+    double days = r.hours / 24;
+    printf("%-10s %6.0f %8.2f %6.1f %6u %8u %9.1f %7.1f %7.1f %8.1f %6u %9.0f %7.1f\n",
+           trace.name, r.hours, r.laserMs / 3600000 / days, 100 * r.laserMs / (r.hours * 3600000),
+           r.wakes, r.samples, r.wakes ? r.laserMs / r.wakes / 1000 : 0,
+           r.minutes ? r.ageSum / r.minutes / 60 : 0, r.ageMax / 60,
+           r.minutes ? r.errorSum / r.minutes : 0, r.alerts, r.alertLagMax,
+           r.passMaxUs / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    const char* only = nullptr;
+    const char* csv = nullptr;
+    double hours = 24;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--profile") && i + 1 < argc) only = argv[++i];
+        else if (!strcmp(argv[i], "--trace") && i + 1 < argc) csv = argv[++i];
+        else if (!strcmp(argv[i], "--hours") && i + 1 < argc) hours = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--profile clean|cooking|wildfire] [--trace pm.csv] "
+                            "[--hours H] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Trace> traces;
+    if (csv) {
+        Trace t = { csv, {}, nullptr };
+        if (!loadCsv(csv, t)) {
+            fprintf(stderr, "%s: no \"seconds,pm25\" lines\n", csv);
+            return 1;
+        }
+        if (hours == 24) hours = t.points.back().first / 3600;
+        traces.push_back(t);
+    } else {
+        const Trace builtin[] = {
+            { "clean", {}, clean },
+            { "cooking", {}, cooking },
+            { "wildfire", {}, wildfire },
+        };
+        for (const Trace& t : builtin) {
+            if (!only || !strcmp(only, t.name)) traces.push_back(t);
+        }
+        if (traces.empty()) {
+            fprintf(stderr, "unknown profile %s\n", only);
+            return 2;
+        }
+    }
+
+    printf("laser budget %d h/day, interval %lu-%lu s\n", PMS_LASER_HOURS_PER_DAY,
+           (unsigned long)PMS_INTERVAL_MIN_MS / 1000, (unsigned long)PMS_INTERVAL_MAX_MS / 1000);
+    printf("%-10s %6s %8s %6s %6s %8s %9s %7s %7s %8s %6s %9s %7s\n", "trace", "hours", "laser/d",
+           "on%", "wakes", "samples", "on s/wake", "age min", "max min", "|err|", "alerts", "lag max s", "pass ms");
+    for (const Trace& t : traces) {
+        report(t, run(t, hours, seed));
+    }
+    return 0;
+}
@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+"""Estimate SmartClock current draw and wake latency under PowerGovernor.
+
+Simulates loop() for typical module schedules, once spinning at full clock
+as before the governor and once with it: each pass runs the work that is
+due, then the governor idles until the earliest deadline (see
+PowerGovernor.h). An energy model integrates the ESP32's supply current
+over CPU, idle, light-sleep and radio states, and random connection
+arrivals measure how much longer a new client waits for the loop to
+notice it than with the spinning loop. Both wait for the next DTIM beacon
+first, since modem sleep is the ESP32 Arduino default either way.
+
+    python3 tools/power_model.py                      # every profile
+    python3 tools/power_model.py --profile air --light-sleep
+    python3 tools/power_model.py --set cpu80=22 --set dtim=3
+
+Default currents are ESP32 datasheet typicals (modem-sleep 20-68 mA by
+clock, light sleep 0.8 mA, RX about 100 mA) and rough splits between them;
+calibrate with --set against a meter on the 3.3 V rail. The LED matrix,
+PMS fan and regulator are not included.
+"""
+
+import argparse
+import random
+
+# Supply current in mA and timing in ms; override with --set name=value
+PARAMS = {
+    "cpu240": 50.0,      # CPU running, radio off
+    "cpu80": 25.0,
+    "idle240": 30.0,     # core clock-gated in the FreeRTOS idle task
+    "idle80": 18.0,
+    "light": 0.8,        # automatic light sleep
+    "radio": 70.0,       # added while the receiver listens
+    "beacon": 3.0,       # receiver on-time per DTIM beacon in modem sleep
+    "dtim": 1,           # beacons between listens (AP DTIM period)
+    "tbtt": 102.4,       # beacon interval
+    "wake": 1.0,         # light-sleep exit
+    "overhead": 0.03,    # ms of loop work per pass at 240 MHz
+}
+
+# Governor constants, as in PowerGovernor.h
+POLL_MS = 10
+FAST_POLL_MS = 1
+MIN_IDLE_MS = 2
+MAX_IDLE_MS = 1000
+WAKE_HOLD_MS = 2000
+
+
+class Task:
+    """Work due every period ms, costing work ms at 240 MHz.
+
+    on/every limit it to a window of on ms out of every ms (a ticker that
+    scrolls for a while, a PMS sample); uart marks work fed by a serial
+    stream, which holds off light sleep while its window is open.
+    """
+
+    def __init__(self, name, period, work, on=None, every=None, uart=False):
+        self.name, self.period, self.work = name, period, work
+        self.on, self.every, self.uart = on, every, uart
+        self.due = 0.0
+
+    def running(self, t):
+        return self.on is None or t % self.every < self.on
+
+    def next_due(self, t):
+        if self.running(t):
+            return max(self.due, t)
+        start = (t // self.every + 1) * self.every
+        return max(self.due, start)
+
+
+def profiles():
+    def base():
+        return [Task("clock", 1001, 0.25), Task("bme", 2001, 0.4), Task("telemetry", 5000, 0.9)]
+    return {
+        "clock": (base(), None),
+        "pomodoro": (base() + [Task("pomodoro", 1001, 0.2)], None),
+        "ticker": (base() + [Task("text", 50, 0.12, on=20000, every=60000)], None),
+        "air": (base() + [Task("pms", 2501, 1.5, on=30000, every=300000, uart=True)], None),
+        # Dashboard open: /api/data every 2 s over a keep-alive socket
+        "dashboard": (base(), 2000),
+    }
+
+
+def simulate(tasks, poll_every, governed, light_ok, p, duration_s):
+    """Returns (mean mA, share idle, share light sleep, idle spans)."""
+    end = duration_s * 1000.0
+    t = 0.0
+    charge = 0.0          # mA*ms
+    idle_ms = light_ms = 0.0
+    fast = True
+    last_client = -WAKE_HOLD_MS
+    next_poll = 0.0 if poll_every else None
+    spans = []            # (start, stop, poll slice, light) while idle
+
+    def radio(ms):
+        # Modem sleep: the receiver wakes for one beacon per DTIM period
+        return p["radio"] * ms * p["beacon"] / (p["tbtt"] * p["dtim"])
+
+    while t < end:
+        mhz = 240 if fast or not governed else 80
+        work = p["overhead"]
+        for task in tasks:
+            if task.running(t) and task.due <= t:
+                work += task.work
+                task.due = t + task.period
+        if next_poll is not None and t >= next_poll:
+            work += 1.5
+            next_poll = t + poll_every
+            last_client = t
+        work *= 240 / mhz
+        charge += p["cpu%d" % mhz] * work + radio(work)
+        t += work
+
+        deadline = min(task.next_due(t) for task in tasks)
+        if next_poll is not None:
+            deadline = min(deadline, next_poll)
+        budget = deadline - t
+
+        if not governed or budget < MIN_IDLE_MS:
+            # Spinning: every pass is CPU work at the current clock
+            mhz = 240 if fast or not governed else 80
+            if budget > 0:
+                charge += p["cpu%d" % mhz] * budget + radio(budget)
+                t += budget
+            continue
+
+        fast = t - last_client < WAKE_HOLD_MS
+        budget = min(budget, MAX_IDLE_MS)
+        light = light_ok and not fast and not any(task.uart and task.running(t) for task in tasks)
+        if light:
+            charge += p["light"] * budget + radio(budget) + p["cpu80"] * p["wake"]
+            light_ms += budget
+        else:
+            charge += p["idle%d" % (240 if fast else 80)] * budget + radio(budget)
+        spans.append((t, t + budget, FAST_POLL_MS if fast else POLL_MS, light))
+        idle_ms += budget
+        t += budget
+
+    return charge / t, idle_ms / t, light_ms / t, spans
+
+
+def wake_latency(spans, p, duration_s, samples, seed):
+    """Extra delay, in ms, between the radio receiving a SYN and the loop
+    seeing it, against a loop that polls continuously."""
+    rng = random.Random(seed)
+    end = duration_s * 1000.0
+    latencies = []
+    for _ in range(samples):
+        at = rng.uniform(0, end)
+        # Binary search for the idle span containing the arrival
+        lo, hi = 0, len(spans)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if spans[mid][1] <= at:
+                lo = mid + 1
+            else:
+                hi = mid
+        if lo == len(spans) or spans[lo][0] > at:
+            latencies.append(0.0)   # awake and polling; at most one pass
+            continue
+        # Noticed at the end of the current poll slice
+        start, stop, slice_ms, light = spans[lo]
+        noticed = min(stop, start + slice_ms * (int((at - start) // slice_ms) + 1))
+        latencies.append(noticed - at + (p["wake"] if light else 0))
+    latencies.sort()
+    worst = POLL_MS + p["wake"]
+    return latencies[int(len(latencies) * 0.95)], latencies[-1], worst
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--profile", choices=sorted(profiles()), help="one schedule instead of all")
+    ap.add_argument("--duration", type=float, default=3600, help="simulated seconds")
+    ap.add_argument("--light-sleep", action="store_true", help="firmware built with PM and tickless idle")
+    ap.add_argument("--samples", type=int, default=20000, help="connection arrivals for latency")
+    ap.add_argument("--battery", type=float, default=2000, help="mAh, for the runtime column")
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--set", action="append", default=[], metavar="NAME=VALUE", help="override a model parameter")
+    args = ap.parse_args()
+
+    p = dict(PARAMS)
+    for item in args.set:
+        name, _, value = item.partition("=")
+        if name not in p:
+            ap.error("unknown parameter %s (have %s)" % (name, ", ".join(sorted(p))))
+        p[name] = float(value)
+
+    names = [args.profile] if args.profile else list(profiles())
+    print("%-10s %9s %9s %6s %6s %8s %9s %9s" % (
+        "profile", "spin mA", "gov mA", "idle", "light", "runtime", "+p95 ms", "+max ms"))
+    for name in names:
+        tasks, poll = profiles()[name]
+        spin, _, _, _ = simulate(tasks, poll, False, False, p, args.duration)
+        tasks, poll = profiles()[name]
+        gov, idle, light, spans = simulate(tasks, poll, True, args.light_sleep, p, args.duration)
+        p95, seen, worst = wake_latency(spans, p, args.duration, args.samples, args.seed)
+        print("%-10s %9.1f %9.1f %5.0f%% %5.0f%% %7.1fh %9.1f %9.1f" % (
+            name, spin, gov, 100 * idle, 100 * light, args.battery / gov, p95, seen))
+    print("added wake latency is at most %.1f ms (poll %d + light-sleep exit %.1f); both loops"
+          % (worst, POLL_MS, p["wake"]))
+    print("first wait up to %.1f ms for the DTIM beacon" % (p["tbtt"] * p["dtim"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""Collect SmartClock UDP multicast telemetry from any number of clocks.
+
+Joins the telemetry group, decodes each TelemetryPacket (see
+TelemetryBroadcaster.h) and keeps one row per sender with packet loss
+derived from the sequence numbers.
+
+    python3 tools/telemetry_collector.py                 # listen and print a table
+    python3 tools/telemetry_collector.py --simulate 50   # fake 50 clocks (testing)
+    python3 tools/telemetry_collector.py --bench 10      # loopback ingest benchmark
+
+Use --iface 127.0.0.1 to run sender and collector on one machine.
+"""
+
+import argparse
+import socket
+import struct
+import threading
+import time
+
+GROUP = "239.12.34.56"
+PORT = 4210
+
+MAGIC = 0x4B53
+VERSION = 1
+# magic, version, active, seq, unix, uptime, temp, hum, pressure, pm1, pm25, pm10, pmAge, flags, reserved
+PACKET = struct.Struct("<HBBIIIhHIHHHHBB")
+assert PACKET.size == 34
+
+FLAG_BME_OK = 0x01
+FLAG_PM_VALID = 0x02
+FLAG_PMS_ON = 0x04
+
+
+class Sender:
+    __slots__ = ("received", "lost", "last_seq", "last_seen", "fields")
+
+    def __init__(self):
+        self.received = 0
+        self.lost = 0
+        self.last_seq = None
+        self.last_seen = 0.0
+        self.fields = None
+
+
+class Collector:
+    def __init__(self):
+        self.senders = {}
+        self.received = 0
+        self.rejected = 0
+
+    def ingest(self, data, addr, now):
+        if len(data) != PACKET.size:
+            self.rejected += 1
+            return
+        fields = PACKET.unpack(data)
+        if fields[0] != MAGIC or fields[1] != VERSION:
+            self.rejected += 1
+            return
+
+        sender = self.senders.get(addr)
+        if sender is None:
+            sender = self.senders[addr] = Sender()
+
+        seq = fields[3]
+        if sender.last_seq is not None:
+            gap = (seq - sender.last_seq - 1) & 0xFFFFFFFF
+            if gap < 0x80000000:
+                sender.lost += gap
+        sender.last_seq = seq
+        sender.last_seen = now
+        sender.received += 1
+        sender.fields = fields
+        self.received += 1
+
+    def print_table(self):
+        print("%-22s %8s %6s %7s %6s %8s %5s %5s %5s" %
+              ("sender", "rx", "lost", "temp", "hum", "hPa", "pm1", "pm25", "pm10"))
+        for addr, s in sorted(self.senders.items()):
+            f = s.fields
+            flags = f[13]
+            if flags & FLAG_BME_OK:
+                env = "%7.2f %6.2f %8.2f" % (f[6] / 100.0, f[7] / 100.0, f[8] / 100.0)
+            else:
+                env = "%7s %6s %8s" % ("-", "-", "-")
+            if flags & FLAG_PM_VALID:
+                pm = "%5d %5d %5d" % (f[9], f[10], f[11])
+            else:
+                pm = "%5s %5s %5s" % ("-", "-", "-")
+            print("%-22s %8d %6d %s %s" % ("%s:%d" % addr, s.received, s.lost, env, pm))
+        print()
+
+
+def open_receiver(group, port, iface):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 * 1024 * 1024)
+    sock.bind(("", port))
+    mreq = socket.inet_aton(group) + socket.inet_aton(iface)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, mreq)
+    return sock
+
+
+def open_sender(iface):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 1)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_IF, socket.inet_aton(iface))
+    return sock
+
+
+def simulate(count, group, port, iface, rate, stop, sent):
+    """Emulate `count` clocks, each on its own socket (so its own source port)."""
+    socks = [open_sender(iface) for _ in range(count)]
+    seqs = [0] * count
+    start = time.monotonic()
+    period = 1.0 / rate if rate else 0
+    while not stop.is_set():
+        uptime = int((time.monotonic() - start) * 1000)
+        for i, sock in enumerate(socks):
+            pkt = PACKET.pack(MAGIC, VERSION, i % 5, seqs[i], int(time.time()), uptime,
+                              2150 + i, 4500, 101325, 5, 12 + i % 20, 18,
+                              30, FLAG_BME_OK | FLAG_PM_VALID, 0)
+            seqs[i] += 1
+            sock.sendto(pkt, (group, port))
+        sent[0] += count
+        if period:
+            time.sleep(period)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--group", default=GROUP)
+    ap.add_argument("--port", type=int, default=PORT)
+    ap.add_argument("--iface", default="0.0.0.0", help="local interface address to join on")
+    ap.add_argument("--simulate", type=int, metavar="N", help="only send fake packets from N clocks")
+    ap.add_argument("--rate", type=float, default=1.0, help="packets/s per simulated clock (0 = flat out)")
+    ap.add_argument("--bench", type=float, metavar="SECONDS",
+                    help="run simulated senders and the collector together, report ingest rate")
+    ap.add_argument("--clocks", type=int, default=8, help="simulated clocks for --bench")
+    ap.add_argument("--interval", type=float, default=5.0, help="table print interval")
+    args = ap.parse_args()
+
+    if args.simulate:
+        sent = [0]
+        try:
+            simulate(args.simulate, args.group, args.port, args.iface, args.rate, threading.Event(), sent)
+        except KeyboardInterrupt:
+            pass
+        return
+
+    sock = open_receiver(args.group, args.port, args.iface)
+    collector = Collector()
+
+    if args.bench:
+        iface = args.iface if args.iface != "0.0.0.0" else "127.0.0.1"
+        stop = threading.Event()
+        sent = [0]
+        thread = threading.Thread(target=simulate,
+                                  args=(args.clocks, args.group, args.port, iface, 0, stop, sent),
+                                  daemon=True)
+        sock.settimeout(0.5)
+        start = time.monotonic()
+        thread.start()
+        deadline = start + args.bench
+        while time.monotonic() < deadline:
+            try:
+                data, addr = sock.recvfrom(64)
+            except socket.timeout:
+                continue
+            collector.ingest(data, addr, time.monotonic())
+        elapsed = time.monotonic() - start
+        stop.set()
+        thread.join()
+
+        lost = sum(s.lost for s in collector.senders.values())
+        print("senders      %d" % len(collector.senders))
+        print("sent         %d" % sent[0])
+        print("ingested     %d (%.0f datagrams/s)" % (collector.received, collector.received / elapsed))
+        print("seq gaps     %d" % lost)
+        print("rejected     %d" % collector.rejected)
+        return
+
+    next_print = time.monotonic() + args.interval
+    sock.settimeout(0.5)
+    try:
+        while True:
+            try:
+                data, addr = sock.recvfrom(64)
+                collector.ingest(data, addr, time.monotonic())
+            except socket.timeout:
+                pass
+            if time.monotonic() >= next_print:
+                collector.print_table()
+                next_print += args.interval
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
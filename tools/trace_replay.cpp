@@ -0,0 +1,358 @@
+// Decodes and replays a SmartClock field trace (see TraceRecorder.h) on the
+// host, through the sketch's own code.
+//
+// Capture on the device with /api/trace/start, reproduce the problem, then
+// download /api/trace.bin. PMS UART bytes go through PmsFrameParser, the
+// frame search PmsSensor runs, so desyncs and checksum failures show up
+// exactly as the device saw them. --replay boots SmartClock.ino against
+// the fake clock and plays the trace into it in recorded time: UART bytes
+// into the PMS port, BME280 readings into the stub sensor, and requests
+// into the real router.
+//
+//     make -C host tools
+//     host/build/trace_replay trace.bin               # summary
+//     host/build/trace_replay trace.bin --events      # every record
+//     host/build/trace_replay trace.bin --pms         # decoded PMS frames
+//     host/build/trace_replay trace.bin --replay      # through the sketch
+//     host/build/trace_replay --simulate test.bin     # write a synthetic trace
+
+#include "PmsSensor.h"
+#include "TraceRecorder.h"
+#include <Adafruit_BME280.h>
+#include "sketch.h"
+#include "host.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+static const uint8_t PMS_UART = 2;      // the traced PMS in SmartClock.ino
+static const size_t TRACE_HEADER_SIZE = 12;
+
+struct Record {
+    uint32_t ms;                        // since the trace started
+    uint8_t type;
+    std::string payload;
+};
+
+static const char* typeName(uint8_t type) {
+    switch (type) {
+        case TRACE_PMS_RX:       return "pms";
+        case TRACE_BME_READ:     return "bme";
+        case TRACE_HTTP_REQUEST: return "http";
+        case TRACE_HTTP_TIME:    return "time";
+        case TRACE_MARK:         return "mark";
+        default:                 return "?";
+    }
+}
+
+static bool readVarint(const std::string& data, size_t& pos, uint32_t& value) {
+    value = 0;
+    for (uint8_t shift = 0; pos < data.size() && shift < 35; shift += 7) {
+        uint8_t b = data[pos++];
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if (b < 0x80) return true;
+    }
+    return false;
+}
+
+static bool readTrace(const char* path, uint32_t& start, std::vector<Record>& records) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+    std::string data;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) data.append(chunk, n);
+    fclose(f);
+
+    if (data.size() < TRACE_HEADER_SIZE || data.compare(0, 4, TRACE_MAGIC) != 0 ||
+        (uint8_t)data[4] != TRACE_VERSION || data[5] != 0) {
+        fprintf(stderr, "%s: not a version %d SmartClock trace\n", path, TRACE_VERSION);
+        return false;
+    }
+    memcpy(&start, data.data() + 8, 4);
+
+    uint32_t ms = 0;
+    for (size_t pos = TRACE_HEADER_SIZE; pos < data.size(); ) {
+        Record r;
+        r.type = data[pos++];
+        uint32_t delta, length;
+        if (!readVarint(data, pos, delta) || !readVarint(data, pos, length) ||
+            pos + length > data.size()) {
+            fprintf(stderr, "%s: truncated record at offset %u\n", path, (unsigned)pos);
+            return false;
+        }
+        ms += delta;
+        r.ms = ms;
+        r.payload = data.substr(pos, length);
+        records.push_back(r);
+        pos += length;
+    }
+    return true;
+}
+
+static std::string requestLine(const Record& r) {
+    return std::string(r.payload.c_str());
+}
+
+static std::string requestBody(const Record& r) {
+    size_t nul = r.payload.find('\0');
+    return nul == std::string::npos ? "" : r.payload.substr(nul + 1);
+}
+
+static std::string requestPath(const std::string& line) {
+    size_t start = line.find(' ');
+    if (start == std::string::npos) return line;
+    size_t end = line.find_first_of(" ?", start + 1);
+    return line.substr(start + 1, end == std::string::npos ? std::string::npos : end - start - 1);
+}
+
+static uint32_t u32(const Record& r) {
+    uint32_t v = 0;
+    if (r.payload.size() == 4) memcpy(&v, r.payload.data(), 4);
+    return v;
+}
+
+static void bme(const Record& r, float values[3]) {
+    memset(values, 0, 3 * sizeof(float));
+    if (r.payload.size() == 12) memcpy(values, r.payload.data(), 12);
+}
+
+// Feeds one PMS_RX record; prints what it produced when verbose
+static void feedPms(PmsFrameParser& parser, const Record& r, bool verbose) {
+    uint32_t failures = parser.checksumFailures;
+    uint32_t skipped = parser.skipped;
+    for (char c : r.payload) {
+        if (parser.receive((uint8_t)c) && verbose) {
+            printf("%10.3f  PM1.0=%-4u PM2.5=%-4u PM10=%-4u\n", r.ms / 1000.0,
+                   parser.pm1_0, parser.pm2_5, parser.pm10);
+        }
+    }
+    if (!verbose) return;
+    if (parser.checksumFailures > failures) printf("%10.3f  checksum failure\n", r.ms / 1000.0);
+    if (parser.skipped > skipped) {
+        printf("%10.3f  skipped %u bytes\n", r.ms / 1000.0, (unsigned)(parser.skipped - skipped));
+    }
+}
+
+static void summary(uint32_t start, const std::vector<Record>& records) {
+    std::map<uint8_t, std::pair<uint32_t, uint32_t>> counts;     // records, bytes
+    for (const Record& r : records) {
+        counts[r.type].first++;
+        counts[r.type].second += r.payload.size();
+    }
+    printf("trace from millis %u, %.1f s, %u records\n", (unsigned)start,
+           records.empty() ? 0 : records.back().ms / 1000.0, (unsigned)records.size());
+    for (auto& c : counts) {
+        printf("  %-5s %6u records %8u bytes\n", typeName(c.first), (unsigned)c.second.first,
+               (unsigned)c.second.second);
+    }
+
+    PmsFrameParser parser;
+    for (const Record& r : records) {
+        if (r.type == TRACE_PMS_RX) feedPms(parser, r, false);
+    }
+    if (counts.count(TRACE_PMS_RX)) {
+        printf("PMS: %u frames, %u checksum failures, %u bytes skipped resyncing\n",
+               (unsigned)parser.frames, (unsigned)parser.checksumFailures, (unsigned)parser.skipped);
+    }
+
+    const char* names[3] = { "temp C", "hum %", "press hPa" };
+    for (int i = 0; i < 3; i++) {
+        float lo = INFINITY, hi = -INFINITY;
+        double sum = 0;
+        uint32_t n = 0;
+        for (const Record& r : records) {
+            if (r.type != TRACE_BME_READ) continue;
+            float values[3];
+            bme(r, values);
+            lo = std::min(lo, values[i]);
+            hi = std::max(hi, values[i]);
+            sum += values[i];
+            n++;
+        }
+        if (n) printf("BME %-9s min %8.2f  mean %8.2f  max %8.2f\n", names[i], lo, sum / n, hi);
+    }
+
+    std::vector<uint32_t> times;
+    std::map<std::string, uint32_t> slowest;
+    std::string path;
+    for (const Record& r : records) {
+        if (r.type == TRACE_HTTP_REQUEST) path = requestPath(requestLine(r));
+        if (r.type != TRACE_HTTP_TIME) continue;
+        times.push_back(u32(r));
+        slowest[path] = std::max(slowest[path], u32(r));
+    }
+    if (times.empty()) return;
+    std::sort(times.begin(), times.end());
+    printf("HTTP handler us: p50 %u  p95 %u  max %u over %u requests\n", (unsigned)times[times.size() / 2],
+           (unsigned)times[times.size() * 95 / 100], (unsigned)times.back(), (unsigned)times.size());
+    std::vector<std::pair<uint32_t, std::string>> ranked;
+    for (auto& s : slowest) ranked.push_back({ s.second, s.first });
+    std::sort(ranked.rbegin(), ranked.rend());
+    for (size_t i = 0; i < ranked.size() && i < 5; i++) {
+        printf("  %8u us  %s\n", (unsigned)ranked[i].first, ranked[i].second.c_str());
+    }
+}
+
+static void events(const std::vector<Record>& records) {
+    for (const Record& r : records) {
+        printf("%10.3f  %-4s ", r.ms / 1000.0, typeName(r.type));
+        if (r.type == TRACE_HTTP_REQUEST) {
+            std::string body = requestBody(r);
+            printf("%s", requestLine(r).c_str());
+            if (!body.empty()) printf(" [%u body bytes]", (unsigned)body.size());
+        } else if (r.type == TRACE_HTTP_TIME) {
+            printf("%u us", (unsigned)u32(r));
+        } else if (r.type == TRACE_BME_READ) {
+            float values[3];
+            bme(r, values);
+            printf("%.2f C  %.2f %%  %.2f hPa", values[0], values[1], values[2]);
+        } else if (r.type == TRACE_MARK) {
+            printf("%s", r.payload.c_str());
+        } else {
+            for (size_t i = 0; i < r.payload.size(); i++) printf(i ? " %02x" : "%02x", (uint8_t)r.payload[i]);
+        }
+        printf("\n");
+    }
+}
+
+static void pmsFrames(const std::vector<Record>& records) {
+    PmsFrameParser parser;
+    for (const Record& r : records) {
+        if (r.type == TRACE_PMS_RX) feedPms(parser, r, true);
+    }
+}
+
+// Boots the sketch and plays the trace into it at the recorded times;
+// reports every request it did not answer with 2xx
+static void replay(const std::vector<Record>& records) {
+    setup();
+    uint64_t base = host::nowMicros() / 1000;
+    std::map<int, uint32_t> statuses;
+    for (const Record& r : records) {
+        uint64_t due = base + r.ms;
+        while (host::nowMicros() / 1000 < due) {
+            loop();
+            uint64_t now = host::nowMicros() / 1000;
+            if (now < due) host::advance(std::min<uint64_t>(due - now, 10));
+        }
+
+        if (r.type == TRACE_PMS_RX) {
+            host::feedUart(PMS_UART, (const uint8_t*)r.payload.data(), r.payload.size());
+        } else if (r.type == TRACE_BME_READ) {
+            float values[3];
+            bme(r, values);
+            hostBme.temperature = values[0];
+            hostBme.humidity = values[1];
+            hostBme.pressure = values[2] * 100;
+        } else if (r.type == TRACE_HTTP_REQUEST) {
+            std::string body = requestBody(r);
+            std::string raw = requestLine(r) + "\r\nConnection: close\r\n";
+            if (!body.empty()) raw += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+            raw += "\r\n" + body;
+            int status = httpStatus(sketchRequest(raw));
+            statuses[status]++;
+            if (status < 200 || status > 299) {
+                printf("%10.3f  %d %s\n", r.ms / 1000.0, status, requestLine(r).c_str());
+            }
+        } else if (r.type == TRACE_MARK) {
+            printf("%10.3f  mark %s\n", r.ms / 1000.0, r.payload.c_str());
+        }
+    }
+    loop();
+
+    printf("replayed %.1f s:", records.empty() ? 0 : records.back().ms / 1000.0);
+    for (auto& s : statuses) printf(" %u x %d", (unsigned)s.second, s.first);
+    printf("\n");
+    host::Capture json;
+    JsonWriter writer(json);
+    moduleManager.writeData(writer);
+    printf("%s\n", json.text.c_str());
+}
+
+// A minute of clean and corrupted PMS frames, BME280 reads and requests,
+// written by the device's own TraceRecorder
+static bool simulate(const char* path) {
+    host::setMillis(123456);
+    TraceRecorder& trace = TraceRecorder::instance();
+    if (!trace.start()) return false;
+    for (int i = 0; i < 60; i++) {
+        uint16_t pm1 = 5 + i % 3, pm25 = 10 + i % 7, pm10 = 15 + i % 5;
+        uint8_t frame[PMS_FRAME_LEN] = { 0x42, 0x4D, 0, 28 };
+        for (int j = 0; j < 6; j++) {
+            uint16_t v = j % 3 == 0 ? pm1 : j % 3 == 1 ? pm25 : pm10;
+            frame[4 + 2 * j] = v >> 8;
+            frame[5 + 2 * j] = v & 0xFF;
+        }
+        uint16_t sum = 0;
+        for (int j = 0; j < PMS_FRAME_LEN - 2; j++) sum += frame[j];
+        frame[PMS_FRAME_LEN - 2] = sum >> 8;
+        frame[PMS_FRAME_LEN - 1] = sum & 0xFF;
+        if (i % 20 == 7) frame[20] ^= 0xFF;                   // checksum failure
+        if (i % 25 == 3) {
+            const uint8_t noise[] = { 0x00, 0x13 };           // line noise
+            trace.recordSerial(noise, sizeof(noise));
+        }
+        trace.recordSerial(frame, sizeof(frame));
+        trace.flushPending();
+
+        host::advance(5);
+        float reading[3] = { 21.5f + i / 100.0f, 45.0f, 1013.2f - i / 50.0f };
+        trace.record(TRACE_BME_READ, reading, sizeof(reading));
+        if (i % 5 == 0) {
+            host::advance(5);
+            trace.recordRequest("GET /api/data HTTP/1.1", "", 0);
+            host::advance(2);
+            trace.recordTime(TRACE_HTTP_TIME, 900 + i * 7);
+        }
+        host::setMillis(123456 + (i + 1) * 1000);
+    }
+    const char mark[] = "end of simulated trace";
+    trace.record(TRACE_MARK, mark, strlen(mark));
+    trace.stop();
+
+    FILE* f = fopen(path, "wb");
+    if (!f || fwrite(trace.getData(), 1, trace.getSize(), f) != trace.getSize()) {
+        fprintf(stderr, "%s: cannot write\n", path);
+        if (f) fclose(f);
+        return false;
+    }
+    fclose(f);
+    printf("wrote %s (%u bytes)\n", path, (unsigned)trace.getSize());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    const char* mode = "";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--simulate") && i + 1 < argc) return simulate(argv[++i]) ? 0 : 1;
+        if (!strcmp(argv[i], "--events") || !strcmp(argv[i], "--pms") || !strcmp(argv[i], "--replay")) {
+            mode = argv[i];
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s trace.bin [--events|--pms|--replay]\n"
+                        "       %s --simulate out.bin\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    uint32_t start;
+    std::vector<Record> records;
+    if (!readTrace(path, start, records)) return 1;
+
+    if (!strcmp(mode, "--events")) events(records);
+    else if (!strcmp(mode, "--pms")) pmsFrames(records);
+    else if (!strcmp(mode, "--replay")) replay(records);
+    else summary(start, records);
+    return 0;
+}
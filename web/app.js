@@ -0,0 +1,139 @@
+function $(id){return document.getElementById(id)}
+function pad(n){return String(n).padStart(2,'0')}
+
+function sendRequest(u){
+  fetch(u).then(function(r){if(!r.ok)console.error(u)}).catch(function(e){console.error(e)});
+}
+
+// Several commands in one round trip, applied in order; the reply is the new state
+function batch(cmds){
+  fetch('/api/batch',{method:'POST',body:cmds.join('\n')}).then(function(r){
+    if(!r.ok)console.error(cmds);
+    return r.json();
+  }).then(function(d){if(d.active)render(d)}).catch(function(e){console.error(e)});
+}
+
+function sw(m){
+  sendRequest('/module/'+m);
+}
+
+function tab(el,i){
+  var ts=document.querySelectorAll('.tab');
+  var ps=document.querySelectorAll('.pane');
+  for(var j=0;j<ts.length;j++){ts[j].classList.remove('on');ps[j].classList.remove('on')}
+  el.classList.add('on');ps[i].classList.add('on');
+}
+
+function aqiInfo(v){
+  if(v<=12)return['Good','#3fb950',0];
+  if(v<=35)return['Moderate','#d29922',25];
+  if(v<=55)return['Sensitive','#f0883e',45];
+  if(v<=150)return['Unhealthy','#f85149',60];
+  if(v<=250)return['V.Unhealthy','#bc8cff',80];
+  return['Hazardous','#880e4f',95];
+}
+
+function render(d){
+  $('pip').classList.add('on');
+  // One module per display zone; older firmware only reports "active"
+  var shown=d.zones||[d.active];
+  $('stxt').textContent=shown.join(' | ')||'--';
+
+  var btns=document.querySelectorAll('.mbtn');
+  for(var i=0;i<btns.length;i++){
+    btns[i].classList.toggle('on',shown.indexOf(btns[i].textContent.trim())>=0);
+  }
+
+  if(d.Clock){
+    $('c-t').textContent=d.Clock.time||'--:--';
+    $('c-d').textContent=d.Clock.date||'---';
+  }
+
+  if(d.Weather){
+    if(d.Weather.ok){
+      $('w-t').textContent=d.Weather.t.toFixed(1)+'\u00B0'+d.Weather.u;
+      $('w-h').textContent=d.Weather.h.toFixed(0);
+      $('w-p').textContent=d.Weather.p.toFixed(0);
+      $('w-f').textContent=d.Weather.z?(d.Weather.dp>=0?'+':'')+d.Weather.dp.toFixed(1)+' hPa/3h \u00B7 '+d.Weather.fc:'';
+    }else{$('w-t').textContent='N/A';}
+  }
+
+  if(d.AirQuality){
+    var a=d.AirQuality;
+    if(!a.on&&a.age>=0){
+      var q=aqiInfo(a.pm25);
+      $('a-v').textContent=q[0];$('a-v').style.color=q[1];
+      $('a-25').textContent=a.pm25;$('a-10').textContent=a.pm10;
+      $('a-st').textContent=a.laser?'Sampling...':'Sampled '+a.age+'s ago, next in '+a.next+'s';
+      $('a-pip').style.marginLeft=q[2]+'%';
+    }else if(!a.on){
+      $('a-v').textContent='Sleep';$('a-v').style.color='var(--t3)';
+      $('a-st').textContent='Sleeping to extend lifespan';
+    }else if(!a.warm){
+      $('a-v').textContent='Warmup';$('a-v').style.color='var(--org)';
+      $('a-st').textContent=a.sec+'s remaining';
+      if(a.pm25>0){$('a-25').textContent=a.pm25;$('a-10').textContent=a.pm10;}
+    }else{
+      var q=aqiInfo(a.pm25);
+      $('a-v').textContent=q[0];$('a-v').style.color=q[1];
+      $('a-25').textContent=a.pm25;$('a-10').textContent=a.pm10;
+      $('a-st').textContent='PM1.0: '+a.pm1;
+      $('a-pip').style.marginLeft=q[2]+'%';
+    }
+  }
+
+  if(d.Pomodoro){
+    var p=d.Pomodoro;
+    $('pw').value=p.wm;$('pwv').textContent=p.wm;
+    $('pb').value=p.bm;$('pbv').textContent=p.bm;
+    if(p.run){
+      $('p-t').textContent=pad(p.min)+':'+pad(p.sec);
+      $('p-s').textContent=p.work?'Working':'Break';
+      $('p-s').style.color=p.work?'var(--org)':'var(--grn)';
+    }else{
+      $('p-t').textContent='--:--';
+      $('p-s').textContent='Stopped';$('p-s').style.color='';
+    }
+  }
+}
+
+function offline(){$('pip').classList.remove('on');$('stxt').textContent='Offline'}
+
+// Device events after the last one seen: alerts, timers, samples, module
+// switches. Each arrives once however far apart the polls are.
+var evSeq=0,evList=[];
+var SRC=['','BME280','PMS','Pomodoro','Timer'];
+
+function evText(e){
+  var s=SRC[e.src]||'';
+  if(e.topic==='sample')return s+' '+(e.name||'')+': '+(e.src===2?e.v[1]+' \u00b5g/m\u00b3':e.v[0]+' \u00b0C');
+  return e.topic.replace('_',' ')+': '+(e.name||s);
+}
+
+function events(){
+  return fetch('/api/events?since='+evSeq).then(function(r){return r.json()}).then(function(d){
+    // Names can be user text (timer labels), so never as HTML
+    var fresh=d.events.length>0;
+    for(var i=0;i<d.events.length;i++){
+      evList.unshift(new Date().toLocaleTimeString()+' '+evText(d.events[i]));
+    }
+    // The first poll only wants what is kept
+    var lost=evSeq?d.lost:0;
+    if(lost)evList.unshift(lost+' events missed');
+    evList=evList.slice(0,6);
+    if(fresh||lost){
+      var box=$('ev');box.textContent='';
+      for(var j=0;j<evList.length;j++){
+        var row=document.createElement('div');row.textContent=evList[j];box.appendChild(row);
+      }
+    }
+    evSeq=d.seq;
+  });
+}
+
+function refresh(){
+  fetch('/api/data').then(function(r){return r.json()}).then(render).then(events).catch(offline);
+}
+
+setInterval(refresh,2000);
+refresh();